@@ -8,6 +8,8 @@
 #include "Benchmark.h"
 #include "SkBlurMask.h"
 #include "SkCanvas.h"
+#include "SkExecutor.h"
+#include "SkMaskBlurFilter.h"
 #include "SkPaint.h"
 #include "SkRandom.h"
 #include "SkShader.h"
@@ -182,6 +184,58 @@ private:
     typedef BlurRectSeparableBench INHERITED;
 };
 
+// Blurs a large A8 rect with SkMaskBlurFilter directly. With threads > 0 the filter is given a
+// pool of that many threads, and blurs the mask in bands on it.
+class BlurRectMaskBlurFilterBench: public Benchmark {
+public:
+    BlurRectMaskBlurFilterBench(SkScalar rad, int threads) : fRadius(rad), fThreads(threads) {
+        fName.printf("blurrect_maskblurfilter_%d", SkScalarRoundToInt(rad));
+        if (threads > 0) {
+            fName.appendf("_threads%d", threads);
+        }
+        fSrcMask.fImage = nullptr;
+    }
+
+    ~BlurRectMaskBlurFilterBench() override {
+        SkMask::FreeImage(fSrcMask.fImage);
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fSrcMask.fBounds = SkIRect::MakeWH(1024, 1024);
+        fSrcMask.fFormat = SkMask::kA8_Format;
+        fSrcMask.fRowBytes = fSrcMask.fBounds.width();
+        fSrcMask.fImage = SkMask::AllocImage(fSrcMask.computeTotalImageSize());
+        memset(fSrcMask.fImage, 0xff, fSrcMask.computeTotalImageSize());
+
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        double sigma = SkBlurMask::ConvertRadiusToSigma(fRadius);
+        SkMaskBlurFilter filter(sigma, sigma, fExecutor.get());
+        for (int i = 0; i < loops; i++) {
+            SkMask mask;
+            filter.blur(fSrcMask, &mask);
+            SkMask::FreeImage(mask.fImage);
+        }
+    }
+
+private:
+    SkScalar                    fRadius;
+    int                         fThreads;
+    SkString                    fName;
+    SkMask                      fSrcMask;
+    std::unique_ptr<SkExecutor> fExecutor;
+    typedef Benchmark INHERITED;
+};
+
 DEF_BENCH(return new BlurRectBoxFilterBench(SMALL);)
 DEF_BENCH(return new BlurRectBoxFilterBench(BIG);)
 DEF_BENCH(return new BlurRectBoxFilterBench(REALBIG);)
@@ -228,3 +282,8 @@ DEF_BENCH(return new BlurRectGaussianBench(SkIntToScalar(18));)
 DEF_BENCH(return new BlurRectGaussianBench(SkIntToScalar(19));)
 DEF_BENCH(return new BlurRectGaussianBench(SkIntToScalar(20));)
 #endif
+
+DEF_BENCH(return new BlurRectMaskBlurFilterBench(BIG,     0);)
+DEF_BENCH(return new BlurRectMaskBlurFilterBench(BIG,     4);)
+DEF_BENCH(return new BlurRectMaskBlurFilterBench(REALBIG, 0);)
+DEF_BENCH(return new BlurRectMaskBlurFilterBench(REALBIG, 4);)
@@ -22,9 +22,13 @@
 // performance in this case.
 class BlurRoundRectBench : public Benchmark {
 public:
-    BlurRoundRectBench(int width, int height, int cornerRadius)
-        : fName("blurroundrect") {
+    BlurRoundRectBench(int width, int height, int cornerRadius, SkScalar blurRadius = 0.5f)
+        : fName("blurroundrect")
+        , fBlurRadius(blurRadius) {
         fName.appendf("_WH_%ix%i_cr_%i", width, height, cornerRadius);
+        if (blurRadius != 0.5f) {
+            fName.appendf("_blur_%g", SkScalarToFloat(blurRadius));
+        }
         SkRect r = SkRect::MakeWH(SkIntToScalar(width), SkIntToScalar(height));
         fRRect.setRectXY(r, SkIntToScalar(cornerRadius), SkIntToScalar(cornerRadius));
     }
@@ -49,7 +53,7 @@ public:
             info.fPostTranslate = false;
             SkPaint* paint = looperBuilder.addLayerOnTop(info);
             paint->setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle,
-                                                        SkBlurMask::ConvertRadiusToSigma(0.5)));
+                                                        SkBlurMask::ConvertRadiusToSigma(fBlurRadius)));
             paint->setColorFilter(SkColorFilter::MakeModeFilter(SK_ColorLTGRAY,
                                                                 SkBlendMode::kSrcIn));
             paint->setColor(SK_ColorGRAY);
@@ -75,6 +79,7 @@ public:
 private:
     SkString    fName;
     SkRRect     fRRect;
+    SkScalar    fBlurRadius;
 
     typedef     Benchmark INHERITED;
 };
@@ -86,3 +91,5 @@ DEF_BENCH(return new BlurRoundRectBench(100, 100, 6);)
 // Other radii options
 DEF_BENCH(return new BlurRoundRectBench(100, 100, 30);)
 DEF_BENCH(return new BlurRoundRectBench(100, 100, 90);)
+// A large blur of the large rectangle
+DEF_BENCH(return new BlurRoundRectBench(600, 5514, 6, 40);)
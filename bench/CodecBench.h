@@ -11,6 +11,7 @@
 #include "Benchmark.h"
 #include "SkAutoMalloc.h"
 #include "SkData.h"
+#include "SkExecutor.h"
 #include "SkImageInfo.h"
 #include "SkRefCnt.h"
 #include "SkString.h"
@@ -21,7 +22,9 @@
 class CodecBench : public Benchmark {
 public:
     // Calls encoded->ref()
-    CodecBench(SkString basename, SkData* encoded, SkColorType colorType, SkAlphaType alphaType);
+    // If threads > 0, decodes with SkCodec::Options::fExecutor set to a pool of that many threads.
+    CodecBench(SkString basename, SkData* encoded, SkColorType colorType, SkAlphaType alphaType,
+               int threads = 0);
 
 protected:
     const char* onGetName() override;
@@ -33,6 +36,8 @@ private:
     SkString                fName;
     const SkColorType       fColorType;
     const SkAlphaType       fAlphaType;
+    const int               fThreads;
+    std::unique_ptr<SkExecutor> fExecutor;  // Set in onDelayedSetup if fThreads > 0.
     sk_sp<SkData>           fData;
     SkImageInfo             fInfo;          // Set in onDelayedSetup.
     SkAutoMalloc            fPixelStorage;
@@ -8,6 +8,8 @@
 #include "Benchmark.h"
 #include "Resources.h"
 #include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkExecutor.h"
 #include "SkJpegEncoder.h"
 #include "SkPngEncoder.h"
 #include "SkWebpEncoder.h"
@@ -117,3 +119,61 @@ DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 3), "PNG_3n"));
 DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 1), "PNG_1n"));
 
 #undef PNG
+
+// Encodes mandrill, scaled up to size x size, to PNG.  threads == 0 encodes serially through
+// libpng; otherwise rows are filtered and deflated in bands on a pool of that many threads.
+class PngParallelEncodeBench : public Benchmark {
+public:
+    PngParallelEncodeBench(int size, int threads)
+        : fSize(size)
+        , fThreads(threads)
+        , fName(SkStringPrintf("Encode_PNG_%d_", size)) {
+        if (threads > 0) {
+            fName.appendf("threads%d", threads);
+        } else {
+            fName.append("serial");
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkBitmap src;
+        SkAssertResult(GetResourceAsBitmap(srcs[0], &src));
+        fBitmap.allocN32Pixels(fSize, fSize);
+        SkCanvas canvas(fBitmap);
+        canvas.drawBitmapRect(src, SkRect::MakeIWH(fSize, fSize), nullptr);
+
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkPngEncoder::Options opts;
+        opts.fExecutor = fExecutor.get();
+        while (loops-- > 0) {
+            SkNullWStream dst;
+            SkAssertResult(SkPngEncoder::Encode(&dst, fBitmap.pixmap(), opts));
+            SkASSERT(dst.bytesWritten() > 0);
+        }
+    }
+
+private:
+    const int                   fSize;
+    const int                   fThreads;
+    SkString                    fName;
+    SkBitmap                    fBitmap;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH(return new PngParallelEncodeBench(1024,  0));
+DEF_BENCH(return new PngParallelEncodeBench(1024,  1));
+DEF_BENCH(return new PngParallelEncodeBench(1024,  4));
+DEF_BENCH(return new PngParallelEncodeBench(1024, 16));
+DEF_BENCH(return new PngParallelEncodeBench(4096,  0));
+DEF_BENCH(return new PngParallelEncodeBench(4096,  1));
+DEF_BENCH(return new PngParallelEncodeBench(4096,  4));
+DEF_BENCH(return new PngParallelEncodeBench(4096, 16));
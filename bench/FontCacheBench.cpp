@@ -8,8 +8,10 @@
 #include "Benchmark.h"
 #include "SkCanvas.h"
 #include "SkChecksum.h"
+#include "SkExecutor.h"
 #include "SkPaint.h"
 #include "SkString.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 
 #include "gUniqueGlyphIDs.h"
@@ -52,6 +54,49 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// The same work as FontCacheBench, done by several threads at once, each with its own paint.
+// Every measureText() looks up a strike, so this shows how strike lookups scale with threads.
+class FontCacheThreadedBench : public Benchmark {
+public:
+    explicit FontCacheThreadedBench(int threads) : fThreads(threads) {
+        fName.printf("fontcache_threaded_%d", threads);
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkTaskGroup tg(*fExecutor);
+        tg.batch(fThreads, [this, loops](int) {
+            SkPaint paint;
+            this->setupPaint(&paint);
+            paint.setTextEncoding(SkPaint::kGlyphID_TextEncoding);
+
+            const uint16_t* array = gUniqueGlyphIDs;
+            while (*array != gUniqueGlyphIDs_Sentinel) {
+                int count = count_glyphs(array);
+                for (int i = 0; i < loops; ++i) {
+                    paint.measureText(array, count * sizeof(uint16_t));
+                }
+                array += count + 1;    // skip the sentinel
+            }
+        });
+        tg.wait();
+    }
+
+private:
+    int                         fThreads;
+    SkString                    fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+
+    typedef Benchmark INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 static uint32_t rotr(uint32_t value, unsigned bits) {
@@ -143,6 +188,9 @@ private:
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new FontCacheBench(); )
+DEF_BENCH( return new FontCacheThreadedBench(1); )
+DEF_BENCH( return new FontCacheThreadedBench(4); )
+DEF_BENCH( return new FontCacheThreadedBench(8); )
 
 // undefine this to run the efficiency test
 //DEF_BENCH( return new FontCacheEfficiency(); )
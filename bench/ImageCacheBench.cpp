@@ -6,7 +6,10 @@
  */
 
 #include "Benchmark.h"
+#include "SkExecutor.h"
 #include "SkResourceCache.h"
+#include "SkString.h"
+#include "SkTaskGroup.h"
 
 namespace {
 static void* gGlobalAddress;
@@ -72,6 +75,56 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Many threads hitting the global cache at once, mostly finding recs with the occasional add,
+// like rasterizer threads looking up decoded images and mips.
+class ImageCacheContentionBench : public Benchmark {
+    enum {
+        CACHE_COUNT = 500,
+        ADD_EVERY   = 64,
+    };
+public:
+    explicit ImageCacheContentionBench(int threads) : fThreads(threads) {
+        fName.printf("imagecache_contention_%dthreads", threads);
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        for (int i = 0; i < CACHE_COUNT; ++i) {
+            SkResourceCache::Add(new TestRec(TestKey(i), i));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkTaskGroup tg(*fExecutor);
+        tg.batch(fThreads, [loops](int thread) {
+            for (int i = 0; i < loops; ++i) {
+                int value = (thread * 7919 + i) % CACHE_COUNT;
+                TestKey key(value);
+                if (i % ADD_EVERY == 0) {
+                    SkResourceCache::Add(new TestRec(key, value));
+                } else {
+                    SkResourceCache::Find(key, TestRec::Visitor, nullptr);
+                }
+            }
+        });
+        tg.wait();
+    }
+
+private:
+    int                         fThreads;
+    SkString                    fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+
+    typedef Benchmark INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new ImageCacheBench(); )
+DEF_BENCH( return new ImageCacheContentionBench(1); )
+DEF_BENCH( return new ImageCacheContentionBench(4); )
+DEF_BENCH( return new ImageCacheContentionBench(8); )
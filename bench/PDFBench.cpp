@@ -9,7 +9,11 @@
 
 #include "Resources.h"
 #include "SkAutoPixmapStorage.h"
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkColorPriv.h"
 #include "SkData.h"
+#include "SkExecutor.h"
 #include "SkFloatToDecimal.h"
 #include "SkGradientShader.h"
 #include "SkImage.h"
@@ -17,6 +21,7 @@
 #include "SkRandom.h"
 #include "SkStream.h"
 #include "SkTo.h"
+#include "SkTypeface.h"
 
 namespace {
 struct WStreamWriteTextBenchmark : public Benchmark {
@@ -74,6 +79,7 @@ DEF_BENCH(return new PDFScalarBench("PDFScalar_random", next_any);)
 #ifdef SK_SUPPORT_PDF
 
 #include "SkPDFBitmap.h"
+#include "SkPDFDocument.h"
 #include "SkPDFDocumentPriv.h"
 #include "SkPDFShader.h"
 #include "SkPDFUtils.h"
@@ -258,6 +264,107 @@ struct WritePDFTextBenchmark : public Benchmark {
     }
 };
 
+/** Writes a whole multi-page document with distinct images on every page, optionally letting
+    an executor encode images, compress streams and subset fonts, and optionally writing each
+    page as soon as it ends. */
+struct PDFDocumentBench : public Benchmark {
+    PDFDocumentBench(int threads, bool streamPages = false)
+            : fThreads(threads), fStreamPages(streamPages) {
+        fName.printf("PDFDocument_threads%d%s", threads, streamPages ? "_stream" : "");
+    }
+    int fThreads;
+    bool fStreamPages;
+    SkString fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+    std::vector<sk_sp<SkImage>> fImages;
+
+    static constexpr int kPages = 8;
+    static constexpr int kImagesPerPage = 4;
+
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend b) override { return b == kNonRendering_Backend; }
+    void onDelayedSetup() override {
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+        SkRandom random;
+        for (int i = 0; i < kPages * kImagesPerPage; ++i) {
+            SkBitmap bitmap;
+            bitmap.allocN32Pixels(256, 256, true);
+            for (int y = 0; y < bitmap.height(); ++y) {
+                for (int x = 0; x < bitmap.width(); ++x) {
+                    // A gradient with some noise, so the pixels neither vanish under DEFLATE nor
+                    // are incompressible.
+                    *bitmap.getAddr32(x, y) = SkPackARGB32(0xFF, SkToU8(x + (random.nextU() & 7)),
+                                                           SkToU8(y), SkToU8(i * 8));
+                }
+            }
+            fImages.push_back(SkImage::MakeFromBitmap(bitmap));
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        SkPDF::Metadata metadata;
+        metadata.fExecutor = fExecutor.get();
+        metadata.fStreamPages = fStreamPages;
+        SkPaint paint;
+        paint.setTextSize(10);
+        while (loops-- > 0) {
+            SkNullWStream nullStream;
+            auto doc = SkPDF::MakeDocument(&nullStream, metadata);
+            for (int page = 0; page < kPages; ++page) {
+                SkCanvas* canvas = doc->beginPage(612, 792);
+                for (int i = 0; i < kImagesPerPage; ++i) {
+                    canvas->drawImage(fImages[page * kImagesPerPage + i].get(),
+                                      40.0f + 270 * (i % 2), 40.0f + 270 * (i / 2));
+                }
+                for (int line = 0; line < 20; ++line) {
+                    canvas->drawString("The quick brown fox jumps over the lazy dog.",
+                                       40, 600.0f + 10 * line, paint);
+                }
+                doc->endPage();
+            }
+            doc->close();
+        }
+    }
+};
+
+/** Writes many small one-page documents in the same font, optionally sharing a font cache
+    between them. */
+struct PDFInvoiceBench : public Benchmark {
+    PDFInvoiceBench(bool useFontCache) : fUseFontCache(useFontCache) {}
+    bool fUseFontCache;
+    sk_sp<SkTypeface> fTypeface;
+
+    const char* onGetName() override {
+        return fUseFontCache ? "PDFInvoice_fontcache" : "PDFInvoice";
+    }
+    bool isSuitableFor(Backend b) override { return b == kNonRendering_Backend; }
+    void onDelayedSetup() override {
+        fTypeface = MakeResourceAsTypeface("fonts/Roboto-Regular.ttf");
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        SkPDF::Metadata metadata;
+        if (fUseFontCache) {
+            metadata.fFontCache = SkPDF::FontCache::Make();
+        }
+        SkPaint paint;
+        paint.setTypeface(fTypeface);
+        paint.setTextSize(10);
+        while (loops-- > 0) {
+            for (int invoice = 0; invoice < 10; ++invoice) {
+                SkNullWStream nullStream;
+                auto doc = SkPDF::MakeDocument(&nullStream, metadata);
+                SkCanvas* canvas = doc->beginPage(612, 792);
+                for (int line = 0; line < 30; ++line) {
+                    canvas->drawString("Widget, part 42-A     3 x 14.95     44.85 USD",
+                                       40, 40.0f + 20 * line, paint);
+                }
+                doc->close();
+            }
+        }
+    }
+};
+
 }  // namespace
 DEF_BENCH(return new PDFImageBench;)
 DEF_BENCH(return new PDFJpegImageBench;)
@@ -265,6 +372,11 @@ DEF_BENCH(return new PDFCompressionBench;)
 DEF_BENCH(return new PDFColorComponentBench;)
 DEF_BENCH(return new PDFShaderBench;)
 DEF_BENCH(return new WritePDFTextBenchmark;)
+DEF_BENCH(return new PDFDocumentBench(0);)
+DEF_BENCH(return new PDFDocumentBench(4);)
+DEF_BENCH(return new PDFDocumentBench(0, true);)
+DEF_BENCH(return new PDFInvoiceBench(false);)
+DEF_BENCH(return new PDFInvoiceBench(true);)
 
 #endif
 
@@ -5,8 +5,10 @@
  * found in the LICENSE file.
  */
 #include "Benchmark.h"
+#include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkColor.h"
+#include "SkExecutor.h"
 #include "SkPaint.h"
 #include "SkPicture.h"
 #include "SkPictureRecorder.h"
@@ -217,3 +219,60 @@ DEF_BENCH( return new TiledPlaybackBench(kNone,     kRandom); )
 DEF_BENCH( return new TiledPlaybackBench(kNone,     kTiled ); )
 DEF_BENCH( return new TiledPlaybackBench(kRTree,    kRandom); )
 DEF_BENCH( return new TiledPlaybackBench(kRTree,    kTiled ); )
+
+// Rasterizes a whole large picture into one pixmap, split into a grid of tiles that are played
+// back concurrently, each culled by the picture's R-tree.  threads == 0 draws the tiles serially.
+class ThreadedPlaybackBench : public Benchmark {
+public:
+    ThreadedPlaybackBench(int tiles, int threads)
+        : fTiles(tiles)
+        , fThreads(threads) {
+        fName.printf("threaded_playback_%dx%d_%dthreads", tiles, tiles, threads);
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkRTreeFactory factory;
+        SkPictureRecorder recorder;
+        SkCanvas* canvas = recorder.beginRecording(2048, 2048, &factory);
+            SkRandom rand;
+            for (int i = 0; i < 20000; i++) {
+                SkScalar x = rand.nextRangeScalar(0, 2048),
+                         y = rand.nextRangeScalar(0, 2048),
+                         w = rand.nextRangeScalar(0, 128),
+                         h = rand.nextRangeScalar(0, 128);
+                SkPaint paint;
+                paint.setColor(rand.nextU());
+                paint.setAntiAlias(true);
+                canvas->drawOval(SkRect::MakeXYWH(x,y,w,h), paint);
+            }
+        fPic = recorder.finishRecordingAsPicture();
+
+        fBitmap.allocN32Pixels(2048, 2048);
+
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            fPic->playback(fBitmap.pixmap(), nullptr, fExecutor.get(), fTiles, fTiles);
+        }
+    }
+
+private:
+    int                         fTiles;
+    int                         fThreads;
+    SkString                    fName;
+    sk_sp<SkPicture>            fPic;
+    SkBitmap                    fBitmap;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH( return new ThreadedPlaybackBench(1, 0); )
+DEF_BENCH( return new ThreadedPlaybackBench(4, 0); )
+DEF_BENCH( return new ThreadedPlaybackBench(4, 4); )
+DEF_BENCH( return new ThreadedPlaybackBench(8, 8); )
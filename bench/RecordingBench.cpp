@@ -66,6 +66,40 @@ void RecordingBench::onDraw(int loops, SkCanvas*) {
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "SkPDFDocument.h"
+#include "SkStream.h"
+
+PDFPictureBench::PDFPictureBench(const char* name, const SkPicture* pic, bool useObjectStreams)
+    : INHERITED(name, pic)
+    , fUseObjectStreams(useObjectStreams)
+{
+    if (fUseObjectStreams) {
+        fName.append("_objstm");
+    }
+    SkNullWStream stream;
+    this->writeDocument(&stream);
+    fDocumentSize = stream.bytesWritten();
+}
+
+void PDFPictureBench::writeDocument(SkWStream* stream) const {
+    SkPDF::Metadata metadata;
+    metadata.fUseObjectStreams = fUseObjectStreams;
+    sk_sp<SkDocument> doc = SkPDF::MakeDocument(stream, metadata);
+    if (!doc) {
+        return;
+    }
+    fSrc->playback(doc->beginPage(fSrc->cullRect().width(), fSrc->cullRect().height()));
+    doc->close();
+}
+
+void PDFPictureBench::onDraw(int loops, SkCanvas*) {
+    while (loops --> 0) {
+        SkNullWStream stream;
+        this->writeDocument(&stream);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 #include "SkSerialProcs.h"
 
@@ -42,6 +42,26 @@ private:
     typedef PictureCentricBench INHERITED;
 };
 
+// Prints the picture to a one page PDF.
+class PDFPictureBench : public PictureCentricBench {
+public:
+    PDFPictureBench(const char* name, const SkPicture*, bool useObjectStreams);
+
+    // The size of the PDF each loop writes, or zero without PDF support.
+    size_t documentSize() const { return fDocumentSize; }
+
+protected:
+    void onDraw(int loops, SkCanvas*) override;
+
+private:
+    void writeDocument(SkWStream*) const;
+
+    bool   fUseObjectStreams;
+    size_t fDocumentSize;
+
+    typedef PictureCentricBench INHERITED;
+};
+
 class DeserializePictureBench : public Benchmark {
 public:
     DeserializePictureBench(const char* name, sk_sp<SkData> encodedPicture);
@@ -9,10 +9,15 @@
 #include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkCommandLineFlags.h"
+#include "SkExecutor.h"
 #include "SkPaint.h"
 #include "SkRandom.h"
 #include "SkShader.h"
 #include "SkString.h"
+#include "SkSurface.h"
+#include "SkTaskGroup.h"
+
+#include <vector>
 
 DEFINE_double(strokeWidth, -1.0, "If set, use this stroke width in RectBench.");
 
@@ -133,6 +138,65 @@ private:
     typedef RectBench INHERITED;
 };
 
+// Thousands of tiny rects sharing one paint, drawn into a color-managed F16 surface so that each
+// draw builds and compiles an SkRasterPipeline blitter.  This is dominated by blitter setup.
+// With threads > 0, that many threads draw at once, each into its own surface.
+class TinyRectBench : public RectBench {
+public:
+    explicit TinyRectBench(int threads = 0) : INHERITED(6), fThreads(threads) {}
+
+protected:
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    const char* onGetName() override {
+        if (fThreads > 0) {
+            fName.printf("%s_threaded_%d", this->computeName("rects_tiny_f16"), fThreads);
+            return fName.c_str();
+        }
+        return computeName("rects_tiny_f16");
+    }
+
+    void onDelayedSetup() override {
+        this->INHERITED::onDelayedSetup();
+        for (int i = 0; i < SkTMax(fThreads, 1); i++) {
+            fSurfaces.push_back(SkSurface::MakeRaster(
+                    SkImageInfo::Make(W, H, kRGBA_F16_SkColorType, kPremul_SkAlphaType,
+                                      SkColorSpace::MakeSRGB())));
+        }
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        auto draw = [this, loops](int thread) {
+            SkCanvas* canvas = fSurfaces[thread]->getCanvas();
+            SkPaint paint;
+            paint.setAntiAlias(true);
+            paint.setAlpha(0x80);
+            for (int i = 0; i < loops; i++) {
+                for (int j = 0; j < N; j++) {
+                    canvas->drawRect(fRects[j], paint);
+                }
+            }
+        };
+
+        if (fThreads > 0) {
+            SkTaskGroup tg(*fExecutor);
+            tg.batch(fThreads, draw);
+            tg.wait();
+        } else {
+            draw(0);
+        }
+    }
+
+private:
+    int                           fThreads;
+    SkString                      fName;
+    std::vector<sk_sp<SkSurface>> fSurfaces;
+    std::unique_ptr<SkExecutor>   fExecutor;
+    typedef RectBench INHERITED;
+};
 
 class OvalBench : public RectBench {
 public:
@@ -277,6 +341,9 @@ DEF_BENCH(return new RectBench(1);)
 DEF_BENCH(return new RectBench(1, 4);)
 DEF_BENCH(return new RectBench(3);)
 DEF_BENCH(return new RectBench(3, 4);)
+DEF_BENCH(return new TinyRectBench();)
+DEF_BENCH(return new TinyRectBench(4);)
+DEF_BENCH(return new TinyRectBench(8);)
 DEF_BENCH(return new OvalBench(1);)
 DEF_BENCH(return new OvalBench(3);)
 DEF_BENCH(return new OvalBench(1, 4);)
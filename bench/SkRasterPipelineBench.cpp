@@ -163,3 +163,64 @@ public:
     }
 };
 DEF_BENCH( return (new SkRasterPipelineToSRGB); )
+
+// Each of these runs a single stage over a row, so that we can compare instruction sets
+// (e.g. HSW vs. SKX) one stage at a time.
+static const int kStageWidth = 256;
+
+static uint32_t stage_8888[kStageWidth];
+static uint64_t stage_f16 [kStageWidth];
+static float    stage_f32 [kStageWidth*4];
+
+static SkRasterPipeline_MemoryCtx stage_8888_ctx = { stage_8888, 0 },
+                                  stage_f16_ctx  = { stage_f16,  0 },
+                                  stage_f32_ctx  = { stage_f32,  0 };
+static SkRasterPipeline_GatherCtx stage_gather_ctx = { stage_8888, 0, kStageWidth, 1 };
+
+class SkRasterPipelineStageBench : public Benchmark {
+public:
+    SkRasterPipelineStageBench(const char* name, SkRasterPipeline::StockStage stage,
+                               void* ctx = nullptr, bool seed = false)
+        : fName(SkStringPrintf("SkRasterPipeline_stage_%s", name))
+        , fStage(stage)
+        , fCtx(ctx)
+        , fSeed(seed) {}
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkRasterPipeline_<256> p;
+        if (fSeed) {
+            p.append(SkRasterPipeline::seed_shader);
+        }
+        p.append(fStage, fCtx);
+
+        while (loops --> 0) {
+            p.run(0,0,kStageWidth,1);
+        }
+    }
+private:
+    SkString                     fName;
+    SkRasterPipeline::StockStage fStage;
+    void*                        fCtx;
+    bool                         fSeed;
+};
+DEF_BENCH( return new SkRasterPipelineStageBench("load_8888",  SkRasterPipeline::load_8888,
+                                                 &stage_8888_ctx); )
+DEF_BENCH( return new SkRasterPipelineStageBench("store_8888", SkRasterPipeline::store_8888,
+                                                 &stage_8888_ctx); )
+DEF_BENCH( return new SkRasterPipelineStageBench("load_f16",   SkRasterPipeline::load_f16,
+                                                 &stage_f16_ctx); )
+DEF_BENCH( return new SkRasterPipelineStageBench("store_f16",  SkRasterPipeline::store_f16,
+                                                 &stage_f16_ctx); )
+DEF_BENCH( return new SkRasterPipelineStageBench("load_f32",   SkRasterPipeline::load_f32,
+                                                 &stage_f32_ctx); )
+DEF_BENCH( return new SkRasterPipelineStageBench("store_f32",  SkRasterPipeline::store_f32,
+                                                 &stage_f32_ctx); )
+DEF_BENCH( return new SkRasterPipelineStageBench("gather_8888", SkRasterPipeline::gather_8888,
+                                                 &stage_gather_ctx, true); )
+DEF_BENCH( return new SkRasterPipelineStageBench("from_srgb",  SkRasterPipeline::from_srgb); )
+DEF_BENCH( return new SkRasterPipelineStageBench("to_srgb",    SkRasterPipeline::to_srgb); )
+DEF_BENCH( return new SkRasterPipelineStageBench("premul",     SkRasterPipeline::premul); )
+DEF_BENCH( return new SkRasterPipelineStageBench("srcover",    SkRasterPipeline::srcover); )
@@ -89,5 +89,55 @@ class TextBlobFirstTimeBench : public SkTextBlobBench {
     }
 };
 
+/*
+ * A page of small, densely packed text in a single run, like a log viewer or a spreadsheet. On
+ * raster canvases this is dominated by the per-glyph cost of blitting masks.
+ */
+class TextBlobDenseBench : public Benchmark {
+    const char* onGetName() override {
+        return "TextBlobDenseBench";
+    }
+
+    SkIPoint onGetSize() override {
+        return SkIPoint::Make(640, 480);
+    }
+
+    void onDelayedSetup() override {
+        SkPaint paint;
+        paint.setTypeface(sk_tool_utils::create_portable_typeface("monospace", SkFontStyle()));
+        paint.setTextSize(10);
+        paint.setAntiAlias(true);
+
+        const char* text = "2018-09-12 14:03:57.113 INFO  [worker-7] flushed 4096 records";
+        SkTDArray<uint16_t> glyphs;
+        glyphs.setCount(paint.textToGlyphs(text, strlen(text), nullptr));
+        paint.textToGlyphs(text, strlen(text), glyphs.begin());
+        paint.setTextEncoding(SkPaint::kGlyphID_TextEncoding);
+
+        const int kLines = 40;
+        SkTextBlobBuilder builder;
+        const auto& run = builder.allocRunPos(paint, glyphs.count() * kLines);
+        for (int line = 0; line < kLines; line++) {
+            for (int i = 0; i < glyphs.count(); i++) {
+                int index = line * glyphs.count() + i;
+                run.glyphs[index] = glyphs[i];
+                run.pos[2 * index + 0] = 4 + i * 6.0f;
+                run.pos[2 * index + 1] = 12 + line * 11.5f;
+            }
+        }
+        fBlob = builder.make();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        for (int i = 0; i < loops; i++) {
+            canvas->drawTextBlob(fBlob, 0, 0, paint);
+        }
+    }
+
+    sk_sp<SkTextBlob> fBlob;
+};
+
 DEF_BENCH( return new TextBlobCachedBench(); )
 DEF_BENCH( return new TextBlobFirstTimeBench(); )
+DEF_BENCH( return new TextBlobDenseBench(); )
@@ -125,6 +125,7 @@ DEFINE_string(zoom, "1.0,0", "Comma-separated zoomMax,zoomPeriodMs factors for a
 DEFINE_bool(bbh, true, "Build a BBH for SKPs?");
 DEFINE_bool(lite, false, "Use SkLiteRecorder in recording benchmarks?");
 DEFINE_bool(mpd, true, "Use MultiPictureDraw for the SKPs?");
+DEFINE_bool(pdf, false, "Also time printing each SKP to PDF, with and without object streams?");
 DEFINE_bool(loopSKP, true, "Loop SKPs like we do for micro benches?");
 DEFINE_int32(flushEvery, 10, "Flush --outResultsFile every Nth run.");
 DEFINE_bool(gpuStats, false, "Print GPU stats after each gpu benchmark?");
@@ -600,17 +601,20 @@ public:
                       , fGMs(skiagm::GMRegistry::Head())
                       , fCurrentRecording(0)
                       , fCurrentDeserialPicture(0)
+                      , fCurrentPDFPicture(0)
                       , fCurrentScale(0)
                       , fCurrentSKP(0)
                       , fCurrentSVG(0)
                       , fCurrentUseMPD(0)
                       , fCurrentCodec(0)
+                      , fCurrentThreadedCodec(0)
                       , fCurrentAndroidCodec(0)
                       , fCurrentBRDImage(0)
                       , fCurrentColorType(0)
                       , fCurrentAlphaType(0)
                       , fCurrentSubsetType(0)
                       , fCurrentSampleSize(0)
+                      , fCurrentThreadCount(0)
                       , fCurrentAnimSKP(0) {
         collect_files(FLAGS_skps, ".skp", &fSKPs);
         collect_files(FLAGS_svgs, ".svg", &fSVGs);
@@ -759,6 +763,24 @@ public:
             return new DeserializePictureBench(name.c_str(), std::move(data));
         }
 
+        // With --pdf, print all .skps to PDF, without and then with object streams.
+        while (FLAGS_pdf && fCurrentPDFPicture < 2 * fSKPs.count()) {
+            const SkString& path = fSKPs[fCurrentPDFPicture / 2];
+            bool useObjectStreams = fCurrentPDFPicture % 2 == 1;
+            fCurrentPDFPicture++;
+            sk_sp<SkPicture> pic = ReadPicture(path.c_str());
+            if (!pic) {
+                continue;
+            }
+            SkString name = SkOSPath::Basename(path.c_str());
+            fSourceType = "skp";
+            fBenchType  = "pdf";
+            auto bench = new PDFPictureBench(name.c_str(), pic.get(), useObjectStreams);
+            fSKPBytes = static_cast<double>(bench->documentSize());
+            fSKPOps   = 0;
+            return bench;
+        }
+
         // Then once each for each scale as SKPBenches (playback).
         while (fCurrentScale < fScales.count()) {
             while (fCurrentSKP < fSKPs.count()) {
@@ -900,6 +922,32 @@ public:
             fCurrentColorType = 0;
         }
 
+        // Run CodecBenches that hand SkCodec an executor. JPEGs divided into restart intervals
+        // decode their intervals concurrently; everything else decodes serially, as before.
+        const int threadCounts[] = { 1, 4, 16 };
+        for (; fCurrentThreadedCodec < fImages.count(); fCurrentThreadedCodec++) {
+            fSourceType = "image";
+            fBenchType = "skcodec";
+
+            const SkString& path = fImages[fCurrentThreadedCodec];
+            if (SkCommandLineFlags::ShouldSkip(FLAGS_match, path.c_str())) {
+                continue;
+            }
+            sk_sp<SkData> encoded(SkData::MakeFromFileName(path.c_str()));
+            std::unique_ptr<SkCodec> codec(SkCodec::MakeFromData(encoded));
+            if (!codec || SkEncodedImageFormat::kJPEG != codec->getEncodedFormat()) {
+                continue;
+            }
+
+            if (fCurrentThreadCount < (int) SK_ARRAY_COUNT(threadCounts)) {
+                int threads = threadCounts[fCurrentThreadCount];
+                fCurrentThreadCount++;
+                return new CodecBench(SkOSPath::Basename(path.c_str()), encoded.get(),
+                                      kN32_SkColorType, kOpaque_SkAlphaType, threads);
+            }
+            fCurrentThreadCount = 0;
+        }
+
         // Run AndroidCodecBenches
         const int sampleSizes[] = { 2, 4, 8 };
         for (; fCurrentAndroidCodec < fImages.count(); fCurrentAndroidCodec++) {
@@ -1037,6 +1085,9 @@ public:
             log->metric("bytes", fSKPBytes);
             log->metric("ops",   fSKPOps);
         }
+        if (0 == strcmp(fBenchType, "pdf")) {
+            log->metric("bytes", fSKPBytes);
+        }
     }
 
 private:
@@ -1070,17 +1121,20 @@ private:
     const char* fBenchType;   // How we bench it: micro, recording, playback, ...
     int fCurrentRecording;
     int fCurrentDeserialPicture;
+    int fCurrentPDFPicture;
     int fCurrentScale;
     int fCurrentSKP;
     int fCurrentSVG;
     int fCurrentUseMPD;
     int fCurrentCodec;
+    int fCurrentThreadedCodec;
     int fCurrentAndroidCodec;
     int fCurrentBRDImage;
     int fCurrentColorType;
     int fCurrentAlphaType;
     int fCurrentSubsetType;
     int fCurrentSampleSize;
+    int fCurrentThreadCount;
     int fCurrentAnimSKP;
 };
 
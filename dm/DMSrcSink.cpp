@@ -54,6 +54,7 @@
 #include "SkSwizzler.h"
 #include "SkTLogic.h"
 #include "SkTaskGroup.h"
+#include "SkThreadedBMPDevice.h"
 #if defined(SK_BUILD_FOR_WIN)
     #include "SkAutoCoInitialize.h"
     #include "SkHRESULT.h"
@@ -1755,6 +1756,26 @@ Error RasterSink::draw(const Src& src, SkBitmap* dst, SkWStream*, SkString*) con
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
+ThreadedSink::ThreadedSink(SkColorType colorType, sk_sp<SkColorSpace> colorSpace)
+        : RasterSink(colorType, colorSpace) {}
+
+Error ThreadedSink::draw(const Src& src, SkBitmap* dst, SkWStream* stream, SkString* str) const {
+    const SkISize size = src.size();
+    SkAlphaType alphaType = kPremul_SkAlphaType;
+    (void)SkColorTypeValidateAlphaType(fColorType, alphaType, &alphaType);
+
+    dst->allocPixelsFlags(SkImageInfo::Make(size.width(), size.height(),
+                                            fColorType, alphaType, fColorSpace),
+                          SkBitmap::kZeroPixels_AllocFlag);
+
+    // The device flushes its queued tiles when it is destroyed, before we return dst.
+    SkCanvas canvas(sk_make_sp<SkThreadedBMPDevice>(*dst, FLAGS_backendTiles,
+                                                    FLAGS_backendThreads));
+    return src.draw(&canvas);
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
 // Handy for front-patching a Src.  Do whatever up-front work you need, then call draw_to_canvas(),
 // passing the Sink draw() arguments, a size, and a function draws into an SkCanvas.
 // Several examples below.
@@ -14,14 +14,17 @@ SkSVGCircle::SkSVGCircle() : INHERITED(SkSVGTag::kCircle) {}
 
 void SkSVGCircle::setCx(const SkSVGLength& cx) {
     fCx = cx;
+    this->invalidate();
 }
 
 void SkSVGCircle::setCy(const SkSVGLength& cy) {
     fCy = cy;
+    this->invalidate();
 }
 
 void SkSVGCircle::setR(const SkSVGLength& r) {
     fR = r;
+    this->invalidate();
 }
 
 void SkSVGCircle::onSetAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
@@ -12,9 +12,18 @@
 
 SkSVGContainer::SkSVGContainer(SkSVGTag t) : INHERITED(t) { }
 
+SkSVGContainer::~SkSVGContainer() {
+    for (int i = 0; i < fChildren.count(); ++i) {
+        SkTDArray<SkSVGNode*>& parents = fChildren[i]->fParents;
+        parents.removeShuffle(parents.find(this));
+    }
+}
+
 void SkSVGContainer::appendChild(sk_sp<SkSVGNode> node) {
     SkASSERT(node);
+    node->fParents.push_back(this);
     fChildren.push_back(std::move(node));
+    this->invalidate();
 }
 
 bool SkSVGContainer::hasChildren() const {
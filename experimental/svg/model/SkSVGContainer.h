@@ -13,7 +13,7 @@
 
 class SkSVGContainer : public SkSVGTransformableNode {
 public:
-    ~SkSVGContainer() override = default;
+    ~SkSVGContainer() override;
 
     void appendChild(sk_sp<SkSVGNode>) override;
 
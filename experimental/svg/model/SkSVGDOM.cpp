@@ -8,6 +8,8 @@
 #include "SkCanvas.h"
 #include "SkDOM.h"
 #include "SkParsePath.h"
+#include "SkPictureRecorder.h"
+#include "SkRectPriv.h"
 #include "SkSVGAttributeParser.h"
 #include "SkSVGCircle.h"
 #include "SkSVGClipPath.h"
@@ -30,6 +32,7 @@
 #include "SkSVGUse.h"
 #include "SkSVGValue.h"
 #include "SkString.h"
+#include "SkTHash.h"
 #include "SkTSearch.h"
 #include "SkTo.h"
 
@@ -370,19 +373,40 @@ SortedDictionaryEntry<sk_sp<SkSVGNode>(*)()> gTagFactories[] = {
     { "use"           , []() -> sk_sp<SkSVGNode> { return SkSVGUse::Make();            }},
 };
 
+// SkDOM shares one copy of each element and attribute name between all the nodes using it,
+// so the dictionary index of a name only needs to be searched for once per name string.
+class NameIndexCache {
+public:
+    template <typename T, size_t N>
+    int find(const char* name, const SortedDictionaryEntry<T> (&dictionary)[N]) {
+        if (const int* index = fIndices.find(name)) {
+            return *index;
+        }
+        const int index = SkStrSearch(&dictionary[0].fKey, SkTo<int>(N), name,
+                                      sizeof(dictionary[0]));
+        fIndices.set(name, index);
+        return index;
+    }
+
+private:
+    SkTHashMap<const char*, int> fIndices;
+};
+
 struct ConstructionContext {
-    ConstructionContext(SkSVGIDMapper* mapper) : fParent(nullptr), fIDMapper(mapper) {}
+    ConstructionContext(SkSVGIDMapper* mapper, NameIndexCache* tags, NameIndexCache* attributes)
+        : fParent(nullptr), fIDMapper(mapper), fTagIndices(tags), fAttributeIndices(attributes) {}
     ConstructionContext(const ConstructionContext& other, const sk_sp<SkSVGNode>& newParent)
-        : fParent(newParent.get()), fIDMapper(other.fIDMapper) {}
+        : fParent(newParent.get()), fIDMapper(other.fIDMapper)
+        , fTagIndices(other.fTagIndices), fAttributeIndices(other.fAttributeIndices) {}
 
     const SkSVGNode* fParent;
     SkSVGIDMapper*   fIDMapper;
+    NameIndexCache*  fTagIndices;
+    NameIndexCache*  fAttributeIndices;
 };
 
-void set_string_attribute(const sk_sp<SkSVGNode>& node, const char* name, const char* value) {
-    const int attrIndex = SkStrSearch(&gAttributeParseInfo[0].fKey,
-                                      SkTo<int>(SK_ARRAY_COUNT(gAttributeParseInfo)),
-                                      name, sizeof(gAttributeParseInfo[0]));
+void set_attribute(const sk_sp<SkSVGNode>& node, int attrIndex, const char* name,
+                   const char* value) {
     if (attrIndex < 0) {
 #if defined(SK_VERBOSE_SVG_PARSING)
         SkDebugf("unhandled attribute: %s\n", name);
@@ -399,17 +423,25 @@ void set_string_attribute(const sk_sp<SkSVGNode>& node, const char* name, const
     }
 }
 
+void set_string_attribute(const sk_sp<SkSVGNode>& node, const char* name, const char* value) {
+    const int attrIndex = SkStrSearch(&gAttributeParseInfo[0].fKey,
+                                      SkTo<int>(SK_ARRAY_COUNT(gAttributeParseInfo)),
+                                      name, sizeof(gAttributeParseInfo[0]));
+    set_attribute(node, attrIndex, name, value);
+}
+
 void parse_node_attributes(const SkDOM& xmlDom, const SkDOM::Node* xmlNode,
-                           const sk_sp<SkSVGNode>& svgNode, SkSVGIDMapper* mapper) {
+                           const sk_sp<SkSVGNode>& svgNode, const ConstructionContext& ctx) {
     const char* name, *value;
     SkDOM::AttrIter attrIter(xmlDom, xmlNode);
     while ((name = attrIter.next(&value))) {
         // We're handling id attributes out of band for now.
         if (!strcmp(name, "id")) {
-            mapper->set(SkString(value), svgNode);
+            ctx.fIDMapper->set(SkString(value), svgNode);
             continue;
         }
-        set_string_attribute(svgNode, name, value);
+        set_attribute(svgNode, ctx.fAttributeIndices->find(name, gAttributeParseInfo),
+                      name, value);
     }
 }
 
@@ -426,9 +458,7 @@ sk_sp<SkSVGNode> construct_svg_node(const SkDOM& dom, const ConstructionContext&
 
     SkASSERT(elemType == SkDOM::kElement_Type);
 
-    const int tagIndex = SkStrSearch(&gTagFactories[0].fKey,
-                                     SkTo<int>(SK_ARRAY_COUNT(gTagFactories)),
-                                     elem, sizeof(gTagFactories[0]));
+    const int tagIndex = ctx.fTagIndices->find(elem, gTagFactories);
     if (tagIndex < 0) {
 #if defined(SK_VERBOSE_SVG_PARSING)
         SkDebugf("unhandled element: <%s>\n", elem);
@@ -438,7 +468,7 @@ sk_sp<SkSVGNode> construct_svg_node(const SkDOM& dom, const ConstructionContext&
 
     SkASSERT(SkTo<size_t>(tagIndex) < SK_ARRAY_COUNT(gTagFactories));
     sk_sp<SkSVGNode> node = gTagFactories[tagIndex].fValue();
-    parse_node_attributes(dom, xmlNode, node, ctx.fIDMapper);
+    parse_node_attributes(dom, xmlNode, node, ctx);
 
     ConstructionContext localCtx(ctx, node);
     for (auto* child = dom.getFirstChild(xmlNode, nullptr); child;
@@ -461,7 +491,8 @@ SkSVGDOM::SkSVGDOM()
 sk_sp<SkSVGDOM> SkSVGDOM::MakeFromDOM(const SkDOM& xmlDom) {
     sk_sp<SkSVGDOM> dom = sk_make_sp<SkSVGDOM>();
 
-    ConstructionContext ctx(&dom->fIDMapper);
+    NameIndexCache tagIndices, attributeIndices;
+    ConstructionContext ctx(&dom->fIDMapper, &tagIndices, &attributeIndices);
     dom->fRoot = construct_svg_node(xmlDom, ctx, xmlDom.getRootNode());
 
     // Reset the default container size to match the intrinsic SVG size.
@@ -480,11 +511,30 @@ sk_sp<SkSVGDOM> SkSVGDOM::MakeFromStream(SkStream& svgStream) {
 }
 
 void SkSVGDOM::render(SkCanvas* canvas) const {
-    if (fRoot) {
-        SkSVGLengthContext       lctx(fContainerSize);
-        SkSVGPresentationContext pctx;
-        fRoot->render(SkSVGRenderContext(canvas, fIDMapper, lctx, pctx));
+    if (!fRoot) {
+        return;
     }
+
+    sk_sp<SkPicture> picture;
+    {
+        SkAutoMutexAcquire lock(fPictureMutex);
+        const uint32_t generationID = fRoot->generationID();
+        if (!fPicture || fPictureGenerationID != generationID ||
+            fPictureContainerSize != fContainerSize) {
+            SkPictureRecorder recorder;
+            SkSVGLengthContext       lctx(fContainerSize);
+            SkSVGPresentationContext pctx;
+            fRoot->render(SkSVGRenderContext(recorder.beginRecording(SkRectPriv::MakeLargest()),
+                                             fIDMapper, lctx, pctx));
+            fPicture = recorder.finishRecordingAsPicture();
+            fPictureGenerationID = generationID;
+            fPictureContainerSize = fContainerSize;
+        }
+        picture = fPicture;
+    }
+
+    // The cull rect of the recording is unbounded, so skip drawPicture()'s test against it.
+    picture->playback(canvas);
 }
 
 SkSize SkSVGDOM::intrinsicSize() const {
@@ -508,4 +558,7 @@ void SkSVGDOM::setContainerSize(const SkSize& containerSize) {
 
 void SkSVGDOM::setRoot(sk_sp<SkSVGNode> root) {
     fRoot = std::move(root);
+
+    SkAutoMutexAcquire lock(fPictureMutex);
+    fPicture.reset();
 }
@@ -8,6 +8,7 @@
 #ifndef SkSVGDOM_DEFINED
 #define SkSVGDOM_DEFINED
 
+#include "SkMutex.h"
 #include "SkRefCnt.h"
 #include "SkSize.h"
 #include "SkSVGIDMapper.h"
@@ -15,6 +16,7 @@
 
 class SkCanvas;
 class SkDOM;
+class SkPicture;
 class SkStream;
 class SkSVGNode;
 
@@ -31,6 +33,8 @@ public:
 
     void setRoot(sk_sp<SkSVGNode>);
 
+    // The tree is recorded into a picture, which later calls replay for as long as no node
+    // changes and the container size stays the same.
     void render(SkCanvas*) const;
 
 private:
@@ -40,6 +44,11 @@ private:
     sk_sp<SkSVGNode> fRoot;
     SkSVGIDMapper    fIDMapper;
 
+    mutable SkMutex          fPictureMutex;
+    mutable sk_sp<SkPicture> fPicture;        // The last recording of fRoot, if any.
+    mutable uint32_t         fPictureGenerationID = 0;
+    mutable SkSize           fPictureContainerSize = SkSize::MakeEmpty();
+
     typedef SkRefCnt INHERITED;
 };
 
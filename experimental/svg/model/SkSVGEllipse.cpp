@@ -14,18 +14,22 @@ SkSVGEllipse::SkSVGEllipse() : INHERITED(SkSVGTag::kEllipse) {}
 
 void SkSVGEllipse::setCx(const SkSVGLength& cx) {
     fCx = cx;
+    this->invalidate();
 }
 
 void SkSVGEllipse::setCy(const SkSVGLength& cy) {
     fCy = cy;
+    this->invalidate();
 }
 
 void SkSVGEllipse::setRx(const SkSVGLength& rx) {
     fRx = rx;
+    this->invalidate();
 }
 
 void SkSVGEllipse::setRy(const SkSVGLength& ry) {
     fRy = ry;
+    this->invalidate();
 }
 
 void SkSVGEllipse::onSetAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
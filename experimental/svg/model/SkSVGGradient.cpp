@@ -12,14 +12,17 @@
 
 void SkSVGGradient::setHref(const SkSVGStringType& href) {
     fHref = std::move(href);
+    this->invalidate();
 }
 
 void SkSVGGradient::setGradientTransform(const SkSVGTransformType& t) {
     fGradientTransform = t;
+    this->invalidate();
 }
 
 void SkSVGGradient::setSpreadMethod(const SkSVGSpreadMethod& spread) {
     fSpreadMethod = spread;
+    this->invalidate();
 }
 
 void SkSVGGradient::onSetAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
@@ -14,18 +14,22 @@ SkSVGLine::SkSVGLine() : INHERITED(SkSVGTag::kLine) {}
 
 void SkSVGLine::setX1(const SkSVGLength& x1) {
     fX1 = x1;
+    this->invalidate();
 }
 
 void SkSVGLine::setY1(const SkSVGLength& y1) {
     fY1 = y1;
+    this->invalidate();
 }
 
 void SkSVGLine::setX2(const SkSVGLength& x2) {
     fX2 = x2;
+    this->invalidate();
 }
 
 void SkSVGLine::setY2(const SkSVGLength& y2) {
     fY2 = y2;
+    this->invalidate();
 }
 
 void SkSVGLine::onSetAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
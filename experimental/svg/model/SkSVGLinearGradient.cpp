@@ -14,18 +14,22 @@ SkSVGLinearGradient::SkSVGLinearGradient() : INHERITED(SkSVGTag::kLinearGradient
 
 void SkSVGLinearGradient::setX1(const SkSVGLength& x1) {
     fX1 = x1;
+    this->invalidate();
 }
 
 void SkSVGLinearGradient::setY1(const SkSVGLength& y1) {
     fY1 = y1;
+    this->invalidate();
 }
 
 void SkSVGLinearGradient::setX2(const SkSVGLength& x2) {
     fX2 = x2;
+    this->invalidate();
 }
 
 void SkSVGLinearGradient::setY2(const SkSVGLength& y2) {
     fY2 = y2;
+    this->invalidate();
 }
 
 void SkSVGLinearGradient::onSetAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
@@ -13,7 +13,14 @@
 #include "SkSVGValue.h"
 #include "SkTLazy.h"
 
-SkSVGNode::SkSVGNode(SkSVGTag t) : fTag(t) { }
+#include <atomic>
+
+static uint32_t next_generation_id() {
+    static std::atomic<uint32_t> nextID{1};
+    return nextID++;
+}
+
+SkSVGNode::SkSVGNode(SkSVGTag t) : fTag(t), fGenerationID(next_generation_id()) { }
 
 SkSVGNode::~SkSVGNode() { }
 
@@ -56,59 +63,86 @@ bool SkSVGNode::onPrepareToRender(SkSVGRenderContext* ctx) const {
     return visibility != SkSVGVisibility::Type::kHidden;
 }
 
+void SkSVGNode::invalidate() {
+    this->setGenerationID(next_generation_id());
+}
+
+void SkSVGNode::setGenerationID(uint32_t id) {
+    // New IDs always exceed old ones, so each node's ID stays the largest of its subtree.
+    fGenerationID = id;
+    for (SkSVGNode* parent : fParents) {
+        if (parent->fGenerationID != id) {
+            parent->setGenerationID(id);
+        }
+    }
+}
+
 void SkSVGNode::setAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
     this->onSetAttribute(attr, v);
+    this->invalidate();
 }
 
 void SkSVGNode::setClipPath(const SkSVGClip& clip) {
     fPresentationAttributes.fClipPath.set(clip);
+    this->invalidate();
 }
 
 void SkSVGNode::setClipRule(const SkSVGFillRule& clipRule) {
     fPresentationAttributes.fClipRule.set(clipRule);
+    this->invalidate();
 }
 
 void SkSVGNode::setFill(const SkSVGPaint& svgPaint) {
     fPresentationAttributes.fFill.set(svgPaint);
+    this->invalidate();
 }
 
 void SkSVGNode::setFillOpacity(const SkSVGNumberType& opacity) {
     fPresentationAttributes.fFillOpacity.set(
         SkSVGNumberType(SkTPin<SkScalar>(opacity.value(), 0, 1)));
+    this->invalidate();
 }
 
 void SkSVGNode::setFillRule(const SkSVGFillRule& fillRule) {
     fPresentationAttributes.fFillRule.set(fillRule);
+    this->invalidate();
 }
 
 void SkSVGNode::setOpacity(const SkSVGNumberType& opacity) {
     fPresentationAttributes.fOpacity.set(
         SkSVGNumberType(SkTPin<SkScalar>(opacity.value(), 0, 1)));
+    this->invalidate();
 }
 
 void SkSVGNode::setStroke(const SkSVGPaint& svgPaint) {
     fPresentationAttributes.fStroke.set(svgPaint);
+    this->invalidate();
 }
 
 void SkSVGNode::setStrokeDashArray(const SkSVGDashArray& dashArray) {
     fPresentationAttributes.fStrokeDashArray.set(dashArray);
+    this->invalidate();
 }
 
 void SkSVGNode::setStrokeDashOffset(const SkSVGLength& dashOffset) {
     fPresentationAttributes.fStrokeDashOffset.set(dashOffset);
+    this->invalidate();
 }
 
 void SkSVGNode::setStrokeOpacity(const SkSVGNumberType& opacity) {
     fPresentationAttributes.fStrokeOpacity.set(
         SkSVGNumberType(SkTPin<SkScalar>(opacity.value(), 0, 1)));
+    this->invalidate();
 }
 
 void SkSVGNode::setStrokeWidth(const SkSVGLength& strokeWidth) {
     fPresentationAttributes.fStrokeWidth.set(strokeWidth);
+    this->invalidate();
 }
 
 void SkSVGNode::setVisibility(const SkSVGVisibility& visibility) {
     fPresentationAttributes.fVisibility.set(visibility);
+    this->invalidate();
 }
 
 void SkSVGNode::onSetAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
@@ -10,6 +10,7 @@
 
 #include "SkRefCnt.h"
 #include "SkSVGAttribute.h"
+#include "SkTDArray.h"
 
 class SkCanvas;
 class SkMatrix;
@@ -51,6 +52,11 @@ public:
 
     void setAttribute(SkSVGAttribute, const SkSVGValue&);
 
+    // Changes whenever an attribute of this node or of one of its descendants is set, or a
+    // child is added to any of them, so that whatever was made from the subtree can be reused
+    // for as long as it stays the same.
+    uint32_t generationID() const { return fGenerationID; }
+
     void setClipPath(const SkSVGClip&);
     void setClipRule(const SkSVGFillRule&);
     void setFill(const SkSVGPaint&);
@@ -85,8 +91,17 @@ protected:
 
     virtual bool hasChildren() const { return false; }
 
+    // Gives this node and all its ancestors a new generation ID.  Every setter must call this.
+    void invalidate();
+
 private:
+    friend class SkSVGContainer;  // Keeps fParents up to date.
+
+    void setGenerationID(uint32_t);
+
     SkSVGTag                    fTag;
+    uint32_t                    fGenerationID;
+    SkTDArray<SkSVGNode*>       fParents;  // The containers holding this node; not owned.
 
     // FIXME: this should be sparse
     SkSVGPresentationAttributes fPresentationAttributes;
@@ -16,7 +16,7 @@ public:
     ~SkSVGPath() override = default;
     static sk_sp<SkSVGPath> Make() { return sk_sp<SkSVGPath>(new SkSVGPath()); }
 
-    void setPath(const SkPath& path) { fPath = path; }
+    void setPath(const SkPath& path) { fPath = path; this->invalidate(); }
 
 protected:
     void onSetAttribute(SkSVGAttribute, const SkSVGValue&) override;
@@ -16,26 +16,32 @@ SkSVGPattern::SkSVGPattern() : INHERITED(SkSVGTag::kPattern) {}
 
 void SkSVGPattern::setX(const SkSVGLength& x) {
     fAttributes.fX.set(x);
+    this->invalidate();
 }
 
 void SkSVGPattern::setY(const SkSVGLength& y) {
     fAttributes.fY.set(y);
+    this->invalidate();
 }
 
 void SkSVGPattern::setWidth(const SkSVGLength& w) {
     fAttributes.fWidth.set(w);
+    this->invalidate();
 }
 
 void SkSVGPattern::setHeight(const SkSVGLength& h) {
     fAttributes.fHeight.set(h);
+    this->invalidate();
 }
 
 void SkSVGPattern::setHref(const SkSVGStringType& href) {
     fHref = std::move(href);
+    this->invalidate();
 }
 
 void SkSVGPattern::setPatternTransform(const SkSVGTransformType& patternTransform) {
     fAttributes.fPatternTransform.set(patternTransform);
+    this->invalidate();
 }
 
 void SkSVGPattern::onSetAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
@@ -18,6 +18,7 @@ void SkSVGPoly::setPoints(const SkSVGPointsType& pts) {
     fPath.addPoly(pts.value().begin(),
                   pts.value().count(),
                   this->tag() == SkSVGTag::kPolygon); // only polygons are auto-closed
+    this->invalidate();
 }
 
 void SkSVGPoly::onSetAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
@@ -14,22 +14,27 @@ SkSVGRadialGradient::SkSVGRadialGradient() : INHERITED(SkSVGTag::kRadialGradient
 
 void SkSVGRadialGradient::setCx(const SkSVGLength& cx) {
     fCx = cx;
+    this->invalidate();
 }
 
 void SkSVGRadialGradient::setCy(const SkSVGLength& cy) {
     fCy = cy;
+    this->invalidate();
 }
 
 void SkSVGRadialGradient::setR(const SkSVGLength& r) {
     fR = r;
+    this->invalidate();
 }
 
 void SkSVGRadialGradient::setFx(const SkSVGLength& fx) {
     fFx.set(fx);
+    this->invalidate();
 }
 
 void SkSVGRadialGradient::setFy(const SkSVGLength& fy) {
     fFy.set(fy);
+    this->invalidate();
 }
 
 void SkSVGRadialGradient::onSetAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
@@ -15,26 +15,32 @@ SkSVGRect::SkSVGRect() : INHERITED(SkSVGTag::kRect) {}
 
 void SkSVGRect::setX(const SkSVGLength& x) {
     fX = x;
+    this->invalidate();
 }
 
 void SkSVGRect::setY(const SkSVGLength& y) {
     fY = y;
+    this->invalidate();
 }
 
 void SkSVGRect::setWidth(const SkSVGLength& w) {
     fWidth = w;
+    this->invalidate();
 }
 
 void SkSVGRect::setHeight(const SkSVGLength& h) {
     fHeight = h;
+    this->invalidate();
 }
 
 void SkSVGRect::setRx(const SkSVGLength& rx) {
     fRx = rx;
+    this->invalidate();
 }
 
 void SkSVGRect::setRy(const SkSVGLength& ry) {
     fRy = ry;
+    this->invalidate();
 }
 
 void SkSVGRect::onSetAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
@@ -46,22 +46,27 @@ bool SkSVGSVG::onPrepareToRender(SkSVGRenderContext* ctx) const {
 
 void SkSVGSVG::setX(const SkSVGLength& x) {
     fX = x;
+    this->invalidate();
 }
 
 void SkSVGSVG::setY(const SkSVGLength& y) {
     fY = y;
+    this->invalidate();
 }
 
 void SkSVGSVG::setWidth(const SkSVGLength& w) {
     fWidth = w;
+    this->invalidate();
 }
 
 void SkSVGSVG::setHeight(const SkSVGLength& h) {
     fHeight = h;
+    this->invalidate();
 }
 
 void SkSVGSVG::setViewBox(const SkSVGViewBoxType& vb) {
     fViewBox.set(vb);
+    this->invalidate();
 }
 
 void SkSVGSVG::onSetAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
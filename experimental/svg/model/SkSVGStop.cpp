@@ -13,14 +13,17 @@ SkSVGStop::SkSVGStop() : INHERITED(SkSVGTag::kStop) {}
 
 void SkSVGStop::setOffset(const SkSVGLength& offset) {
     fOffset = offset;
+    this->invalidate();
 }
 
 void SkSVGStop::setStopColor(const SkSVGColorType& color) {
     fStopColor = color;
+    this->invalidate();
 }
 
 void SkSVGStop::setStopOpacity(const SkSVGNumberType& opacity) {
     fStopOpacity = SkTPin<SkScalar>(opacity.value(), 0, 1);
+    this->invalidate();
 }
 
 void SkSVGStop::onSetAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
@@ -15,7 +15,7 @@ class SkSVGTransformableNode : public SkSVGNode {
 public:
     ~SkSVGTransformableNode() override = default;
 
-    void setTransform(const SkSVGTransformType& t) { fTransform = t; }
+    void setTransform(const SkSVGTransformType& t) { fTransform = t; this->invalidate(); }
 
 protected:
     SkSVGTransformableNode(SkSVGTag);
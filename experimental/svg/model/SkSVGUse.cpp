@@ -19,14 +19,17 @@ void SkSVGUse::appendChild(sk_sp<SkSVGNode>) {
 
 void SkSVGUse::setHref(const SkSVGStringType& href) {
     fHref = href;
+    this->invalidate();
 }
 
 void SkSVGUse::setX(const SkSVGLength& x) {
     fX = x;
+    this->invalidate();
 }
 
 void SkSVGUse::setY(const SkSVGLength& y) {
     fY = y;
+    this->invalidate();
 }
 
 void SkSVGUse::onSetAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
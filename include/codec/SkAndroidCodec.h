@@ -10,6 +10,7 @@
 
 #include "SkCodec.h"
 #include "SkEncodedImageFormat.h"
+#include "SkFilterQuality.h"
 #include "SkStream.h"
 #include "SkTypes.h"
 
@@ -193,6 +194,7 @@ public:
             : fZeroInitialized(SkCodec::kNo_ZeroInitialized)
             , fSubset(nullptr)
             , fSampleSize(1)
+            , fFilterQuality(kNone_SkFilterQuality)
         {}
 
         /**
@@ -222,6 +224,23 @@ public:
          *  The default is 1, representing no downscaling.
          */
         int fSampleSize;
+
+        /**
+         *  If not kNone_SkFilterQuality, the image (or fSubset) is resized to the
+         *  dimensions of the requested info, whatever they are, by filtering rows
+         *  as they are decoded, rather than by sampling. fSampleSize is ignored:
+         *  the codec decodes at the smallest size it supports natively that is no
+         *  smaller than info, and only keeps as many rows as the filter spans.
+         *
+         *  kLow and kMedium average the pixels each destination pixel covers (a
+         *  box filter). kHigh uses a sharper Lanczos filter.
+         *
+         *  Only 8888 color types, premultiplied or opaque, can be filtered. WebP
+         *  images are resized by libwebp instead.
+         *
+         *  The default is kNone_SkFilterQuality.
+         */
+        SkFilterQuality fFilterQuality;
     };
 
     /**
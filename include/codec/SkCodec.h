@@ -26,6 +26,7 @@
 
 class SkColorSpace;
 class SkData;
+class SkExecutor;
 class SkFrameHolder;
 class SkPngChunkReader;
 class SkSampler;
@@ -257,6 +258,7 @@ public:
             , fSubset(nullptr)
             , fFrameIndex(0)
             , fPriorFrame(kNoFrame)
+            , fExecutor(nullptr)
         {}
 
         ZeroInitialized            fZeroInitialized;
@@ -300,6 +302,16 @@ public:
          *  If set to kNoFrame, the codec will decode any necessary required frame(s) first.
          */
         int                        fPriorFrame;
+
+        /**
+         *  If not NULL, the codec may use this executor to decode independent parts of the
+         *  image concurrently.  getPixels() still returns only once the whole image has been
+         *  decoded, and the result is the same as a serial decode.
+         *
+         *  Currently only used by full (non-subset) JPEG decodes from memory, when the encoded
+         *  data is divided into restart intervals.  Other decodes ignore it.
+         */
+        SkExecutor*                fExecutor;
     };
 
     /**
@@ -356,13 +368,17 @@ public:
      *                    channels will always be planar.
      *  @param colorSpace Output parameter.  If non-NULL this is set to kJPEG,
      *                    otherwise this is ignored.
+     *  @param options    If non-NULL, the scaled size and subset of the planes to
+     *                    decode.  Returns false if the codec can not decode them.
      */
-    bool queryYUV8(SkYUVSizeInfo* sizeInfo, SkYUVColorSpace* colorSpace) const {
+    bool queryYUV8(SkYUVSizeInfo* sizeInfo, SkYUVColorSpace* colorSpace,
+                   const SkYUVDecodeOptions* options = nullptr) const {
         if (nullptr == sizeInfo) {
             return false;
         }
 
-        bool result = this->onQueryYUV8(sizeInfo, colorSpace);
+        bool result = this->onQueryYUV8(sizeInfo, colorSpace,
+                                        options ? *options : SkYUVDecodeOptions());
         if (result) {
             for (int i = 0; i <= 2; ++i) {
                 SkASSERT(sizeInfo->fSizes[i].fWidth > 0 && sizeInfo->fSizes[i].fHeight > 0 &&
@@ -384,8 +400,10 @@ public:
      *                    query, except the WidthBytes may be larger than the
      *                    recommendation (but not smaller).
      *  @param planes     Memory for each of the Y, U, and V planes.
+     *  @param options    Needs to match the options passed to the query.
      */
-    Result getYUV8Planes(const SkYUVSizeInfo& sizeInfo, void* planes[SkYUVSizeInfo::kMaxCount]) {
+    Result getYUV8Planes(const SkYUVSizeInfo& sizeInfo, void* planes[SkYUVSizeInfo::kMaxCount],
+                         const SkYUVDecodeOptions* options = nullptr) {
         if (!planes || !planes[0] || !planes[1] || !planes[2]) {
             return kInvalidInput;
         }
@@ -395,7 +413,19 @@ public:
             return kCouldNotRewind;
         }
 
-        return this->onGetYUV8Planes(sizeInfo, planes);
+        return this->onGetYUV8Planes(sizeInfo, planes, options ? *options : SkYUVDecodeOptions());
+    }
+
+    /**
+     *  Like getValidSubset(), for decoding YUV planes: if desiredSubset of the Y plane, scaled
+     *  to scaledDimensions (or at full size, if scaledDimensions is empty), can not be decoded
+     *  as is, move its left and top edges out to the nearest edges of a chroma sample.
+     *
+     *  @return true if this codec can decode the YUV planes of desiredSubset (as returned,
+     *      potentially modified) at that scale.
+     */
+    bool getValidYUV8Subset(const SkISize& scaledDimensions, SkIRect* desiredSubset) const {
+        return this->onGetValidYUV8Subset(scaledDimensions, desiredSubset);
     }
 
     /**
@@ -664,6 +694,24 @@ public:
      */
     std::vector<FrameInfo> getFrameInfo();
 
+    /**
+     *  Decode frames [firstFrame, firstFrame + frameCount) of the image in data, frame
+     *  firstFrame + i into pixels[i]. Every frame is decoded to dstInfo, with rowBytes, as if by
+     *  getPixels(). A frame that is blended with an earlier frame in the range starts from a copy
+     *  of that frame's output rather than decoding it again.
+     *
+     *  If executor is not null, frames run on it as soon as the frame they are blended with is
+     *  done, so independent frames, and frames that only depend on the same earlier frame, are
+     *  decoded at the same time. Each concurrent decode makes its own SkCodec from data. The
+     *  output does not depend on the executor.
+     *
+     *  Returns kSuccess if every frame was decoded, and otherwise the result of the first frame
+     *  that was not. The other frames are still decoded.
+     */
+    static Result DecodeFrames(sk_sp<SkData> data, const SkImageInfo& dstInfo,
+                               void* const pixels[], size_t rowBytes,
+                               int firstFrame, int frameCount, SkExecutor* executor = nullptr);
+
     static constexpr int kRepetitionCountInfinite = -1;
 
     /**
@@ -720,15 +768,22 @@ protected:
                                void* pixels, size_t rowBytes, const Options&,
                                int* rowsDecoded) = 0;
 
-    virtual bool onQueryYUV8(SkYUVSizeInfo*, SkYUVColorSpace*) const {
+    virtual bool onQueryYUV8(SkYUVSizeInfo*, SkYUVColorSpace*,
+                             const SkYUVDecodeOptions&) const {
         return false;
     }
 
     virtual Result onGetYUV8Planes(const SkYUVSizeInfo&,
-                                   void*[SkYUVSizeInfo::kMaxCount] /*planes*/) {
+                                   void*[SkYUVSizeInfo::kMaxCount] /*planes*/,
+                                   const SkYUVDecodeOptions&) {
         return kUnimplemented;
     }
 
+    virtual bool onGetValidYUV8Subset(const SkISize& /*scaledDimensions*/,
+                                      SkIRect* /*desiredSubset*/) const {
+        return false;
+    }
+
     virtual bool onGetValidSubset(SkIRect* /*desiredSubset*/) const {
         // By default, subsets are not supported.
         return false;
@@ -111,6 +111,20 @@ public:
                         const SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
                         void* planes[]);
 
+    /**
+     *  Like queryYUVA8() and getYUVA8Planes(), for the planes of a subset of the image and/or of
+     *  the image scaled down, as selected by options. Returns false if the generator can not
+     *  produce those planes itself.
+     */
+    bool queryYUVA8(SkYUVSizeInfo* sizeInfo,
+                    SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
+                    SkYUVColorSpace* colorSpace,
+                    const SkYUVDecodeOptions& options) const;
+    bool getYUVA8Planes(const SkYUVSizeInfo& sizeInfo,
+                        const SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
+                        void* planes[],
+                        const SkYUVDecodeOptions& options);
+
 #if SK_SUPPORT_GPU
     /**
      *  If the generator can natively/efficiently return its pixels as a GPU image (backed by a
@@ -174,6 +188,16 @@ protected:
                               SkYUVColorSpace*) const { return false; }
     virtual bool onGetYUVA8Planes(const SkYUVSizeInfo&, const SkYUVAIndex[SkYUVAIndex::kIndexCount],
                                   void*[4] /*planes*/) { return false; }
+    // Only called with options that are not the default.
+    virtual bool onQueryScaledYUVA8(SkYUVSizeInfo*, SkYUVAIndex[SkYUVAIndex::kIndexCount],
+                                    SkYUVColorSpace*, const SkYUVDecodeOptions&) const {
+        return false;
+    }
+    virtual bool onGetScaledYUVA8Planes(const SkYUVSizeInfo&,
+                                        const SkYUVAIndex[SkYUVAIndex::kIndexCount],
+                                        void*[4] /*planes*/, const SkYUVDecodeOptions&) {
+        return false;
+    }
     // Deprecated methods
     virtual bool onQueryYUV8(SkYUVSizeInfo*, SkYUVColorSpace*) const { return false; }
     virtual bool onGetYUV8Planes(const SkYUVSizeInfo&, void*[3] /*planes*/) { return false; }
@@ -25,7 +25,10 @@
 class SkCanvas;
 class SkData;
 struct SkDeserialProcs;
+class SkExecutor;
 class SkImage;
+class SkMatrix;
+class SkPixmap;
 struct SkSerialProcs;
 class SkStream;
 class SkWStream;
@@ -133,6 +136,28 @@ public:
     */
     virtual void playback(SkCanvas* canvas, AbortCallback* callback = nullptr) const = 0;
 
+    /** Replays the drawing commands into dst, split into a grid of tileCountX by tileCountY
+        tiles. Each tile is drawn on its own task on executor, and plays back only the commands
+        its bounds select from the bounding box hierarchy, if SkPicture was recorded with one.
+        Tiles write disjoint pixels of dst, so no compositing step follows.
+
+        Tiles have no border: each is drawn as if dst were only that tile. Drawing that reads
+        pixels from outside its own tile, such as an image filter sampling its backdrop, may leave
+        seams at tile edges. Use one tile for pictures that draw with such effects.
+
+        If executor is nullptr, tiles are drawn one after another on the calling thread.
+        Returns after all tiles are drawn.
+
+        @param dst         destination pixels; must be writable and have a raster color type
+        @param matrix      SkMatrix applied to SkPicture before drawing; may be nullptr
+        @param executor    runs tile tasks; may be nullptr
+        @param tileCountX  number of tile columns; clamped to [1, dst width]
+        @param tileCountY  number of tile rows; clamped to [1, dst height]
+        @return            true if dst could be drawn into
+    */
+    bool playback(const SkPixmap& dst, const SkMatrix* matrix, SkExecutor* executor,
+                  int tileCountX, int tileCountY) const;
+
     /** Returns cull SkRect for this picture, passed in when SkPicture was created.
         Returned SkRect does not specify clipping SkRect for SkPicture; cull is hint
         of SkPicture bounds.
@@ -59,4 +59,26 @@ struct SkYUVSizeInfo {
 
 };
 
+/**
+ *  Selects the YUV planes to decode. By default, they are the planes of the whole image, at its
+ *  full size.
+ */
+struct SkYUVDecodeOptions {
+    /**
+     *  If not empty, decode the planes of the image scaled down so that the Y plane has these
+     *  dimensions. Only sizes that the decoder can produce natively are supported, e.g. the ones
+     *  returned by SkCodec::getScaledDimensions().
+     */
+    SkISize     fScaledDimensions = SkISize::MakeEmpty();
+
+    /**
+     *  If not empty, decode only this part of the (scaled) Y plane, and the parts of the other
+     *  planes that cover it. Its left and top must fall on the edge of a chroma sample, so that
+     *  the planes still line up; SkCodec::getValidYUV8Subset() returns such a subset.
+     */
+    SkIRect     fSubset = SkIRect::MakeEmpty();
+
+    bool isDefault() const { return fScaledDimensions.isEmpty() && fSubset.isEmpty(); }
+};
+
 #endif // SkYUVSizeInfo_DEFINED
@@ -9,6 +9,8 @@
 #include "SkString.h"
 #include "SkTime.h"
 
+class SkExecutor;
+
 namespace SkPDF {
 
 /** Table 333 in PDF 32000-1:2008
@@ -72,6 +74,27 @@ struct StructureElementNode {
     DocumentStructureType fType;
 };
 
+/** Font data that several documents may share: typeface metrics, glyph to
+    unicode maps and compressed font programs, and, for each set of glyphs
+    used from a typeface, the subset font program, glyph widths and
+    ToUnicode CMap.  Documents that use the same fonts then only compute
+    these once.  It is safe to use one cache from documents on different
+    threads at the same time.
+*/
+class SK_API FontCache : public SkRefCnt {
+public:
+    /** Returns a cache that keeps the data of at most subsetCount glyph
+        sets, dropping the least recently used.  The metrics, unicode maps
+        and font programs of typefaces are kept while they take at most
+        typefaceBytes, also dropping the least recently used.  Returns
+        nullptr if PDF support is not built in.
+    */
+    static sk_sp<FontCache> Make(int subsetCount = 256, size_t typefaceBytes = 16 << 20);
+
+protected:
+    FontCache() = default;
+};
+
 /** Optional metadata to be passed into the PDF factory function.
 */
 struct Metadata {
@@ -141,6 +164,65 @@ struct Metadata {
      *  should retain ownership.
      */
     const StructureElementNode* fStructureElementTreeRoot = nullptr;
+
+    /** If true, images that are different SkImage objects but have the same
+        encoded data or the same pixels are embedded only once.  This costs
+        a digest of every new image's data (decoding it if it has no encoded
+        data), and saves space when the same picture arrives repeatedly as
+        new SkImages, for example a logo decoded once per page.
+    */
+    bool fDeduplicateImagesByContent = false;
+
+    /** If true, each page is written out, and everything only it uses is
+        freed, as soon as the page ends; only fonts and the objects shared
+        through the document (images, graphic states, shaders) are kept
+        until close().  Memory use then no longer grows with the page
+        count, at the cost of a flat page tree.
+    */
+    bool fStreamPages = false;
+
+    /** If true, write a PDF 1.5 file that packs every object that is not a
+        stream into compressed object streams, and replaces the
+        cross-reference table with a compressed cross-reference stream.
+        This makes text-heavy documents noticeably smaller.
+    */
+    bool fUseObjectStreams = false;
+
+    /** If true, write a linearized ("fast web view") file: the first page
+        and everything it needs come right after a short cross-reference
+        table at the front, followed by hint tables that tell a viewer
+        where every other page starts, so that it can display any page
+        after fetching only part of the file.  Nothing is written until
+        close(), which then holds the whole document in memory; this
+        overrides fStreamPages and fUseObjectStreams.
+    */
+    bool fLinearize = false;
+
+    /** If not zero, each page's content stream is compressed while the page
+        is drawn, every time this many bytes of it have been written, rather
+        than being kept uncompressed until the page ends.  The uncompressed
+        content then never exists in full, which matters for pages with very
+        many drawing operations.  64KB is a reasonable size.  The page
+        content may come out a few bytes different, and its compression is
+        not handed to fExecutor.
+    */
+    size_t fPageContentChunkSize = 0;
+
+    /** If not nullptr, font data is looked up in and added to this cache
+        instead of being computed for this document alone.  The output does
+        not depend on the cache.
+    */
+    sk_sp<FontCache> fFontCache;
+
+    /** Executor to handle threaded work within PDF Backend. If this is nullptr,
+        then all work will be done serially on the main thread. To have worker
+        threads assist with various tasks, set this to a valid SkExecutor
+        instance. Currently used for image encoding, stream compression and
+        font subsetting. The output does not depend on the executor.
+
+        The executor must outlive the document.
+    */
+    SkExecutor* fExecutor = nullptr;
 };
 
 /** Associate a node ID with subsequent drawing commands in an
@@ -9,12 +9,31 @@
 #define SkAnimCodecPlayer_DEFINED
 
 #include "SkCodec.h"
+#include "SkMutex.h"
 
+#include <atomic>
+#include <limits>
+
+class SkExecutor;
 class SkImage;
+class SkTaskGroup;
 
 class SkAnimCodecPlayer {
 public:
-    SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec);
+    /**
+     *  Decoded frames are kept while their total size is at most frameCacheBudget bytes; the
+     *  current frame is always kept. Beyond that, the frames that playback will need again last
+     *  are dropped first, to be decoded again when they come back around, but frames that an
+     *  uncached frame coming up sooner needs to decode from are kept as long as possible. The
+     *  default keeps every frame.
+     *
+     *  If executor is not null, each time seek() moves to another frame, the next few frames in
+     *  the direction of the seek are decoded ahead of time on it, as far as the budget allows.
+     *  The executor must outlive the player.
+     */
+    SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec,
+                      size_t frameCacheBudget = std::numeric_limits<size_t>::max(),
+                      SkExecutor* executor = nullptr);
     ~SkAnimCodecPlayer();
 
     /**
@@ -46,14 +65,28 @@ public:
 
 
 private:
+    // fCodecMutex guards the codec and fMutex guards the cache; the decode-ahead tasks share
+    // both. fMutex is never held while decoding, and is taken after fCodecMutex if both are.
+    SkMutex                         fCodecMutex;
+    SkMutex                         fMutex;
     std::unique_ptr<SkCodec>        fCodec;
     SkImageInfo                     fImageInfo;
     std::vector<SkCodec::FrameInfo> fFrameInfos;
     std::vector<sk_sp<SkImage> >    fImages;
-    int                             fCurrIndex = 0;
+    size_t                          fFrameCacheBudget;
+    size_t                          fCachedBytes = 0;
+    std::atomic<int>                fCurrIndex{0};
+    std::atomic<int>                fDirection{1};  // 1 forward, -1 backward.
     uint32_t                        fTotalDuration;
 
+    std::atomic<uint32_t>           fSeekID{0};     // Stops decode-ahead started by older seeks.
+    std::unique_ptr<SkTaskGroup>    fDecodeAhead;
+
     sk_sp<SkImage> getFrameAt(int index);
+    bool isCached(int index);
+    void cacheFrame(int index, sk_sp<SkImage>);  // Requires fMutex.
+    int stepsUntil(int index) const;
+    void decodeAhead();
 };
 
 #endif
@@ -18,6 +18,10 @@
  *  where the caller knows that rewind will only be called from within
  *  X bytes (inclusive), and the wrapped stream is not necessarily
  *  able to rewind at all.
+ *
+ *  If the wrapped stream is in memory, and has a length and a position,
+ *  nothing is buffered: it is read directly, and getMemoryBase() returns
+ *  the address of its data, so that decoders can read it in place.
  */
 class SK_API SkFrontBufferedStream {
 public:
@@ -13,11 +13,13 @@
 #include "SkPath.h"
 
 class SkString;
+class SkWStream;
 
 class SkParsePath {
 public:
     static bool FromSVGString(const char str[], SkPath*);
     static void ToSVGString(const SkPath&, SkString*);
+    static void ToSVGString(const SkPath&, SkWStream*);
 };
 
 #endif
@@ -24,6 +24,7 @@ SkBmpRLECodec::SkBmpRLECodec(SkEncodedInfo&& info,
     , fNumColors(numColors)
     , fBytesPerColor(bytesPerColor)
     , fOffset(offset)
+    , fStreamBuffer(fBufferStorage)
     , fBytesBuffered(0)
     , fCurrRLEByte(0)
     , fSampleX(1)
@@ -124,7 +125,14 @@ SkCodec::Result SkBmpRLECodec::onGetPixels(const SkImageInfo& dstInfo,
 }
 
 bool SkBmpRLECodec::initializeStreamBuffer() {
-    fBytesBuffered = this->stream()->read(fStreamBuffer, kBufferSize);
+    size_t unreadLength;
+    if (const uint8_t* unread = get_unread_memory(this->stream(), &unreadLength)) {
+        fStreamBuffer = unread;
+        fBytesBuffered = this->stream()->skip(SkTMin(unreadLength, (size_t) SK_MaxS32));
+    } else {
+        fStreamBuffer = fBufferStorage;
+        fBytesBuffered = this->stream()->read(fBufferStorage, kBufferSize);
+    }
     if (fBytesBuffered == 0) {
         SkCodecPrintf("Error: could not read RLE image data.\n");
         return false;
@@ -139,7 +147,11 @@ bool SkBmpRLECodec::initializeStreamBuffer() {
  */
 size_t SkBmpRLECodec::checkForMoreData() {
     const size_t remainingBytes = fBytesBuffered - fCurrRLEByte;
-    uint8_t* buffer = fStreamBuffer;
+    if (fStreamBuffer != fBufferStorage) {
+        // All of the data is already available.
+        return remainingBytes;
+    }
+    uint8_t* buffer = fBufferStorage;
 
     // We will be reusing the same buffer, starting over from the beginning.
     // Move any remaining bytes to the start of the buffer.
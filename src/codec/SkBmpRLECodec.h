@@ -102,7 +102,10 @@ private:
     const uint32_t             fOffset;
 
     static constexpr size_t    kBufferSize = 4096;
-    uint8_t                    fStreamBuffer[kBufferSize];
+    // Points to fBufferStorage, or, if the stream is in memory, to all of its
+    // unread bytes.
+    const uint8_t*             fStreamBuffer;
+    uint8_t                    fBufferStorage[kBufferSize];
     size_t                     fBytesBuffered;
 
     uint32_t                   fCurrRLEByte;
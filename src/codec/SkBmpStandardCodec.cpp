@@ -221,8 +221,24 @@ int SkBmpStandardCodec::decodeRows(const SkImageInfo& dstInfo, void* dst, size_t
     // Iterate over rows of the image
     const int height = dstInfo.height();
     for (int y = 0; y < height; y++) {
-        // Read a row of the input
-        if (this->stream()->read(this->srcBuffer(), this->srcRowBytes()) != this->srcRowBytes()) {
+        // Read a row of the input, in place if the stream is in memory
+        const uint8_t* src = this->srcBuffer();
+        size_t unreadLength;
+        const uint8_t* unread = get_unread_memory(this->stream(), &unreadLength);
+        // The swizzler reads 16 and 32 bit pixels as whole words, so those rows must be aligned.
+        // The pixel data may start at any offset, so copy them when they are not.
+        if (unread && this->bitsPerPixel() >= 16 && !SkIsAlign4((uintptr_t) unread)) {
+            unread = nullptr;
+        }
+        if (unread) {
+            if (unreadLength < this->srcRowBytes()) {
+                SkCodecPrintf("Warning: incomplete input stream.\n");
+                return y;
+            }
+            src = unread;
+            this->stream()->skip(this->srcRowBytes());
+        } else if (this->stream()->read(this->srcBuffer(), this->srcRowBytes())
+                   != this->srcRowBytes()) {
             SkCodecPrintf("Warning: incomplete input stream.\n");
             return y;
         }
@@ -234,10 +250,10 @@ int SkBmpStandardCodec::decodeRows(const SkImageInfo& dstInfo, void* dst, size_t
 
         if (this->xformOnDecode()) {
             SkASSERT(this->colorXform());
-            fSwizzler->swizzle(this->xformBuffer(), this->srcBuffer());
+            fSwizzler->swizzle(this->xformBuffer(), src);
             this->applyColorXform(dstRow, this->xformBuffer(), fSwizzler->swizzleWidth());
         } else {
-            fSwizzler->swizzle(dstRow, this->srcBuffer());
+            fSwizzler->swizzle(dstRow, src);
         }
     }
 
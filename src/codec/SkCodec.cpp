@@ -9,6 +9,7 @@
 #include "SkCodec.h"
 #include "SkCodecPriv.h"
 #include "SkColorSpace.h"
+#include "SkConvertPixels.h"
 #include "SkData.h"
 #include "SkFrameHolder.h"
 #include "SkGifCodec.h"
@@ -18,11 +19,13 @@
 #endif
 #include "SkIcoCodec.h"
 #include "SkJpegCodec.h"
+#include "SkMutex.h"
 #ifdef SK_HAS_PNG_LIBRARY
 #include "SkPngCodec.h"
 #endif
 #include "SkRawCodec.h"
 #include "SkStream.h"
+#include "SkTaskGroup.h"
 #include "SkWbmpCodec.h"
 #include "SkWebpCodec.h"
 
@@ -679,6 +682,99 @@ std::vector<SkCodec::FrameInfo> SkCodec::getFrameInfo() {
     return result;
 }
 
+SkCodec::Result SkCodec::DecodeFrames(sk_sp<SkData> data, const SkImageInfo& dstInfo,
+                                      void* const pixels[], size_t rowBytes,
+                                      int firstFrame, int frameCount, SkExecutor* executor) {
+    std::unique_ptr<SkCodec> codec = MakeFromData(data);
+    if (!codec) {
+        return kInvalidInput;
+    }
+    const int totalFrameCount = codec->getFrameCount();
+    if (firstFrame < 0 || frameCount < 0 || firstFrame > totalFrameCount - frameCount ||
+            !pixels) {
+        return kInvalidParameters;
+    }
+
+    // For each frame in the range, the earlier frame in the range that it is blended with, or
+    // kNoFrame.
+    std::vector<int> bases(frameCount, kNoFrame);
+    for (int i = 0; i < frameCount; ++i) {
+        FrameInfo info;
+        if (codec->getFrameInfo(firstFrame + i, &info) && info.fRequiredFrame >= firstFrame) {
+            bases[i] = info.fRequiredFrame - firstFrame;
+        }
+    }
+
+    std::vector<Result> results(frameCount, kInternalError);
+    auto decodeFrame = [&](SkCodec* codec, int i) {
+        Options options;
+        options.fFrameIndex = firstFrame + i;
+        const int base = bases[i];
+        if (base != kNoFrame && kSuccess == results[base] && pixels[i]) {
+            SkRectMemcpy(pixels[i], rowBytes, pixels[base], rowBytes, dstInfo.minRowBytes(),
+                         dstInfo.height());
+            options.fPriorFrame = firstFrame + base;
+        }
+        results[i] = codec->getPixels(dstInfo, pixels[i], rowBytes, &options);
+    };
+
+    if (!executor || frameCount < 2) {
+        for (int i = 0; i < frameCount; ++i) {
+            decodeFrame(codec.get(), i);
+        }
+    } else {
+        std::vector<std::vector<int>> dependents(frameCount);
+        for (int i = 0; i < frameCount; ++i) {
+            if (bases[i] != kNoFrame) {
+                dependents[bases[i]].push_back(i);
+            }
+        }
+
+        // Codecs are not thread safe, so each running task borrows one, making more as needed.
+        SkMutex codecsMutex;
+        std::vector<std::unique_ptr<SkCodec>> codecs;
+        codecs.push_back(std::move(codec));
+
+        SkTaskGroup taskGroup(*executor);
+        std::function<void(int)> decodeTask = [&](int i) {
+            std::unique_ptr<SkCodec> taskCodec;
+            {
+                SkAutoMutexAcquire lock(codecsMutex);
+                if (!codecs.empty()) {
+                    taskCodec = std::move(codecs.back());
+                    codecs.pop_back();
+                }
+            }
+            if (!taskCodec) {
+                taskCodec = MakeFromData(data);
+            }
+            if (taskCodec) {
+                decodeFrame(taskCodec.get(), i);
+                SkAutoMutexAcquire lock(codecsMutex);
+                codecs.push_back(std::move(taskCodec));
+            } else {
+                results[i] = kInternalError;
+            }
+            for (int dependent : dependents[i]) {
+                taskGroup.add([&decodeTask, dependent] { decodeTask(dependent); });
+            }
+        };
+        for (int i = 0; i < frameCount; ++i) {
+            if (bases[i] == kNoFrame) {
+                taskGroup.add([&decodeTask, i] { decodeTask(i); });
+            }
+        }
+        taskGroup.wait();
+    }
+
+    for (Result result : results) {
+        if (kSuccess != result) {
+            return result;
+        }
+    }
+    return kSuccess;
+}
+
 const char* SkCodec::ResultToString(Result result) {
     switch (result) {
         case kSuccess:
@@ -62,6 +62,19 @@ bool SkCodecImageGenerator::onGetPixels(const SkImageInfo& requestInfo, void* re
 bool SkCodecImageGenerator::onQueryYUVA8(SkYUVSizeInfo* sizeInfo,
                                          SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
                                          SkYUVColorSpace* colorSpace) const {
+    return this->onQueryScaledYUVA8(sizeInfo, yuvaIndices, colorSpace, SkYUVDecodeOptions());
+}
+
+bool SkCodecImageGenerator::onGetYUVA8Planes(const SkYUVSizeInfo& sizeInfo,
+                                             const SkYUVAIndex indices[SkYUVAIndex::kIndexCount],
+                                             void* planes[]) {
+    return this->onGetScaledYUVA8Planes(sizeInfo, indices, planes, SkYUVDecodeOptions());
+}
+
+bool SkCodecImageGenerator::onQueryScaledYUVA8(SkYUVSizeInfo* sizeInfo,
+                                               SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
+                                               SkYUVColorSpace* colorSpace,
+                                               const SkYUVDecodeOptions& options) const {
     // This image generator always returns 3 separate non-interleaved planes
     yuvaIndices[SkYUVAIndex::kY_Index].fIndex = 0;
     yuvaIndices[SkYUVAIndex::kY_Index].fChannel = SkColorChannel::kR;
@@ -72,13 +85,13 @@ bool SkCodecImageGenerator::onQueryYUVA8(SkYUVSizeInfo* sizeInfo,
     yuvaIndices[SkYUVAIndex::kA_Index].fIndex = -1;
     yuvaIndices[SkYUVAIndex::kA_Index].fChannel = SkColorChannel::kR;
 
-    return fCodec->queryYUV8(sizeInfo, colorSpace);
+    return fCodec->queryYUV8(sizeInfo, colorSpace, &options);
 }
 
-bool SkCodecImageGenerator::onGetYUVA8Planes(const SkYUVSizeInfo& sizeInfo,
-                                             const SkYUVAIndex indices[SkYUVAIndex::kIndexCount],
-                                             void* planes[]) {
-    SkCodec::Result result = fCodec->getYUV8Planes(sizeInfo, planes);
+bool SkCodecImageGenerator::onGetScaledYUVA8Planes(
+        const SkYUVSizeInfo& sizeInfo, const SkYUVAIndex indices[SkYUVAIndex::kIndexCount],
+        void* planes[], const SkYUVDecodeOptions& options) {
+    SkCodec::Result result = fCodec->getYUV8Planes(sizeInfo, planes, &options);
     // TODO: check indices
 
     switch (result) {
@@ -31,6 +31,12 @@ protected:
     bool onGetYUVA8Planes(const SkYUVSizeInfo&, const SkYUVAIndex[SkYUVAIndex::kIndexCount],
                           void* planes[]) override;
 
+    bool onQueryScaledYUVA8(SkYUVSizeInfo*, SkYUVAIndex[SkYUVAIndex::kIndexCount],
+                            SkYUVColorSpace*, const SkYUVDecodeOptions&) const override;
+
+    bool onGetScaledYUVA8Planes(const SkYUVSizeInfo&, const SkYUVAIndex[SkYUVAIndex::kIndexCount],
+                                void* planes[], const SkYUVDecodeOptions&) override;
+
 private:
     /*
      * Takes ownership of codec
@@ -13,6 +13,7 @@
 #include "SkEncodedInfo.h"
 #include "SkEncodedOrigin.h"
 #include "SkImageInfo.h"
+#include "SkStream.h"
 #include "SkTypes.h"
 
 #ifdef SK_PRINT_CODEC_MESSAGES
@@ -133,6 +134,28 @@ static inline size_t compute_row_bytes(int width, uint32_t bitsPerPixel) {
     }
 }
 
+/*
+ * If the unread bytes of the stream are in memory (e.g. an SkMemoryStream over
+ * a file mapped by SkData::MakeFromFileName), returns a pointer to them and
+ * sets *length to how many there are, so that they can be decoded in place
+ * rather than read into a buffer. Returns nullptr otherwise.
+ *
+ * Reading through the pointer does not move the stream.
+ */
+static inline const uint8_t* get_unread_memory(SkStream* stream, size_t* length) {
+    const void* base = stream->getMemoryBase();
+    if (!base || !stream->hasLength() || !stream->hasPosition()) {
+        return nullptr;
+    }
+    const size_t position = stream->getPosition();
+    const size_t streamLength = stream->getLength();
+    if (position > streamLength) {
+        return nullptr;
+    }
+    *length = streamLength - position;
+    return static_cast<const uint8_t*>(base) + position;
+}
+
 /*
  * Get a byte from a buffer
  * This method is unsafe, the caller is responsible for performing a check
@@ -10,13 +10,18 @@
 #include "SkCodec.h"
 #include "SkCodecPriv.h"
 #include "SkColorData.h"
+#include "SkExecutor.h"
 #include "SkJpegDecoderMgr.h"
 #include "SkJpegInfo.h"
 #include "SkStream.h"
+#include "SkTDArray.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 #include "SkTo.h"
 #include "SkTypes.h"
 
+#include <atomic>
+
 // stdio is needed for libjpeg-turbo
 #include <stdio.h>
 #include "SkJpegUtility.h"
@@ -569,6 +574,284 @@ static inline bool needs_swizzler_to_convert_from_cmyk(J_COLOR_SPACE jpegColorTy
     return !hasCMYKColorSpace || !hasColorSpaceXform;
 }
 
+namespace {
+
+// The layout of a baseline jpeg whose only scan is divided into restart intervals.
+struct RestartIntervals {
+    struct Interval {
+        size_t fStart;  // first byte of entropy-coded data
+        size_t fEnd;    // the RSTn or EOI marker that follows it
+    };
+
+    size_t              fHeaderSize;    // SOI through the end of the SOS segment
+    size_t              fHeightOffset;  // 16-bit image height in the SOF segment
+    SkTDArray<Interval> fIntervals;
+};
+
+}  // namespace
+
+/*
+ * Walks the markers of a sequential, Huffman coded jpeg up to its SOS, then splits the
+ * entropy-coded data at its RSTn markers.  Returns false on anything unexpected in a single-scan
+ * image, e.g. a progressive or arithmetic coded SOF, a second scan, or a missing EOI.
+ */
+static bool find_restart_intervals(const uint8_t* data, size_t size, RestartIntervals* out) {
+    if (size < 4 || 0xFF != data[0] || 0xD8 != data[1]) {
+        return false;
+    }
+
+    size_t heightOffset = 0;
+    size_t pos = 2;
+    uint8_t marker = 0;
+    while (0xDA != marker) {
+        if (pos + 4 > size || 0xFF != data[pos]) {
+            return false;
+        }
+        marker = data[pos + 1];
+        if (0xFF == marker) {
+            // Markers may be preceded by any number of fill bytes.
+            pos++;
+            continue;
+        }
+        if (0x01 == marker || (marker >= 0xD0 && marker <= 0xD9)) {
+            // TEM, RSTn, SOI and EOI have no length, and do not belong in the headers.
+            return false;
+        }
+        if (marker >= 0xC0 && marker <= 0xCF && 0xC4 != marker && 0xC8 != marker &&
+                0xCC != marker) {
+            if (0xC0 != marker && 0xC1 != marker) {
+                // Progressive, lossless, hierarchical or arithmetic coded.
+                return false;
+            }
+            heightOffset = pos + 5;
+        }
+
+        const size_t length = (data[pos + 2] << 8) | data[pos + 3];
+        if (length < 2 || pos + 2 + length > size) {
+            return false;
+        }
+        pos += 2 + length;
+    }
+
+    if (0 == heightOffset || heightOffset + 2 > pos) {
+        return false;
+    }
+    out->fHeaderSize = pos;
+    out->fHeightOffset = heightOffset;
+    out->fIntervals.reset();
+
+    size_t start = pos;
+    while (pos + 1 < size) {
+        const uint8_t* ff = (const uint8_t*) memchr(data + pos, 0xFF, size - pos - 1);
+        if (!ff) {
+            return false;
+        }
+        pos = ff - data;
+        marker = data[pos + 1];
+        if (0x00 == marker) {
+            // A stuffed zero byte: 0xFF is part of the entropy-coded data.
+            pos += 2;
+            continue;
+        }
+        if (0xFF == marker) {
+            // A fill byte.
+            pos++;
+            continue;
+        }
+
+        *out->fIntervals.append() = { start, pos };
+        if (0xD9 == marker) {
+            return true;
+        }
+        if (marker < 0xD0 || marker > 0xD7) {
+            return false;
+        }
+        pos += 2;
+        start = pos;
+    }
+    return false;
+}
+
+static size_t band_size(const RestartIntervals& intervals, int first, int end) {
+    // The headers, the entropy-coded data, and an RSTn or EOI marker after each interval.
+    size_t size = intervals.fHeaderSize + 2 * (end - first);
+    for (int i = first; i < end; i++) {
+        size += intervals.fIntervals[i].fEnd - intervals.fIntervals[i].fStart;
+    }
+    return size;
+}
+
+/*
+ * Writes a standalone jpeg holding the restart intervals [first, end): the original headers with
+ * the image height patched to height, the intervals renumbered from RST0, and an EOI.
+ */
+static void write_band(const uint8_t* data, const RestartIntervals& intervals, int first, int end,
+                       int height, uint8_t* dst) {
+    memcpy(dst, data, intervals.fHeaderSize);
+    dst[intervals.fHeightOffset]     = SkToU8(height >> 8);
+    dst[intervals.fHeightOffset + 1] = SkToU8(height & 0xFF);
+    dst += intervals.fHeaderSize;
+
+    for (int i = first; i < end; i++) {
+        const RestartIntervals::Interval& interval = intervals.fIntervals[i];
+        const size_t length = interval.fEnd - interval.fStart;
+        memcpy(dst, data + interval.fStart, length);
+        dst += length;
+        *dst++ = 0xFF;
+        *dst++ = (i + 1 < end) ? SkToU8(0xD0 + ((i - first) & 7)) : 0xD9;
+    }
+}
+
+bool SkJpegCodec::decodeRestartIntervalsInParallel(const SkImageInfo& dstInfo, void* dst,
+                                                   size_t rowBytes, const Options& options) {
+    SkASSERT(options.fExecutor && !options.fSubset);
+
+    // The bands are built from the encoded bytes, so they must all be in memory.
+    SkStream* stream = this->stream();
+    if (!stream->hasLength() || !stream->getMemoryBase()) {
+        return false;
+    }
+    const uint8_t* data = static_cast<const uint8_t*>(stream->getMemoryBase());
+
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    if (0 == dinfo->restart_interval || dinfo->progressive_mode || dinfo->arith_code ||
+            dinfo->comps_in_scan != dinfo->num_components) {
+        return false;
+    }
+
+    // A scan with a single component is not interleaved, and its MCUs are single blocks.
+    const int mcuWidth  = DCTSIZE * (1 == dinfo->comps_in_scan ? 1 : dinfo->max_h_samp_factor);
+    const int mcuHeight = DCTSIZE * (1 == dinfo->comps_in_scan ? 1 : dinfo->max_v_samp_factor);
+    const int imageHeight = SkToInt(dinfo->image_height);
+    const int mcusPerRow = SkToInt((dinfo->image_width + mcuWidth - 1) / mcuWidth);
+    const int mcuRows = (imageHeight + mcuHeight - 1) / mcuHeight;
+
+    // Bands must start on an MCU row, and on a whole output row once scaled.
+    if (0 != dinfo->restart_interval % mcusPerRow) {
+        return false;
+    }
+    const int intervalHeight = SkToInt(dinfo->restart_interval / mcusPerRow) * mcuHeight;
+    if (0 != (intervalHeight * dinfo->scale_num) % dinfo->scale_denom) {
+        return false;
+    }
+    const int scaledIntervalHeight = intervalHeight * dinfo->scale_num / dinfo->scale_denom;
+    const int intervalCount = (mcuRows * mcuHeight + intervalHeight - 1) / intervalHeight;
+
+    RestartIntervals intervals;
+    if (!find_restart_intervals(data, stream->getLength(), &intervals) ||
+            intervals.fIntervals.count() != intervalCount) {
+        return false;
+    }
+
+    // Each band also decodes the interval above and below it, so that upsampling sees the same
+    // neighboring rows that it would in a serial decode.  Keep bands big enough to amortize that.
+    constexpr int kMaxBands = 16;
+    constexpr int kMinIntervalsPerBand = 4;
+    const int bandCount = SkTMin(kMaxBands, intervalCount / kMinIntervalsPerBand);
+    if (bandCount < 2) {
+        return false;
+    }
+
+    if (needs_swizzler_to_convert_from_cmyk(dinfo->out_color_space,
+                                            this->getEncodedInfo().profile(), this->colorXform())) {
+        this->initializeSwizzler(dstInfo, options, true);
+    }
+
+    std::atomic<bool> success{true};
+    SkTaskGroup taskGroup(*options.fExecutor);
+    taskGroup.batch(bandCount, [&](int i) {
+        const int first = i * intervalCount / bandCount;
+        const int end = (i + 1) * intervalCount / bandCount;
+        const int decodeFirst = SkTMax(first - 1, 0);
+        const int decodeEnd = SkTMin(end + 1, intervalCount);
+        const int height = SkTMin(decodeEnd * intervalHeight, imageHeight)
+                         - decodeFirst * intervalHeight;
+        const int dstTop = first * scaledIntervalHeight;
+        const int dstBottom = (end == intervalCount) ? dstInfo.height()
+                                                     : end * scaledIntervalHeight;
+
+        const size_t size = band_size(intervals, decodeFirst, decodeEnd);
+        SkAutoTMalloc<uint8_t> band(size);
+        write_band(data, intervals, decodeFirst, decodeEnd, height, band.get());
+        if (!this->decodeBand(dstInfo, SkTAddOffset<void>(dst, dstTop * rowBytes), rowBytes,
+                              band.get(), size, (first - decodeFirst) * scaledIntervalHeight,
+                              dstBottom - dstTop)) {
+            success = false;
+        }
+    });
+    taskGroup.wait();
+
+    return success;
+}
+
+bool SkJpegCodec::decodeBand(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                             const uint8_t* band, size_t bandSize, int skipRows, int rowCount) {
+    SkMemoryStream stream(band, bandSize);
+    JpegDecoderMgr decoderMgr(&stream);
+
+    // Allocate before the setjmp(), so that nothing leaks if libjpeg-turbo bails out.  Decoded
+    // rows are at most four bytes per pixel, and the color xform reads 8888.
+    const int dstWidth = dstInfo.width();
+    SkAutoTMalloc<uint8_t> decodeRow(dstWidth * 4);
+    SkAutoTMalloc<uint32_t> xformRow(dstWidth);
+
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr.errorMgr());
+    if (setjmp(jmp)) {
+        return decoderMgr.returnFalse("decodeBand");
+    }
+
+    decoderMgr.init();
+    jpeg_decompress_struct* dinfo = decoderMgr.dinfo();
+    if (JPEG_HEADER_OK != jpeg_read_header(dinfo, true)) {
+        return decoderMgr.returnFalse("read_header");
+    }
+
+    // Decode exactly as the serial decode would have.
+    const jpeg_decompress_struct* srcInfo = fDecoderMgr->dinfo();
+    dinfo->out_color_space = srcInfo->out_color_space;
+    dinfo->scale_num = srcInfo->scale_num;
+    dinfo->scale_denom = srcInfo->scale_denom;
+    dinfo->dct_method = srcInfo->dct_method;
+    dinfo->do_fancy_upsampling = srcInfo->do_fancy_upsampling;
+    dinfo->dither_mode = srcInfo->dither_mode;
+    if (!jpeg_start_decompress(dinfo)) {
+        return decoderMgr.returnFalse("start_decompress");
+    }
+    if (SkToInt(dinfo->output_width) != dstWidth ||
+            SkToInt(dinfo->output_height) < skipRows + rowCount) {
+        return false;
+    }
+
+    JSAMPLE* skipDst = decodeRow.get();
+    for (int y = 0; y < skipRows; y++) {
+        if (1 != jpeg_read_scanlines(dinfo, &skipDst, 1)) {
+            return false;
+        }
+    }
+
+    // Like readRows(), but with this band's own scratch rows.
+    const bool xformFromScratch = this->colorXform() && sizeof(uint32_t) != dstInfo.bytesPerPixel();
+    const int xformWidth = fSwizzler ? fSwizzler->swizzleWidth() : dstWidth;
+    for (int y = 0; y < rowCount; y++) {
+        void* dstRow = SkTAddOffset<void>(dst, y * rowBytes);
+        uint32_t* swizzleDst = xformFromScratch ? xformRow.get() : (uint32_t*) dstRow;
+        JSAMPLE* decodeDst = fSwizzler ? decodeRow.get() : (JSAMPLE*) swizzleDst;
+        if (1 != jpeg_read_scanlines(dinfo, &decodeDst, 1)) {
+            return false;
+        }
+
+        if (fSwizzler) {
+            fSwizzler->swizzle(swizzleDst, decodeDst);
+        }
+
+        if (this->colorXform()) {
+            this->applyColorXform(dstRow, swizzleDst, xformWidth);
+        }
+    }
+
+    return true;
+}
+
 /*
  * Performs the jpeg decode
  */
@@ -581,6 +864,11 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
         return kUnimplemented;
     }
 
+    if (options.fExecutor &&
+            this->decodeRestartIntervalsInParallel(dstInfo, dst, dstRowBytes, options)) {
+        return kSuccess;
+    }
+
     // Get a pointer to the decompress info since we will use it quite frequently
     jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
 
@@ -770,9 +1058,6 @@ bool SkJpegCodec::onSkipScanlines(int count) {
 }
 
 static bool is_yuv_supported(jpeg_decompress_struct* dinfo) {
-    // Scaling is not supported in raw data mode.
-    SkASSERT(dinfo->scale_num == dinfo->scale_denom);
-
     // I can't imagine that this would ever change, but we do depend on it.
     static_assert(8 == DCTSIZE, "DCTSIZE (defined in jpeg library) should always be 8.");
 
@@ -824,16 +1109,125 @@ static bool is_yuv_supported(jpeg_decompress_struct* dinfo) {
            (4 == hSampY && 2 == vSampY);
 }
 
-bool SkJpegCodec::onQueryYUV8(SkYUVSizeInfo* sizeInfo, SkYUVColorSpace* colorSpace) const {
+static int dct_scaled_size(const jpeg_component_info& comp) {
+#if JPEG_LIB_VERSION >= 70
+    return comp.DCT_v_scaled_size;
+#else
+    return comp.DCT_scaled_size;
+#endif
+}
+
+struct SkJpegCodec::YUVLayout {
+    unsigned fScaleNum;       // The planes are scaled by fScaleNum / DCTSIZE.
+    SkISize  fPlaneSizes[3];  // The size of each whole plane.
+    size_t   fWidthBytes[3];  // The bytes libjpeg writes for each row of a whole plane.
+    int      fRowsPerIMCU[3]; // The rows of each plane that libjpeg decodes at once.
+    int      fHRatio[3];      // The width of a sample of each plane, in Y samples.
+    int      fVRatio[3];      // The height of a sample of each plane, in Y samples.
+    SkIRect  fSubsets[3];     // The part of each plane to decode.
+    bool     fIsSubset;       // Whether that is less than the whole planes.
+};
+
+bool SkJpegCodec::computeYUVLayout(const SkYUVDecodeOptions& options, YUVLayout* layout) const {
     jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
     if (!is_yuv_supported(dinfo)) {
         return false;
     }
 
-    jpeg_component_info * comp_info = dinfo->comp_info;
+    // libjpeg-turbo can scale to 1/8, 1/4, 3/8, 1/2, 5/8, 3/4, 7/8, and 1/1, in raw data mode too.
+    unsigned num = DCTSIZE;
+    if (!options.fScaledDimensions.isEmpty()) {
+        jpeg_decompress_struct fake;
+        sk_bzero(&fake, sizeof(fake));
+        fake.image_width = dinfo->image_width;
+        fake.image_height = dinfo->image_height;
+        fake.global_state = fReadyState;
+        for (;; --num) {
+            calc_output_dimensions(&fake, num, DCTSIZE);
+            if ((int) fake.output_width == options.fScaledDimensions.width() &&
+                    (int) fake.output_height == options.fScaledDimensions.height()) {
+                break;
+            }
+            if (1 == num) {
+                return false;
+            }
+        }
+    }
+
+    // Let libjpeg compute the plane sizes on a copy of dinfo, so as not to disturb the decoder.
+    // When scaling, it may pick a larger IDCT size for the chroma planes than for Y, to upsample
+    // them less.
+    jpeg_decompress_struct scaled = *dinfo;
+    jpeg_component_info comps[3];
+    memcpy(comps, dinfo->comp_info, sizeof(comps));
+    scaled.comp_info = comps;
+    scaled.global_state = fReadyState;
+    scaled.raw_data_out = TRUE;
+    scaled.scale_num = num;
+    scaled.scale_denom = DCTSIZE;
+    jpeg_calc_output_dimensions(&scaled);
+
+    layout->fScaleNum = num;
+    for (int i = 0; i < 3; ++i) {
+        layout->fPlaneSizes[i].set(comps[i].downsampled_width, comps[i].downsampled_height);
+        layout->fWidthBytes[i] = comps[i].width_in_blocks * dct_scaled_size(comps[i]);
+        layout->fRowsPerIMCU[i] = comps[i].v_samp_factor * dct_scaled_size(comps[i]);
+    }
+
+    // Each plane covers the image with samples of (hRatio x vRatio) Y samples.
+    const int yWidth = comps[0].h_samp_factor * dct_scaled_size(comps[0]);
+    const int yHeight = comps[0].v_samp_factor * dct_scaled_size(comps[0]);
+    for (int i = 0; i < 3; ++i) {
+        const int width = comps[i].h_samp_factor * dct_scaled_size(comps[i]);
+        const int height = comps[i].v_samp_factor * dct_scaled_size(comps[i]);
+        if (yWidth % width || yHeight % height) {
+            return false;
+        }
+        layout->fHRatio[i] = yWidth / width;
+        layout->fVRatio[i] = yHeight / height;
+    }
+
+    const SkIRect bounds = SkIRect::MakeSize(layout->fPlaneSizes[0]);
+    layout->fIsSubset = !options.fSubset.isEmpty() && options.fSubset != bounds;
+    if (!layout->fIsSubset) {
+        for (int i = 0; i < 3; ++i) {
+            layout->fSubsets[i] = SkIRect::MakeSize(layout->fPlaneSizes[i]);
+        }
+        return true;
+    }
+
+    const SkIRect& subset = options.fSubset;
+    if (!bounds.contains(subset)) {
+        return false;
+    }
+    // The subset has to start on a sample of every plane, or the planes would not line up.
+    for (int i = 0; i < 3; ++i) {
+        const int hRatio = layout->fHRatio[i];
+        const int vRatio = layout->fVRatio[i];
+        if (subset.left() % hRatio || subset.top() % vRatio) {
+            return false;
+        }
+        layout->fSubsets[i].setLTRB(
+                subset.left() / hRatio, subset.top() / vRatio,
+                SkTMin((subset.right() + hRatio - 1) / hRatio, layout->fPlaneSizes[i].width()),
+                SkTMin((subset.bottom() + vRatio - 1) / vRatio, layout->fPlaneSizes[i].height()));
+    }
+    return true;
+}
+
+bool SkJpegCodec::onQueryYUV8(SkYUVSizeInfo* sizeInfo, SkYUVColorSpace* colorSpace,
+                              const SkYUVDecodeOptions& options) const {
+    YUVLayout layout;
+    if (!this->computeYUVLayout(options, &layout)) {
+        return false;
+    }
+
     for (int i = 0; i < 3; ++i) {
-        sizeInfo->fSizes[i].set(comp_info[i].downsampled_width, comp_info[i].downsampled_height);
-        sizeInfo->fWidthBytes[i] = comp_info[i].width_in_blocks * DCTSIZE;
+        sizeInfo->fSizes[i] = layout.fSubsets[i].size();
+        // Whole planes are decoded in place, so their rows must fit whole blocks.  Subsets are
+        // copied out of a scratch buffer.
+        sizeInfo->fWidthBytes[i] = layout.fIsSubset ? layout.fSubsets[i].width()
+                                                    : layout.fWidthBytes[i];
     }
 
     // JPEG never has an alpha channel
@@ -846,12 +1240,37 @@ bool SkJpegCodec::onQueryYUV8(SkYUVSizeInfo* sizeInfo, SkYUVColorSpace* colorSpa
     return true;
 }
 
+bool SkJpegCodec::onGetValidYUV8Subset(const SkISize& scaledDimensions,
+                                       SkIRect* desiredSubset) const {
+    SkYUVDecodeOptions options;
+    options.fScaledDimensions = scaledDimensions;
+    YUVLayout layout;
+    if (!desiredSubset || !this->computeYUVLayout(options, &layout) ||
+            !SkIRect::MakeSize(layout.fPlaneSizes[0]).contains(*desiredSubset)) {
+        return false;
+    }
+
+    // Move the top left corner to the start of a sample of every plane.
+    int hRatio = 1, vRatio = 1;
+    for (int i = 1; i < 3; ++i) {
+        hRatio = SkTMax(hRatio, layout.fHRatio[i]);
+        vRatio = SkTMax(vRatio, layout.fVRatio[i]);
+    }
+    desiredSubset->fLeft -= desiredSubset->fLeft % hRatio;
+    desiredSubset->fTop -= desiredSubset->fTop % vRatio;
+    options.fSubset = *desiredSubset;
+    return this->computeYUVLayout(options, &layout);
+}
+
 SkCodec::Result SkJpegCodec::onGetYUV8Planes(const SkYUVSizeInfo& sizeInfo,
-                                             void* planes[SkYUVSizeInfo::kMaxCount]) {
+                                             void* planes[SkYUVSizeInfo::kMaxCount],
+                                             const SkYUVDecodeOptions& options) {
     SkYUVSizeInfo defaultInfo;
 
     // This will check is_yuv_supported(), so we don't need to here.
-    bool supportsYUV = this->onQueryYUV8(&defaultInfo, nullptr);
+    YUVLayout layout;
+    bool supportsYUV = this->computeYUVLayout(options, &layout) &&
+                       this->onQueryYUV8(&defaultInfo, nullptr, options);
     if (!supportsYUV ||
             sizeInfo.fSizes[0] != defaultInfo.fSizes[0] ||
             sizeInfo.fSizes[1] != defaultInfo.fSizes[1] ||
@@ -872,6 +1291,8 @@ SkCodec::Result SkJpegCodec::onGetYUV8Planes(const SkYUVSizeInfo& sizeInfo,
     jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
 
     dinfo->raw_data_out = TRUE;
+    dinfo->scale_num = layout.fScaleNum;
+    dinfo->scale_denom = DCTSIZE;
     if (!jpeg_start_decompress(dinfo)) {
         return fDecoderMgr->returnFailure("startDecompress", kInvalidInput);
     }
@@ -881,11 +1302,13 @@ SkCodec::Result SkJpegCodec::onGetYUV8Planes(const SkYUVSizeInfo& sizeInfo,
     // was caused by a bug in the old code, but we'll be safe and check here.
     SkASSERT(is_yuv_supported(dinfo));
 
-    // Currently, we require that the Y plane dimensions match the image dimensions
-    // and that the U and V planes are the same dimensions.
-    SkASSERT(sizeInfo.fSizes[1] == sizeInfo.fSizes[2]);
-    SkASSERT((uint32_t) sizeInfo.fSizes[0].width() == dinfo->output_width &&
-             (uint32_t) sizeInfo.fSizes[0].height() == dinfo->output_height);
+    // The Y plane is the size of the (scaled) image.
+    SkASSERT((uint32_t) layout.fPlaneSizes[0].width() == dinfo->output_width &&
+             (uint32_t) layout.fPlaneSizes[0].height() == dinfo->output_height);
+    for (int i = 0; i < 3; ++i) {
+        SkASSERT(layout.fRowsPerIMCU[i] ==
+                 dinfo->comp_info[i].v_samp_factor * dct_scaled_size(dinfo->comp_info[i]));
+    }
 
     // Build a JSAMPIMAGE to handle output from libjpeg-turbo.  A JSAMPIMAGE has
     // a 2-D array of pixels for each of the components (Y, U, V) in the image.
@@ -898,13 +1321,66 @@ SkCodec::Result SkJpegCodec::onGetYUV8Planes(const SkYUVSizeInfo& sizeInfo,
     yuv[0] = &rowptrs[0];           // Y rows (DCTSIZE or 2 * DCTSIZE)
     yuv[1] = &rowptrs[2 * DCTSIZE]; // U rows (DCTSIZE)
     yuv[2] = &rowptrs[3 * DCTSIZE]; // V rows (DCTSIZE)
+    SkASSERT(layout.fRowsPerIMCU[0] <= 2 * DCTSIZE &&
+             layout.fRowsPerIMCU[1] <= DCTSIZE &&
+             layout.fRowsPerIMCU[2] <= DCTSIZE);
+
+    const uint32_t numRowsPerBlock = layout.fRowsPerIMCU[0];
+
+    if (layout.fIsSubset) {
+        // Decode each row of blocks into scratch rows, and copy out the part of the subset in
+        // it.  Decoding can stop after the last row of blocks that the subset touches.
+        size_t scratchBytes = 0;
+        for (int i = 0; i < 3; ++i) {
+            scratchBytes += layout.fRowsPerIMCU[i] * layout.fWidthBytes[i];
+        }
+        SkAutoTMalloc<JSAMPLE> scratch(scratchBytes);
+        JSAMPLE* scratchPlanes[3];
+        JSAMPLE* next = scratch.get();
+        for (int i = 0; i < 3; ++i) {
+            scratchPlanes[i] = next;
+            for (int row = 0; row < layout.fRowsPerIMCU[i]; ++row) {
+                yuv[i][row] = next;
+                next += layout.fWidthBytes[i];
+            }
+        }
+
+        const int numIters = (layout.fSubsets[0].bottom() + numRowsPerBlock - 1) /
+                             numRowsPerBlock;
+        for (int iter = 0; iter < numIters; iter++) {
+            const uint32_t neededRows = SkTMin(numRowsPerBlock,
+                                               dinfo->output_height - dinfo->output_scanline);
+            JDIMENSION linesRead = jpeg_read_raw_data(dinfo, yuv, numRowsPerBlock);
+            if (linesRead < neededRows) {
+                // FIXME: Handle incomplete YUV decodes without signalling an error.
+                return kInvalidInput;
+            }
+
+            for (int i = 0; i < 3; ++i) {
+                const SkIRect& subset = layout.fSubsets[i];
+                const int firstRow = iter * layout.fRowsPerIMCU[i];
+                const int top = SkTMax(subset.top(), firstRow);
+                const int bottom = SkTMin(subset.bottom(), firstRow + layout.fRowsPerIMCU[i]);
+                for (int row = top; row < bottom; ++row) {
+                    memcpy(SkTAddOffset<void>(planes[i],
+                                              (row - subset.top()) * sizeInfo.fWidthBytes[i]),
+                           scratchPlanes[i] + (row - firstRow) * layout.fWidthBytes[i] +
+                                   subset.left(),
+                           subset.width());
+                }
+            }
+        }
+        return kSuccess;
+    }
 
     // Initialize rowptrs.
-    int numYRowsPerBlock = DCTSIZE * dinfo->comp_info[0].v_samp_factor;
+    int numYRowsPerBlock = layout.fRowsPerIMCU[0];
+    int numUVRowsPerBlock = layout.fRowsPerIMCU[1];
+    SkASSERT(layout.fRowsPerIMCU[2] == numUVRowsPerBlock);
     for (int i = 0; i < numYRowsPerBlock; i++) {
         rowptrs[i] = SkTAddOffset<JSAMPLE>(planes[0], i * sizeInfo.fWidthBytes[0]);
     }
-    for (int i = 0; i < DCTSIZE; i++) {
+    for (int i = 0; i < numUVRowsPerBlock; i++) {
         rowptrs[i + 2 * DCTSIZE] =
             SkTAddOffset<JSAMPLE>(planes[1], i * sizeInfo.fWidthBytes[1]);
         rowptrs[i + 3 * DCTSIZE] =
@@ -913,10 +1389,8 @@ SkCodec::Result SkJpegCodec::onGetYUV8Planes(const SkYUVSizeInfo& sizeInfo,
 
     // After each loop iteration, we will increment pointers to Y, U, and V.
     size_t blockIncrementY = numYRowsPerBlock * sizeInfo.fWidthBytes[0];
-    size_t blockIncrementU = DCTSIZE * sizeInfo.fWidthBytes[1];
-    size_t blockIncrementV = DCTSIZE * sizeInfo.fWidthBytes[2];
-
-    uint32_t numRowsPerBlock = numYRowsPerBlock;
+    size_t blockIncrementU = numUVRowsPerBlock * sizeInfo.fWidthBytes[1];
+    size_t blockIncrementV = numUVRowsPerBlock * sizeInfo.fWidthBytes[2];
 
     // We intentionally round down here, as this first loop will only handle
     // full block rows.  As a special case at the end, we will handle any
@@ -933,7 +1407,7 @@ SkCodec::Result SkJpegCodec::onGetYUV8Planes(const SkYUVSizeInfo& sizeInfo,
         for (int i = 0; i < numYRowsPerBlock; i++) {
             rowptrs[i] += blockIncrementY;
         }
-        for (int i = 0; i < DCTSIZE; i++) {
+        for (int i = 0; i < numUVRowsPerBlock; i++) {
             rowptrs[i + 2 * DCTSIZE] += blockIncrementU;
             rowptrs[i + 3 * DCTSIZE] += blockIncrementV;
         }
@@ -947,12 +1421,15 @@ SkCodec::Result SkJpegCodec::onGetYUV8Planes(const SkYUVSizeInfo& sizeInfo,
         // this requirement using a dummy row buffer.
         // FIXME: Should SkCodec have an extra memory buffer that can be shared among
         //        all of the implementations that use temporary/garbage memory?
-        SkAutoTMalloc<JSAMPLE> dummyRow(sizeInfo.fWidthBytes[SkYUVAIndex::kY_Index]);
+        // When scaling, a chroma row may be wider than a Y row.
+        SkAutoTMalloc<JSAMPLE> dummyRow(SkTMax(sizeInfo.fWidthBytes[0],
+                                               SkTMax(sizeInfo.fWidthBytes[1],
+                                                      sizeInfo.fWidthBytes[2])));
         for (int i = remainingRows; i < numYRowsPerBlock; i++) {
             rowptrs[i] = dummyRow.get();
         }
-        int remainingUVRows = dinfo->comp_info[1].downsampled_height - DCTSIZE * numIters;
-        for (int i = remainingUVRows; i < DCTSIZE; i++) {
+        int remainingUVRows = layout.fPlaneSizes[1].height() - numUVRowsPerBlock * numIters;
+        for (int i = remainingUVRows; i < numUVRowsPerBlock; i++) {
             rowptrs[i + 2 * DCTSIZE] = dummyRow.get();
             rowptrs[i + 3 * DCTSIZE] = dummyRow.get();
         }
@@ -44,10 +44,15 @@ protected:
     Result onGetPixels(const SkImageInfo& dstInfo, void* dst, size_t dstRowBytes, const Options&,
             int*) override;
 
-    bool onQueryYUV8(SkYUVSizeInfo* sizeInfo, SkYUVColorSpace* colorSpace) const override;
+    bool onQueryYUV8(SkYUVSizeInfo* sizeInfo, SkYUVColorSpace* colorSpace,
+                     const SkYUVDecodeOptions&) const override;
 
     Result onGetYUV8Planes(const SkYUVSizeInfo& sizeInfo,
-                           void* planes[SkYUVSizeInfo::kMaxCount]) override;
+                           void* planes[SkYUVSizeInfo::kMaxCount],
+                           const SkYUVDecodeOptions&) override;
+
+    bool onGetValidYUV8Subset(const SkISize& scaledDimensions,
+                              SkIRect* desiredSubset) const override;
 
     SkEncodedImageFormat onGetEncodedFormat() const override {
         return SkEncodedImageFormat::kJPEG;
@@ -104,11 +109,40 @@ private:
     SkJpegCodec(SkEncodedInfo&& info, std::unique_ptr<SkStream> stream,
             JpegDecoderMgr* decoderMgr, SkEncodedOrigin origin);
 
+    /*
+     * How the Y, U and V planes come out of a raw data decode with the given options.
+     */
+    struct YUVLayout;
+
+    /*
+     * Returns false if the YUV planes can not be decoded with these options.
+     */
+    bool computeYUVLayout(const SkYUVDecodeOptions&, YUVLayout*) const;
+
     void initializeSwizzler(const SkImageInfo& dstInfo, const Options& options,
                             bool needsCMYKToRGB);
     void allocateStorage(const SkImageInfo& dstInfo);
     int readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count, const Options&);
 
+    /*
+     * Decodes a baseline image whose entropy-coded data is divided into restart intervals by
+     * splitting it into bands of intervals and decoding the bands concurrently on
+     * options.fExecutor, straight into dst.
+     *
+     * Returns false if the image is not suitable or a band fails to decode.  fDecoderMgr is left
+     * untouched either way, so the caller can fall back to a serial decode.
+     */
+    bool decodeRestartIntervalsInParallel(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                                          const Options&);
+
+    /*
+     * Decodes one band, a standalone jpeg built by decodeRestartIntervalsInParallel(), with its
+     * own decompress struct.  The first skipRows rows are discarded (they only provide upsampling
+     * context), and the next rowCount rows are written to dst.
+     */
+    bool decodeBand(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, const uint8_t* band,
+                    size_t bandSize, int skipRows, int rowCount);
+
     /*
      * Scanline decoding.
      */
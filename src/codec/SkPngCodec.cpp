@@ -131,6 +131,16 @@ static inline bool is_chunk(const png_byte* chunk, const char* tag) {
 
 static inline bool process_data(png_structp png_ptr, png_infop info_ptr,
         SkStream* stream, void* buffer, size_t bufferSize, size_t length) {
+    size_t unreadLength;
+    if (const uint8_t* unread = get_unread_memory(stream, &unreadLength)) {
+        // Hand libpng the bytes where they are (libpng only reads them). Skip them
+        // first, since png_process_data may longjmp out, as it would after a read().
+        const size_t bytesToProcess = std::min(unreadLength, length);
+        stream->skip(bytesToProcess);
+        png_process_data(png_ptr, info_ptr, const_cast<png_bytep>(unread), bytesToProcess);
+        return bytesToProcess == length;
+    }
+
     while (length > 0) {
         const size_t bytesToProcess = std::min(bufferSize, length);
         const size_t bytesRead = stream->read(buffer, bytesToProcess);
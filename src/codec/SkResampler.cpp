@@ -0,0 +1,167 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkResampler.h"
+
+#include "SkNx.h"
+#include "SkTo.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Weights are fixed point, with this many fractional bits. They sum to 1 for each pixel.
+static constexpr int kWeightShift = 14;
+
+static double lanczos3(double x) {
+    x = std::abs(x);
+    if (x >= 3) {
+        return 0;
+    }
+    if (x < 1e-9) {
+        return 1;
+    }
+    const double px = 3.14159265358979323846 * x;
+    return 3 * std::sin(px) * std::sin(px / 3) / (px * px);
+}
+
+void SkResampler::ComputeTaps(Filter filter, int srcLength, int dstLength,
+                              std::vector<Taps>* tapsArray, std::vector<int32_t>* weights) {
+    // Pixel i of dst is centered on (i + 0.5) * scale in src, where pixel j covers [j, j + 1).
+    // When shrinking, the filter is stretched to cover as many src pixels as a dst pixel does.
+    const double scale = (double) srcLength / dstLength;
+    const double filterScale = std::max(1.0, scale);
+    const double radius = (Filter::kBox == filter ? 0.5 : 3.0) * filterScale;
+
+    std::vector<double> real;
+    tapsArray->resize(dstLength);
+    for (int i = 0; i < dstLength; i++) {
+        const double center = (i + 0.5) * scale;
+        // Pixels past the edges are left out, and the rest weighted up to make up for them.
+        const int first = SkTMax(0, (int) std::floor(center - radius));
+        const int end = SkTMin(srcLength, (int) std::ceil(center + radius));
+
+        real.clear();
+        double sum = 0;
+        for (int j = first; j < end; j++) {
+            double w;
+            if (Filter::kBox == filter) {
+                w = SkTMax(0.0, SkTMin(j + 1.0, center + radius) - SkTMax((double) j,
+                                                                            center - radius));
+            } else {
+                w = lanczos3((j + 0.5 - center) / filterScale);
+            }
+            real.push_back(w);
+            sum += w;
+        }
+
+        Taps& taps = (*tapsArray)[i];
+        taps.fOffset = SkToInt(weights->size());
+        if (sum <= 0) {
+            // Only possible for a tiny window at an edge; use the nearest pixel.
+            taps.fFirst = SkTPin((int) center, 0, srcLength - 1);
+            taps.fCount = 1;
+            weights->push_back(1 << kWeightShift);
+            continue;
+        }
+
+        // Convert to fixed point, leaving out weights that round to zero at either end, and
+        // give whatever rounding lost or gained to the largest weight.
+        int lo = 0,
+            hi = SkToInt(real.size());
+        auto fixed = [&](int k) {
+            return (int32_t) std::lround(real[k] / sum * (1 << kWeightShift));
+        };
+        while (lo < hi - 1 && 0 == fixed(lo)) { lo++; }
+        while (hi - 1 > lo && 0 == fixed(hi - 1)) { hi--; }
+
+        taps.fFirst = first + lo;
+        taps.fCount = hi - lo;
+        int32_t total = 0;
+        int largest = lo;
+        for (int k = lo; k < hi; k++) {
+            const int32_t w = fixed(k);
+            if (w > fixed(largest)) {
+                largest = k;
+            }
+            weights->push_back(w);
+            total += w;
+        }
+        (*weights)[taps.fOffset + largest - lo] += (1 << kWeightShift) - total;
+    }
+}
+
+SkResampler::SkResampler(Filter filter, int srcWidth, int srcHeight, int dstWidth, int dstHeight)
+    : fSrcWidth(srcWidth)
+    , fSrcHeight(srcHeight)
+    , fDstWidth(dstWidth)
+    , fSrcRowsAdded(0)
+{
+    SkASSERT(srcWidth > 0 && srcHeight > 0 && dstWidth > 0 && dstHeight > 0);
+    ComputeTaps(filter, srcWidth, dstWidth, &fColumnTaps, &fColumnWeights);
+    ComputeTaps(filter, srcHeight, dstHeight, &fRowTaps, &fRowWeights);
+
+    // Every dst row is made from source rows that are still in the ring, as long as it holds
+    // as many as the widest span. Both ends of the spans only move down.
+    fRowCount = 1;
+    for (const Taps& taps : fRowTaps) {
+        fRowCount = SkTMax(fRowCount, taps.fCount);
+    }
+    fRows.reset(SkToSizeT(fRowCount) * dstWidth * 4);
+}
+
+static inline Sk4i load_pixel(const uint8_t* src) {
+    return SkNx_cast<int32_t>(Sk4b::Load(src));
+}
+
+// Rounds away the fraction bits, then clamps to [0, 255] and each color to alpha. Lanczos can
+// overshoot either way around edges.
+static inline void store_pixel(uint8_t* dst, const Sk4i& sum) {
+    Sk4i v = (sum + Sk4i(1 << (kWeightShift - 1))) >> kWeightShift;
+    v = Sk4i::Max(Sk4i(0), Sk4i::Min(v, Sk4i(255)));
+    const int32_t a = v[3];
+    v = Sk4i::Min(v, Sk4i(a, a, a, 255));
+    SkNx_cast<uint8_t>(v).store(dst);
+}
+
+void SkResampler::addRow(const void* src) {
+    SkASSERT(fSrcRowsAdded < fSrcHeight);
+    const uint8_t* srcRow = static_cast<const uint8_t*>(src);
+    uint8_t* dst = this->filteredRow(fSrcRowsAdded);
+    for (int x = 0; x < fDstWidth; x++) {
+        const Taps& taps = fColumnTaps[x];
+        const int32_t* weights = &fColumnWeights[taps.fOffset];
+        const uint8_t* pixel = srcRow + taps.fFirst * 4;
+        Sk4i sum(0);
+        for (int k = 0; k < taps.fCount; k++) {
+            sum = sum + load_pixel(pixel + k * 4) * Sk4i(weights[k]);
+        }
+        store_pixel(dst + x * 4, sum);
+    }
+    fSrcRowsAdded++;
+}
+
+void SkResampler::makeRow(int dstY, void* dst) const {
+    const Taps& taps = fRowTaps[dstY];
+    SkASSERT(fSrcRowsAdded >= taps.fFirst + taps.fCount);
+    SkASSERT(fSrcRowsAdded - fRowCount <= taps.fFirst);
+    const int32_t* weights = &fRowWeights[taps.fOffset];
+
+    // Find the rows once, rather than once per pixel.
+    SkAutoSTMalloc<16, const uint8_t*> rows(taps.fCount);
+    for (int k = 0; k < taps.fCount; k++) {
+        rows[k] = this->filteredRow(taps.fFirst + k);
+    }
+
+    uint8_t* dstRow = static_cast<uint8_t*>(dst);
+    for (int x = 0; x < fDstWidth; x++) {
+        Sk4i sum(0);
+        for (int k = 0; k < taps.fCount; k++) {
+            sum = sum + load_pixel(rows[k] + x * 4) * Sk4i(weights[k]);
+        }
+        store_pixel(dstRow + x * 4, sum);
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#ifndef SkResampler_DEFINED
+#define SkResampler_DEFINED
+
+#include "SkNoncopyable.h"
+#include "SkTemplates.h"
+#include "SkTypes.h"
+
+#include <vector>
+
+/**
+ *  Resizes an image of 32 bit pixels, with alpha in the last byte, using a
+ *  separable filter, while its rows arrive one at a time from top to bottom.
+ *
+ *  Each source row is filtered horizontally as it is added. Only as many of
+ *  those rows are kept as the vertical filter spans, so an image can be
+ *  resized straight out of a scanline decoder without ever holding all of it.
+ */
+class SkResampler : SkNoncopyable {
+public:
+    enum class Filter {
+        kBox,       // Averages the source pixels that each destination pixel covers.
+        kLanczos3,  // Sharper, with a support three destination pixels wide on each side.
+    };
+
+    /**
+     *  Results are clamped so that no color exceeds alpha. That is right for
+     *  premultiplied and opaque pixels, which are the ones this supports.
+     */
+    SkResampler(Filter, int srcWidth, int srcHeight, int dstWidth, int dstHeight);
+
+    int srcWidth() const { return fSrcWidth; }
+    int srcHeight() const { return fSrcHeight; }
+
+    /**
+     *  The number of source rows that must have been added before
+     *  makeRow(dstY) can be called.
+     */
+    int srcRowsNeeded(int dstY) const {
+        const Taps& taps = fRowTaps[dstY];
+        return taps.fFirst + taps.fCount;
+    }
+
+    int srcRowsAdded() const { return fSrcRowsAdded; }
+
+    /**
+     *  Adds the next source row, srcWidth() pixels.
+     */
+    void addRow(const void* src);
+
+    /**
+     *  Writes row dstY of the destination. Rows must be made in order,
+     *  each once srcRowsNeeded(dstY) source rows have been added.
+     */
+    void makeRow(int dstY, void* dst) const;
+
+private:
+    // The source pixels, fFirst to fFirst + fCount, and their weights, from
+    // fWeights[fOffset], that make up one destination pixel or row.
+    struct Taps {
+        int fFirst;
+        int fCount;
+        int fOffset;
+    };
+
+    static void ComputeTaps(Filter, int srcLength, int dstLength,
+                            std::vector<Taps>*, std::vector<int32_t>* weights);
+
+    uint8_t* filteredRow(int srcY) const {
+        return fRows.get() + (srcY % fRowCount) * fDstWidth * 4;
+    }
+
+    const int              fSrcWidth;
+    const int              fSrcHeight;
+    const int              fDstWidth;
+    std::vector<Taps>      fColumnTaps;
+    std::vector<int32_t>   fColumnWeights;
+    std::vector<Taps>      fRowTaps;
+    std::vector<int32_t>   fRowWeights;
+
+    // A ring of the last fRowCount source rows, filtered horizontally.
+    int                    fRowCount;
+    SkAutoTMalloc<uint8_t> fRows;
+    int                    fSrcRowsAdded;
+};
+
+#endif // SkResampler_DEFINED
@@ -9,10 +9,13 @@
 #include "SkCodecPriv.h"
 #include "SkMath.h"
 #include "SkMathPriv.h"
+#include "SkResampler.h"
 #include "SkSampledCodec.h"
 #include "SkSampler.h"
 #include "SkTemplates.h"
 
+#include <functional>
+
 SkSampledCodec::SkSampledCodec(SkCodec* codec, ExifOrientationBehavior behavior)
     : INHERITED(codec, behavior)
 {}
@@ -73,6 +76,10 @@ SkISize SkSampledCodec::onGetSampledDimensions(int sampleSize) const {
 
 SkCodec::Result SkSampledCodec::onGetAndroidPixels(const SkImageInfo& info, void* pixels,
         size_t rowBytes, const AndroidOptions& options) {
+    if (kNone_SkFilterQuality != options.fFilterQuality) {
+        return this->filteredDecode(info, pixels, rowBytes, options);
+    }
+
     // Create an Options struct for the codec.
     SkCodec::Options codecOptions;
     codecOptions.fZeroInitialized = options.fZeroInitialized;
@@ -345,3 +352,108 @@ SkCodec::Result SkSampledCodec::sampledDecode(const SkImageInfo& info, void* pix
             return SkCodec::kUnimplemented;
     }
 }
+
+SkCodec::Result SkSampledCodec::filteredDecode(const SkImageInfo& info, void* pixels,
+        size_t rowBytes, const AndroidOptions& options) {
+    // SkResampler works on 32 bit pixels whose colors do not exceed their alpha.
+    if (kRGBA_8888_SkColorType != info.colorType() && kBGRA_8888_SkColorType != info.colorType()) {
+        return SkCodec::kInvalidConversion;
+    }
+    if (kUnpremul_SkAlphaType == info.alphaType() && !this->codec()->getInfo().isOpaque()) {
+        return SkCodec::kInvalidConversion;
+    }
+
+    const SkISize dimensions = this->codec()->dimensions();
+    const SkIRect subset = options.fSubset ? *options.fSubset : SkIRect::MakeSize(dimensions);
+
+    // Let the codec shrink the image as far as it can while it stays at least as large as info.
+    int nativeSampleSize = 1;
+    SkISize nativeSize = dimensions;
+    for (int sampleSize : { 8, 4, 2 }) {
+        const SkISize size = this->codec()->getScaledDimensions(
+                get_scale_from_sample_size(sampleSize));
+        if (size != dimensions
+                && get_scaled_dimension(subset.width(), sampleSize) >= info.width()
+                && get_scaled_dimension(subset.height(), sampleSize) >= info.height()) {
+            nativeSampleSize = sampleSize;
+            nativeSize = size;
+            break;
+        }
+    }
+
+    SkIRect nativeSubset = SkIRect::MakeXYWH(
+            subset.x() / nativeSampleSize, subset.y() / nativeSampleSize,
+            get_scaled_dimension(subset.width(), nativeSampleSize),
+            get_scaled_dimension(subset.height(), nativeSampleSize));
+    if (!nativeSubset.intersect(SkIRect::MakeSize(nativeSize))) {
+        return SkCodec::kInvalidParameters;
+    }
+
+    const SkResampler::Filter filter = kHigh_SkFilterQuality == options.fFilterQuality
+                                     ? SkResampler::Filter::kLanczos3
+                                     : SkResampler::Filter::kBox;
+    SkResampler resampler(filter, nativeSubset.width(), nativeSubset.height(),
+                          info.width(), info.height());
+
+    // Makes every row of pixels, adding each source row, from srcRow(), as it is needed.
+    auto resample = [&](const std::function<const uint8_t*()>& srcRow) {
+        for (int y = 0; y < info.height(); y++) {
+            while (resampler.srcRowsAdded() < resampler.srcRowsNeeded(y)) {
+                resampler.addRow(srcRow() + nativeSubset.x() * 4);
+            }
+            resampler.makeRow(y, SkTAddOffset<void>(pixels, y * rowBytes));
+        }
+    };
+
+    const SkImageInfo nativeInfo = info.makeWH(nativeSize.width(), nativeSize.height());
+    const size_t nativeRowBytes = nativeInfo.minRowBytes();
+    SkCodec::Options codecOptions;
+
+    // Stream the rows out of a scanline decoder, if there is one.
+    SkCodec::Result result = this->codec()->startScanlineDecode(nativeInfo, &codecOptions);
+    if (SkCodec::kSuccess == result
+            && SkCodec::kTopDown_SkScanlineOrder == this->codec()->getScanlineOrder()) {
+        SkAutoTMalloc<uint8_t> row(nativeRowBytes);
+        bool complete = this->codec()->skipScanlines(nativeSubset.y());
+        if (!complete) {
+            SkSampler::Fill(nativeInfo.makeWH(nativeSize.width(), 1), row.get(), nativeRowBytes,
+                            SkCodec::kNo_ZeroInitialized);
+        }
+        resample([&]() {
+            // When the input runs out, the codec fills in the row it could not decode, and
+            // that row stands in for the rest.
+            if (complete && 1 != this->codec()->getScanlines(row.get(), 1, nativeRowBytes)) {
+                complete = false;
+            }
+            return row.get();
+        });
+        return complete ? SkCodec::kSuccess : SkCodec::kIncompleteInput;
+    }
+    if (SkCodec::kSuccess != result && SkCodec::kUnimplemented != result) {
+        return result;
+    }
+
+    // Otherwise decode the whole image, and filter that.
+    const size_t nativeByteSize = nativeInfo.computeByteSize(nativeRowBytes);
+    if (SkImageInfo::ByteSizeOverflowed(nativeByteSize)) {
+        return SkCodec::kInternalError;
+    }
+    SkAutoTMalloc<uint8_t> decoded(nativeByteSize);
+    result = this->codec()->getPixels(nativeInfo, decoded.get(), nativeRowBytes, &codecOptions);
+    switch (result) {
+        case SkCodec::kSuccess:
+        case SkCodec::kIncompleteInput:
+        case SkCodec::kErrorInInput:
+            break;
+        default:
+            return result;
+    }
+
+    const uint8_t* decodedRow = decoded.get() + nativeSubset.y() * nativeRowBytes;
+    resample([&]() {
+        const uint8_t* row = decodedRow;
+        decodedRow += nativeRowBytes;
+        return row;
+    });
+    return result;
+}
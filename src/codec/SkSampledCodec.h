@@ -54,6 +54,14 @@ private:
     SkCodec::Result sampledDecode(const SkImageInfo& info, void* pixels, size_t rowBytes,
             const AndroidOptions& options);
 
+    /**
+     *  This fulfills the same contract as onGetAndroidPixels(), when
+     *  options.fFilterQuality asks for the image to be filtered to the size of
+     *  info rather than sampled.
+     */
+    SkCodec::Result filteredDecode(const SkImageInfo& info, void* pixels, size_t rowBytes,
+            const AndroidOptions& options);
+
     typedef SkAndroidCodec INHERITED;
 };
 #endif // SkSampledCodec_DEFINED
@@ -7,13 +7,18 @@
 
 #include "SkStreamBuffer.h"
 
+#include "SkCodecPriv.h"
+
 SkStreamBuffer::SkStreamBuffer(std::unique_ptr<SkStream> stream)
     : fStream(std::move(stream))
     , fPosition(0)
     , fBytesBuffered(0)
     , fHasLengthAndPosition(fStream->hasLength() && fStream->hasPosition())
     , fTrulyBuffered(0)
-{}
+    , fMemoryLength(0)
+{
+    fMemory = reinterpret_cast<const char*>(get_unread_memory(fStream.get(), &fMemoryLength));
+}
 
 SkStreamBuffer::~SkStreamBuffer() {
     fMarkedData.foreach([](size_t, SkData** data) { (*data)->unref(); });
@@ -21,6 +26,9 @@ SkStreamBuffer::~SkStreamBuffer() {
 
 const char* SkStreamBuffer::get() const {
     SkASSERT(fBytesBuffered >= 1);
+    if (fMemory) {
+        return fMemory + fPosition;
+    }
     if (fHasLengthAndPosition && fTrulyBuffered < fBytesBuffered) {
         const size_t bytesToBuffer = fBytesBuffered - fTrulyBuffered;
         char* dst = SkTAddOffset<char>(const_cast<char*>(fBuffer), fTrulyBuffered);
@@ -43,7 +51,9 @@ bool SkStreamBuffer::buffer(size_t totalBytesToBuffer) {
         return true;
     }
 
-    if (fHasLengthAndPosition) {
+    if (fMemory) {
+        fBytesBuffered = SkTMin(fMemoryLength - fPosition, totalBytesToBuffer);
+    } else if (fHasLengthAndPosition) {
         const size_t remaining = fStream->getLength() - fStream->getPosition() + fTrulyBuffered;
         fBytesBuffered = SkTMin(remaining, totalBytesToBuffer);
     } else {
@@ -72,6 +82,11 @@ sk_sp<SkData> SkStreamBuffer::getDataAtPosition(size_t position, size_t length)
         return sk_ref_sp<SkData>(*data);
     }
 
+    if (fMemory) {
+        SkASSERT(length <= fMemoryLength && position <= fMemoryLength - length);
+        return SkData::MakeWithoutCopy(fMemory + position, length);
+    }
+
     SkASSERT(length <= fStream->getLength() &&
              position <= fStream->getLength() - length);
 
@@ -30,6 +30,9 @@ public:
     /**
      *  Return a pointer the buffered data.
      *
+     *  If the stream's bytes are in memory, this points into that memory rather
+     *  than to a copy.
+     *
      *  The number of bytes buffered is the number passed to buffer()
      *  after the last call to flush().
      */
@@ -82,7 +85,9 @@ public:
      *
      *  @param position Position to retrieve data, as marked by markPosition().
      *  @param length   Amount of data required at position.
-     *  @return SkData The data at position.
+     *  @return SkData The data at position. If the stream's bytes are in
+     *      memory, this refers to them without a copy, and must not outlive
+     *      the SkStreamBuffer.
      */
     sk_sp<SkData> getDataAtPosition(size_t position, size_t length);
 
@@ -108,6 +113,10 @@ private:
     // The second call to get() needs to only truly buffer the part that was
     // not already buffered.
     mutable size_t              fTrulyBuffered;
+    // If the unread bytes of the stream were in memory when we were created,
+    // they are read in place. The stream is still moved past them by flush().
+    const char*                 fMemory;
+    size_t                      fMemoryLength;
     // Only used if !fHasLengthAndPosition. In that case, markPosition will
     // copy into an SkData, stored here.
     SkTHashMap<size_t, SkData*> fMarkedData;
@@ -142,6 +142,7 @@ private:
     friend class SkDrawIter;
     friend class SkDrawTiler;
     friend class SkSurface_Raster;
+    friend class SkThreadedBMPDevice; // to copy fRCStack
 
     class BDDraw;
 
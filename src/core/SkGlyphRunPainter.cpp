@@ -158,10 +158,11 @@ void SkGlyphRunListPainter::drawGlyphRunAsSubpixelMask(
 
                 SkMask mask;
                 if (prepare_mask(cache, glyph, position, &mask)) {
-                    perMask(mask, glyph, position);
+                    this->addToMaskStrip(mask, glyph, position, perMask);
                 }
             }
         }
+        this->flushMaskStrip(perMask);
     }
 }
 
@@ -185,13 +186,105 @@ void SkGlyphRunListPainter::drawGlyphRunAsFullpixelMask(
                 const SkGlyph& glyph = cache->getGlyphIDMetrics(glyphID);
                 SkMask mask;
                 if (prepare_mask(cache, glyph, position, &mask)) {
-                    perMask(mask, glyph, position);
+                    this->addToMaskStrip(mask, glyph, position, perMask);
                 }
             }
         }
+        this->flushMaskStrip(perMask);
     }
 }
 
+// A strip is only worth it while the glyphs cover a good part of it; the rest of the strip is
+// zero coverage that still has to be blended.
+static constexpr int64_t kMaxMaskStripArea = 64 * 1024;
+static constexpr int64_t kMinMaskStripFill = 4;   // glyph area must be at least 1/4 of the strip
+static constexpr size_t  kMaxMaskStripGlyphs = 64;
+
+void SkGlyphRunListPainter::addToMaskStrip(
+        const SkMask& mask, const SkGlyph& glyph, SkPoint position, const PerMask& perMask) {
+    if (mask.fFormat != SkMask::kA8_Format) {
+        this->flushMaskStrip(perMask);
+        perMask(mask, glyph, position);
+        return;
+    }
+
+    const SkIRect& bounds = mask.fBounds;
+    int64_t glyphArea = int64_t(bounds.width()) * bounds.height();
+    if (!fStripMasks.empty()) {
+        SkIRect joined = fStripBounds;
+        joined.join(bounds);
+        int64_t joinedArea = int64_t(joined.width()) * joined.height();
+
+        // Glyphs that overlap must be blended one after the other, so they can't share a strip.
+        auto overlapsStrip = [&] {
+            if (!SkIRect::Intersects(fStripBounds, bounds)) {
+                return false;
+            }
+            for (const SkMask& stripMask : fStripMasks) {
+                if (SkIRect::Intersects(stripMask.fBounds, bounds)) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        if (fStripMasks.size() >= kMaxMaskStripGlyphs ||
+            joinedArea > kMaxMaskStripArea ||
+            joinedArea > kMinMaskStripFill * (fStripGlyphArea + glyphArea) ||
+            overlapsStrip()) {
+            this->flushMaskStrip(perMask);
+        }
+    }
+
+    if (fStripMasks.empty()) {
+        fStripBounds    = bounds;
+        fStripGlyphArea = 0;
+        fStripGlyph     = &glyph;
+        fStripPosition  = position;
+    } else {
+        fStripBounds.join(bounds);
+    }
+    fStripGlyphArea += glyphArea;
+    fStripMasks.push_back(mask);
+}
+
+void SkGlyphRunListPainter::flushMaskStrip(const PerMask& perMask) {
+    if (fStripMasks.empty()) {
+        return;
+    }
+    if (fStripMasks.size() == 1) {
+        perMask(fStripMasks.front(), *fStripGlyph, fStripPosition);
+        fStripMasks.clear();
+        return;
+    }
+
+    SkMask strip;
+    strip.fBounds   = fStripBounds;
+    strip.fFormat   = SkMask::kA8_Format;
+    strip.fRowBytes = fStripBounds.width();
+
+    size_t stripSize = strip.computeImageSize();
+    if (stripSize > fStripStorageSize) {
+        fStripStorage.reset(stripSize);
+        fStripStorageSize = stripSize;
+    }
+    strip.fImage = fStripStorage.get();
+    sk_bzero(strip.fImage, stripSize);
+
+    for (const SkMask& mask : fStripMasks) {
+        const uint8_t* src = mask.fImage;
+        uint8_t* dst = strip.getAddr8(mask.fBounds.fLeft, mask.fBounds.fTop);
+        for (int y = 0; y < mask.fBounds.height(); y++) {
+            memcpy(dst, src, mask.fBounds.width());
+            src += mask.fRowBytes;
+            dst += strip.fRowBytes;
+        }
+    }
+
+    perMask(strip, *fStripGlyph, fStripPosition);
+    fStripMasks.clear();
+}
+
 void SkGlyphRunListPainter::drawForBitmapDevice(
         const SkGlyphRunList& glyphRunList, const SkMatrix& deviceMatrix,
         PerMaskCreator perMaskCreator, PerPathCreator perPathCreator) {
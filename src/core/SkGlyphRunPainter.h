@@ -26,6 +26,9 @@ public:
     explicit SkGlyphRunListPainter(const GrRenderTargetContext& renderTargetContext);
 #endif
 
+    // On the bitmap device path, consecutive A8 glyph masks that do not overlap are packed into
+    // a single strip mask before they reach PerMask, so a run of glyphs is composited with one
+    // blit. For a strip, the glyph and position passed along are those of its first glyph.
     using PerMask = std::function<void(const SkMask&, const SkGlyph&, SkPoint)>;
     using PerMaskCreator = std::function<PerMask(const SkPaint&, SkArenaAlloc* alloc)>;
     using PerPath = std::function<void(const SkPath*, const SkGlyph&, SkPoint)>;
@@ -92,6 +95,11 @@ private:
             SkPoint origin, const SkMatrix& deviceMatrix,
             PerMask perMask);
 
+    // Either adds mask to the current strip, or flushes the strip and starts a new one.
+    void addToMaskStrip(const SkMask& mask, const SkGlyph& glyph, SkPoint position,
+                        const PerMask& perMask);
+    void flushMaskStrip(const PerMask& perMask);
+
     // The props as on the actual device.
     const SkSurfaceProps fDeviceProps;
     // The props for when the bitmap device can't draw LCD text.
@@ -101,6 +109,15 @@ private:
     size_t fMaxRunSize{0};
     SkAutoTMalloc<SkPoint> fPositions;
 
+    // The A8 glyph masks waiting to be packed into a strip, and the strip's bounds.
+    std::vector<SkMask>    fStripMasks;
+    SkIRect                fStripBounds{SkIRect::MakeEmpty()};
+    int64_t                fStripGlyphArea{0};
+    const SkGlyph*         fStripGlyph{nullptr};
+    SkPoint                fStripPosition{0, 0};
+    SkAutoTMalloc<uint8_t> fStripStorage;
+    size_t                 fStripStorageSize{0};
+
     // Vectors for tracking ARGB fallback information.
     std::vector<SkGlyphID> fARGBGlyphsIDs;
     std::vector<SkPoint>   fARGBPositions;
@@ -120,6 +120,28 @@ bool SkImageGenerator::getYUVA8Planes(const SkYUVSizeInfo& sizeInfo,
     return true;
 }
 
+bool SkImageGenerator::queryYUVA8(SkYUVSizeInfo* sizeInfo,
+                                  SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
+                                  SkYUVColorSpace* colorSpace,
+                                  const SkYUVDecodeOptions& options) const {
+    if (options.isDefault()) {
+        return this->queryYUVA8(sizeInfo, yuvaIndices, colorSpace);
+    }
+    SkASSERT(sizeInfo);
+    return this->onQueryScaledYUVA8(sizeInfo, yuvaIndices, colorSpace, options);
+}
+
+bool SkImageGenerator::getYUVA8Planes(const SkYUVSizeInfo& sizeInfo,
+                                      const SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
+                                      void* planes[SkYUVSizeInfo::kMaxCount],
+                                      const SkYUVDecodeOptions& options) {
+    if (options.isDefault()) {
+        return this->getYUVA8Planes(sizeInfo, yuvaIndices, planes);
+    }
+    SkASSERT(planes);
+    return this->onGetScaledYUVA8Planes(sizeInfo, yuvaIndices, planes, options);
+}
+
 #if SK_SUPPORT_GPU
 #include "GrTextureProxy.h"
 
@@ -9,14 +9,18 @@
 
 #include "SkArenaAlloc.h"
 #include "SkColorPriv.h"
+#include "SkExecutor.h"
 #include "SkGaussFilter.h"
 #include "SkMalloc.h"
 #include "SkNx.h"
+#include "SkOpts.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 #include "SkTo.h"
 
 #include <cmath>
 #include <climits>
+#include <cstring>
 
 namespace {
 static const double kPi = 3.14159265358979323846264338327950288;
@@ -89,6 +93,16 @@ public:
 
     int    border()     const { return fBorder; }
 
+    // SkOpts::blur_lines_8 keeps the weight in 32 bits, which only rules out a window of one.
+    bool canBlurLines() const { return fWeight <= UINT32_MAX; }
+
+    // Blur 8 lines at once, transposing them into dst. buffer must hold 8 * bufferSize() values.
+    void blurLines(const uint8_t* src, size_t srcRB, int srcW,
+                   uint8_t* dst, size_t dstRB, int dstW, uint32_t* buffer) const {
+        SkOpts::blur_lines_8(src, srcRB, srcW, dst, dstRB, dstW,
+                             SkTo<uint32_t>(fWeight), fPass0Size, fPass1Size, fPass2Size, buffer);
+    }
+
 public:
     class Scan {
     public:
@@ -248,9 +262,10 @@ public:
 //
 //   window = floor(sigma * 3 * sqrt(2 * kPi) / 4 + 0.5)
 //   For window <= 255, the largest value for sigma is 136.
-SkMaskBlurFilter::SkMaskBlurFilter(double sigmaW, double sigmaH)
+SkMaskBlurFilter::SkMaskBlurFilter(double sigmaW, double sigmaH, SkExecutor* executor)
     : fSigmaW{SkTPin(sigmaW, 0.0, 136.0)}
     , fSigmaH{SkTPin(sigmaH, 0.0, 136.0)}
+    , fExecutor{executor}
 {
     SkASSERT(sigmaW >= 0);
     SkASSERT(sigmaH >= 0);
@@ -949,6 +964,111 @@ static SkIPoint small_blur(double sigmaX, double sigmaY, const SkMask& src, SkMa
     return {radiusX, radiusY};
 }
 
+// Masks with fewer values than this are blurred by the scalar scan, even with an executor.
+static constexpr int64_t kMinBandedBlurArea = 256 * 256;
+static constexpr int     kMaxBlurBands      = 16;
+
+// Converts a row of width mask values of the given format to A8.
+static void row_to_a8(uint8_t* a8, const uint8_t* from, int width, SkMask::Format format) {
+    if (format == SkMask::kA8_Format) {
+        std::memcpy(a8, from, width);
+        return;
+    }
+    for (int x = 0; x < width; x += 8) {
+        int n = std::min(8, width - x);
+        switch (format) {
+            case SkMask::kBW_Format:     bw_to_a8    (a8 + x, from + x / 8, n); break;
+            case SkMask::kARGB32_Format: argb32_to_a8(a8 + x, from + x * 4, n); break;
+            case SkMask::kLCD16_Format:  lcd_to_a8   (a8 + x, from + x * 2, n); break;
+            default: SK_ABORT("Unhandled format.");
+        }
+    }
+}
+
+// The large sigma blur, eight lines at a time with SkOpts::blur_lines_8. The horizontal pass
+// reads groups of eight src rows and writes them transposed into tmp, so the vertical pass can
+// again read groups of eight tmp rows, and writes them transposed back into dst. Groups are
+// independent, so each pass splits its groups into bands that run concurrently on executor.
+static void blur_lines(const PlanGauss& planW, const PlanGauss& planH,
+                       const SkMask& src, SkMask* dst, SkExecutor* executor) {
+    int srcW = src.fBounds.width(),
+        srcH = src.fBounds.height(),
+        dstW = dst->fBounds.width(),
+        dstH = dst->fBounds.height();
+
+    // tmp holds dstW rows of srcH values, padded out to whole groups of eight both ways so that
+    // neither pass needs to clip the eight lanes of the kernel.
+    size_t tmpRB = SkAlign8(srcH);
+    int    tmpH  = SkAlign8(dstW);
+    SkAutoTMalloc<uint8_t> tmp(tmpRB * tmpH);
+    std::memset(tmp.get() + dstW * tmpRB, 0, (tmpH - dstW) * tmpRB);
+
+    int groupsW = SkTo<int>(tmpRB / 8),
+        groupsH = tmpH / 8;
+
+    int bands = std::min(kMaxBlurBands, std::max(groupsW, groupsH));
+
+    // Each band gets its own ring buffers and scratch space: eight A8 src rows for the horizontal
+    // pass, and eight dst columns for the last vertical group when dstW is not a multiple of 8.
+    size_t bufferSize  = 8 * std::max(planW.bufferSize(), planH.bufferSize()),
+           scratchSize = 8 * std::max(srcW, dstH);
+    SkAutoTMalloc<uint32_t> buffers(bands * bufferSize);
+    SkAutoTMalloc<uint8_t>  scratch(bands * scratchSize);
+
+    auto forEachBand = [&](int groups, const std::function<void(int, int, int)>& fn) {
+        int bandCount = std::min(bands, groups);
+        if (bandCount <= 1) {
+            fn(0, 0, groups);
+            return;
+        }
+        SkTaskGroup tg(*executor);
+        tg.batch(bandCount, [&](int band) {
+            fn(band, band * groups / bandCount, (band + 1) * groups / bandCount);
+        });
+        tg.wait();
+    };
+
+    // Blur horizontally, and transpose.
+    forEachBand(groupsW, [&](int band, int start, int end) {
+        uint32_t* buffer = buffers.get() + band * bufferSize;
+        uint8_t*  a8     = scratch.get() + band * scratchSize;
+        for (int group = start; group < end; group++) {
+            int y = 8 * group,
+                n = std::min(8, srcH - y);
+            const uint8_t* lines = src.fImage + y * src.fRowBytes;
+            if (src.fFormat == SkMask::kA8_Format && n == 8) {
+                planW.blurLines(lines, src.fRowBytes, srcW, tmp.get() + y, tmpRB, dstW, buffer);
+                continue;
+            }
+            for (int i = 0; i < n; i++) {
+                row_to_a8(a8 + i * srcW, lines + i * src.fRowBytes, srcW, src.fFormat);
+            }
+            std::memset(a8 + n * srcW, 0, (8 - n) * srcW);
+            planW.blurLines(a8, srcW, srcW, tmp.get() + y, tmpRB, dstW, buffer);
+        }
+    });
+
+    // Blur vertically (scan in memory order because of the transposition),
+    // and transpose back to the original orientation.
+    forEachBand(groupsH, [&](int band, int start, int end) {
+        uint32_t* buffer  = buffers.get() + band * bufferSize;
+        uint8_t*  columns = scratch.get() + band * scratchSize;
+        for (int group = start; group < end; group++) {
+            int x = 8 * group,
+                n = std::min(8, dstW - x);
+            const uint8_t* lines = tmp.get() + x * tmpRB;
+            if (n == 8) {
+                planH.blurLines(lines, tmpRB, srcH, dst->fImage + x, dst->fRowBytes, dstH, buffer);
+                continue;
+            }
+            planH.blurLines(lines, tmpRB, srcH, columns, 8, dstH, buffer);
+            for (int y = 0; y < dstH; y++) {
+                std::memcpy(dst->fImage + y * dst->fRowBytes + x, columns + 8 * y, n);
+            }
+        }
+    });
+}
+
 // TODO: assuming sigmaW = sigmaH. Allow different sigmas. Right now the
 // API forces the sigmas to be the same.
 SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
@@ -982,6 +1102,14 @@ SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
         dstH = dst->fBounds.height();
     SkASSERT(srcW >= 0 && srcH >= 0 && dstW >= 0 && dstH >= 0);
 
+    // Only callers that hand us an executor get the banded blur, and only for masks big enough
+    // to be worth splitting; everyone else keeps the scalar scan below.
+    if (fExecutor && int64_t(srcW) * srcH >= kMinBandedBlurArea &&
+        planW.canBlurLines() && planH.canBlurLines()) {
+        blur_lines(planW, planH, src, dst, fExecutor);
+        return {SkTo<int32_t>(borderW), SkTo<int32_t>(borderH)};
+    }
+
     auto bufferSize = std::max(planW.bufferSize(), planH.bufferSize());
     auto buffer = alloc.makeArrayDefault<uint32_t>(bufferSize);
 
@@ -39,6 +39,7 @@
 #include "SkBlitMask_opts.h"
 #include "SkBlitRow_opts.h"
 #include "SkChecksum_opts.h"
+#include "SkMaskBlurFilter_opts.h"
 #include "SkMorphologyImageFilter_opts.h"
 #include "SkRasterPipeline_opts.h"
 #include "SkSwizzler_opts.h"
@@ -74,6 +75,8 @@ namespace SkOpts {
     DEFINE_DEFAULT(inverted_CMYK_to_RGB1);
     DEFINE_DEFAULT(inverted_CMYK_to_BGR1);
 
+    DEFINE_DEFAULT(blur_lines_8);
+
     DEFINE_DEFAULT(memset16);
     DEFINE_DEFAULT(memset32);
     DEFINE_DEFAULT(memset64);
@@ -102,6 +105,7 @@ namespace SkOpts {
     void Init_sse42();
     void Init_avx();
     void Init_hsw();
+    void Init_skx();
     void Init_crc32();
 
     static void init() {
@@ -124,6 +128,10 @@ namespace SkOpts {
             if (SkCpu::Supports(SkCpu::HSW)) { Init_hsw();   }
         #endif
 
+        #if SK_CPU_SSE_LEVEL < SK_CPU_SSE_LEVEL_SKX
+            if (SkCpu::Supports(SkCpu::SKX)) { Init_skx();   }
+        #endif
+
     #elif defined(SK_CPU_ARM64)
         if (SkCpu::Supports(SkCpu::CRC32)) { Init_crc32(); }
 
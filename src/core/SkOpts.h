@@ -47,6 +47,13 @@ namespace SkOpts {
                            grayA_to_RGBA,   // i.e. expand to color channels
                            grayA_to_rgbA;   // i.e. expand to color channels and premultiply
 
+    // Blurs 8 A8 lines at once with the three box passes SkMaskBlurFilter uses for large sigmas.
+    // The result is transposed: value x of line i is written to dst[x * dstRB + i].
+    extern void (*blur_lines_8)(const uint8_t src[], size_t srcRB, int srcW,
+                                uint8_t dst[], size_t dstRB, int dstW,
+                                uint32_t weight, int pass0Size, int pass1Size, int pass2Size,
+                                uint32_t buffer[]);
+
     extern void (*memset16)(uint16_t[], uint16_t, int);
     extern void SK_API (*memset32)(uint32_t[], uint32_t, int);
     extern void (*memset64)(uint64_t[], uint64_t, int);
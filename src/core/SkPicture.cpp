@@ -8,7 +8,10 @@
 #include "SkPicture.h"
 
 #include "SkAtomics.h"
+#include "SkCanvas.h"
+#include "SkExecutor.h"
 #include "SkImageGenerator.h"
+#include "SkImageInfoPriv.h"
 #include "SkMathPriv.h"
 #include "SkPictureCommon.h"
 #include "SkPictureData.h"
@@ -17,6 +20,7 @@
 #include "SkPictureRecord.h"
 #include "SkPictureRecorder.h"
 #include "SkSerialProcs.h"
+#include "SkTaskGroup.h"
 #include "SkTo.h"
 
 // When we read/write the SkPictInfo via a stream, we have a sentinel byte right after the info.
@@ -322,6 +326,56 @@ void SkPicturePriv::Flatten(const sk_sp<const SkPicture> picture, SkWriteBuffer&
     }
 }
 
+bool SkPicture::playback(const SkPixmap& dst, const SkMatrix* matrix, SkExecutor* executor,
+                         int tileCountX, int tileCountY) const {
+    // The checks MakeRasterDirect() makes, so that each tile, a subset of dst, gets a canvas.
+    const SkImageInfo& info = dst.info();
+    const size_t rowBytes = dst.rowBytes();
+    if (!dst.addr() || !SkImageInfoIsValid(info) || !info.validRowBytes(rowBytes) ||
+        rowBytes % info.bytesPerPixel() != 0 ||
+        sk_64_mul(info.height(), rowBytes) > SK_MaxS32) {
+        return false;
+    }
+
+    // Round the tile size up, which may leave us with fewer tiles than asked for.
+    const int tileW = SkTPin((dst.width()  + tileCountX - 1) / SkTMax(tileCountX, 1),
+                             1, dst.width()),
+              tileH = SkTPin((dst.height() + tileCountY - 1) / SkTMax(tileCountY, 1),
+                             1, dst.height());
+    tileCountX = (dst.width()  + tileW - 1) / tileW;
+    tileCountY = (dst.height() + tileH - 1) / tileH;
+
+    auto drawTile = [&](int i) {
+        SkIRect tile = SkIRect::MakeXYWH((i % tileCountX) * tileW,
+                                         (i / tileCountX) * tileH,
+                                         tileW, tileH);
+        SkPixmap pixels;
+        SkAssertResult(dst.extractSubset(&pixels, tile));  // Clips tile to dst.
+
+        // The canvas' device bounds are the tile, so SkBigPicture culls with its BBH as usual.
+        auto canvas = SkCanvas::MakeRasterDirect(pixels.info(), pixels.writable_addr(),
+                                                 pixels.rowBytes());
+        SkASSERT(canvas);
+        canvas->translate(-SkIntToScalar(tile.x()), -SkIntToScalar(tile.y()));
+        if (matrix) {
+            canvas->concat(*matrix);
+        }
+        this->playback(canvas.get());
+    };
+
+    const int tiles = tileCountX * tileCountY;
+    if (executor && tiles > 1) {
+        SkTaskGroup group(*executor);
+        group.batch(tiles, drawTile);
+        group.wait();
+    } else {
+        for (int i = 0; i < tiles; i++) {
+            drawTile(i);
+        }
+    }
+    return true;
+}
+
 sk_sp<SkPicture> SkPicture::MakePlaceholder(SkRect cull) {
     struct Placeholder : public SkPicture {
           explicit Placeholder(SkRect cull) : fCull(cull) {}
@@ -11,10 +11,12 @@
 #include "SkMessageBus.h"
 #include "SkMipMap.h"
 #include "SkMutex.h"
+#include "SkOnce.h"
 #include "SkOpts.h"
 #include "SkTo.h"
 #include "SkTraceMemoryDump.h"
 
+#include <atomic>
 #include <stddef.h>
 #include <stdlib.h>
 
@@ -84,6 +86,8 @@ void SkResourceCache::init() {
     fTotalBytesUsed = 0;
     fCount = 0;
     fSingleAllocationByteLimit = 0;
+    fSharedBytesUsed = nullptr;
+    fSharedCount = nullptr;
 
     // One of these should be explicit set by the caller after we return.
     fTotalByteLimit = 0;
@@ -184,6 +188,10 @@ void SkResourceCache::remove(Rec* rec) {
 
     fTotalBytesUsed -= used;
     fCount -= 1;
+    if (fSharedBytesUsed) {
+        *fSharedBytesUsed -= used;
+        *fSharedCount     -= 1;
+    }
 
     //SkDebugf("-RC count [%3d] bytes %d\n", fCount, fTotalBytesUsed);
 
@@ -224,6 +232,24 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
     }
 }
 
+void SkResourceCache::purgeLeastRecentlyUsed(size_t bytesToFree, int recsToFree) {
+    this->checkMessages();
+
+    size_t bytesFreed = 0;
+    int    recsFreed  = 0;
+
+    Rec* rec = fTail;
+    while (rec && (bytesFreed < bytesToFree || recsFreed < recsToFree)) {
+        Rec* prev = rec->fPrev;
+        if (rec->canBePurged()) {
+            bytesFreed += rec->bytesUsed();
+            recsFreed  += 1;
+            this->remove(rec);
+        }
+        rec = prev;
+    }
+}
+
 //#define SK_TRACK_PURGE_SHAREDID_HITRATE
 
 #ifdef SK_TRACK_PURGE_SHAREDID_HITRATE
@@ -355,6 +381,10 @@ void SkResourceCache::addToHead(Rec* rec) {
     }
     fTotalBytesUsed += rec->bytesUsed();
     fCount += 1;
+    if (fSharedBytesUsed) {
+        *fSharedBytesUsed += rec->bytesUsed();
+        *fSharedCount     += 1;
+    }
 
     this->validate();
 }
@@ -439,6 +469,12 @@ size_t SkResourceCache::getEffectiveSingleAllocationByteLimit() const {
     return limit;
 }
 
+void SkResourceCache::shareTotals(std::atomic<size_t>* bytesUsed, std::atomic<int>* count) {
+    SkASSERT(0 == fCount);
+    fSharedBytesUsed = bytesUsed;
+    fSharedCount     = count;
+}
+
 void SkResourceCache::checkMessages() {
     SkTArray<PurgeSharedIDMessage> msgs;
     fPurgeSharedIDInbox.poll(&msgs);
@@ -449,86 +485,192 @@ void SkResourceCache::checkMessages() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-SK_DECLARE_STATIC_MUTEX(gMutex);
-static SkResourceCache* gResourceCache = nullptr;
+// The global cache is split into shards by key hash, each its own SkResourceCache behind its own
+// mutex, so that threads working with unrelated keys don't contend.  The shards have no budget of
+// their own.  Instead we track totals across all shards, and whoever pushes them over the global
+// budget purges the least recently used recs from the shards in turn.  So LRU order is only kept
+// within each shard, which is a fine approximation with this many shards.
+//
+// Each shard has its own PurgeSharedIDMessage inbox, so purge-by-sharedID reaches all of them.
+// Shards add every change in their size to the totals as they make it, but only read their inbox
+// when used, so reading the totals first has every shard catch up on its messages.
+//
+// Visitors are called with their shard's lock held, so they must not call back into the cache.
+
+static constexpr int kShardCount = 16;
+
+namespace {
+    struct Shard {
+        SkMutex          fMutex;
+        SkResourceCache* fCache = nullptr;
+    };
+}
 
-/** Must hold gMutex when calling. */
-static SkResourceCache* get_cache() {
-    // gMutex is always held when this is called, so we don't need to be fancy in here.
-    gMutex.assertHeld();
-    if (nullptr == gResourceCache) {
+static Shard*                              gShards = nullptr;
+static SkResourceCache::DiscardableFactory gDiscardableFactory = nullptr;
+static std::atomic<size_t>                 gTotalBytesUsed{0};
+static std::atomic<int>                    gTotalCount{0};
+static std::atomic<size_t>                 gTotalByteLimit{SK_DEFAULT_IMAGE_CACHE_LIMIT};
+static std::atomic<size_t>                 gSingleAllocationByteLimit{0};
+static std::atomic<unsigned>               gNextPurgeShard{0};
+
+static Shard* get_shards() {
+    static SkOnce once;
+    once([] {
 #ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
-        gResourceCache = new SkResourceCache(SkDiscardableMemory::Create);
-#else
-        gResourceCache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
+        gDiscardableFactory = SkDiscardableMemory::Create;
 #endif
+        gShards = new Shard[kShardCount];
+        for (int i = 0; i < kShardCount; i++) {
+            gShards[i].fCache = gDiscardableFactory ? new SkResourceCache(gDiscardableFactory)
+                                                    : new SkResourceCache(SIZE_MAX);
+            gShards[i].fCache->shareTotals(&gTotalBytesUsed, &gTotalCount);
+        }
+    });
+    return gShards;
+}
+
+static Shard* get_shard(const SkResourceCache::Key& key) {
+    // SkTHashTable indexes with the low bits of the hash, so pick shards with the high bits.
+    return &get_shards()[(key.hash() >> 16) % kShardCount];
+}
+
+// Holds a shard's lock.
+class ShardLock : SkNoncopyable {
+public:
+    explicit ShardLock(Shard* shard) : fShard(shard), fLock(shard->fMutex) {}
+
+    SkResourceCache* operator->() const { return fShard->fCache; }
+
+private:
+    Shard*             fShard;
+    SkAutoMutexAcquire fLock;
+};
+
+// Applies any purge-by-sharedID messages the shards have not read yet.
+static void check_shard_messages() {
+    Shard* shards = get_shards();
+    for (int i = 0; i < kShardCount; i++) {
+        ShardLock shard(&shards[i]);
+        shard->checkMessages();
+    }
+}
+
+static void purge_shards_as_needed() {
+    // Like SkResourceCache::purgeAsNeeded(), but across shards.  Visit each shard at most once,
+    // so we stop even if what's left over budget cannot be purged.
+    for (int i = 0; i < kShardCount; i++) {
+        size_t bytesToFree = 0;
+        int    recsToFree  = 0;
+        if (gDiscardableFactory) {
+            int count = gTotalCount.load();
+            if (count >= SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT) {
+                recsToFree = count - SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT + 1;
+            }
+        } else {
+            size_t used  = gTotalBytesUsed.load(),
+                   limit = gTotalByteLimit.load();
+            if (used >= limit) {
+                bytesToFree = used - limit + 1;
+            }
+        }
+        if (bytesToFree == 0 && recsToFree == 0) {
+            return;
+        }
+
+        ShardLock shard(&get_shards()[gNextPurgeShard++ % kShardCount]);
+        shard->purgeLeastRecentlyUsed(bytesToFree, recsToFree);
     }
-    return gResourceCache;
 }
 
 size_t SkResourceCache::GetTotalBytesUsed() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getTotalBytesUsed();
+    check_shard_messages();
+    return gTotalBytesUsed;
 }
 
 size_t SkResourceCache::GetTotalByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getTotalByteLimit();
+    get_shards();
+    return gDiscardableFactory ? 0 : gTotalByteLimit.load();
 }
 
 size_t SkResourceCache::SetTotalByteLimit(size_t newLimit) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->setTotalByteLimit(newLimit);
+    get_shards();
+    size_t prevLimit = gTotalByteLimit.exchange(newLimit);
+    if (newLimit < prevLimit) {
+        purge_shards_as_needed();
+    }
+    return prevLimit;
 }
 
 SkResourceCache::DiscardableFactory SkResourceCache::GetDiscardableFactory() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->discardableFactory();
+    get_shards();
+    return gDiscardableFactory;
 }
 
 SkCachedData* SkResourceCache::NewCachedData(size_t bytes) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->newCachedData(bytes);
+    if (auto factory = GetDiscardableFactory()) {
+        SkDiscardableMemory* dm = factory(bytes);
+        return dm ? new SkCachedData(bytes, dm) : nullptr;
+    }
+    return new SkCachedData(sk_malloc_throw(bytes), bytes);
 }
 
 void SkResourceCache::Dump() {
-    SkAutoMutexAcquire am(gMutex);
-    get_cache()->dump();
+    check_shard_messages();
+    SkDebugf("SkResourceCache: count=%d bytes=%zu %s, %d shards\n",
+             gTotalCount.load(), gTotalBytesUsed.load(),
+             gDiscardableFactory ? "discardable" : "malloc", kShardCount);
 }
 
 size_t SkResourceCache::SetSingleAllocationByteLimit(size_t size) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->setSingleAllocationByteLimit(size);
+    return gSingleAllocationByteLimit.exchange(size);
 }
 
 size_t SkResourceCache::GetSingleAllocationByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getSingleAllocationByteLimit();
+    return gSingleAllocationByteLimit;
 }
 
 size_t SkResourceCache::GetEffectiveSingleAllocationByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getEffectiveSingleAllocationByteLimit();
+    // Same as getEffectiveSingleAllocationByteLimit(), against the global budget.
+    size_t limit = gSingleAllocationByteLimit;
+    if (nullptr == GetDiscardableFactory()) {
+        if (0 == limit) {
+            limit = gTotalByteLimit;
+        } else {
+            limit = SkTMin(limit, gTotalByteLimit.load());
+        }
+    }
+    return limit;
 }
 
 void SkResourceCache::PurgeAll() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->purgeAll();
+    Shard* shards = get_shards();
+    for (int i = 0; i < kShardCount; i++) {
+        ShardLock shard(&shards[i]);
+        shard->purgeAll();
+    }
 }
 
 bool SkResourceCache::Find(const Key& key, FindVisitor visitor, void* context) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->find(key, visitor, context);
+    ShardLock shard(get_shard(key));
+    return shard->find(key, visitor, context);
 }
 
 void SkResourceCache::Add(Rec* rec, void* payload) {
-    SkAutoMutexAcquire am(gMutex);
-    get_cache()->add(rec, payload);
+    {
+        ShardLock shard(get_shard(rec->getKey()));
+        shard->add(rec, payload);
+    }
+    // The new rec may push us over budget.
+    purge_shards_as_needed();
 }
 
 void SkResourceCache::VisitAll(Visitor visitor, void* context) {
-    SkAutoMutexAcquire am(gMutex);
-    get_cache()->visitAll(visitor, context);
+    Shard* shards = get_shards();
+    for (int i = 0; i < kShardCount; i++) {
+        ShardLock shard(&shards[i]);
+        shard->visitAll(visitor, context);
+    }
 }
 
 void SkResourceCache::PostPurgeSharedID(uint64_t sharedID) {
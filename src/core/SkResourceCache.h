@@ -12,6 +12,8 @@
 #include "SkMessageBus.h"
 #include "SkTDArray.h"
 
+#include <atomic>
+
 class SkCachedData;
 class SkDiscardableMemory;
 class SkTraceMemoryDump;
@@ -25,6 +27,8 @@ class SkTraceMemoryDump;
  *
  *  As a convenience, a global instance is also defined, which can be safely
  *  access across threads via the static methods (e.g. FindAndLock, etc.).
+ *  The global instance is sharded by key hash, each shard with its own lock,
+ *  while the byte budget and purge-by-sharedID still apply to it as a whole.
  */
 class SkResourceCache {
 public:
@@ -126,6 +130,8 @@ public:
      *  The return value determines what the cache will do with the Rec. If the function returns
      *  true, then the Rec is considered "valid". If false is returned, the Rec will be considered
      *  "stale" and will be purged from the cache.
+     *
+     *  The function is called with the cache locked, so it must not call back into the cache.
      */
     typedef bool (*FindVisitor)(const Rec&, void* context);
 
@@ -153,7 +159,8 @@ public:
     static void Add(Rec*, void* payload = nullptr);
 
     typedef void (*Visitor)(const Rec&, void* context);
-    // Call the visitor for every Rec in the cache.
+    // Call the visitor for every Rec in the cache. Like a FindVisitor, the visitor is called with
+    // the cache locked, and must not call back into the cache.
     static void VisitAll(Visitor, void* context);
 
     static size_t GetTotalBytesUsed();
@@ -222,6 +229,7 @@ public:
 
     size_t getTotalBytesUsed() const { return fTotalBytesUsed; }
     size_t getTotalByteLimit() const { return fTotalByteLimit; }
+    int    getCount()          const { return fCount; }
 
     /**
      *  This is respected by SkBitmapProcState::possiblyScaleImage.
@@ -247,6 +255,26 @@ public:
         this->purgeAsNeeded(true);
     }
 
+    /**
+     *  Purges recs from the least recently used end, skipping those that cannot be purged,
+     *  until at least bytesToFree bytes and recsToFree recs have been removed, or there is
+     *  nothing left to purge. The global cache uses this to keep its shards within one budget.
+     */
+    void purgeLeastRecentlyUsed(size_t bytesToFree, int recsToFree);
+
+    /**
+     *  Also add every change in this cache's bytes used and rec count to *bytesUsed and *count.
+     *  Must be called while the cache is empty. The global cache uses this to keep its totals
+     *  across shards current.
+     */
+    void shareTotals(std::atomic<size_t>* bytesUsed, std::atomic<int>* count);
+
+    /**
+     *  Purge the recs of any sharedIDs posted with PostPurgeSharedID() since the cache was
+     *  last used.
+     */
+    void checkMessages();
+
     DiscardableFactory discardableFactory() const { return fDiscardableFactory; }
 
     SkCachedData* newCachedData(size_t bytes);
@@ -270,9 +298,11 @@ private:
     size_t  fSingleAllocationByteLimit;
     int     fCount;
 
+    std::atomic<size_t>*  fSharedBytesUsed;
+    std::atomic<int>*     fSharedCount;
+
     SkMessageBus<PurgeSharedIDMessage>::Inbox fPurgeSharedIDInbox;
 
-    void checkMessages();
     void purgeAsNeeded(bool forcePurge = false);
 
     // linklist management
@@ -13,6 +13,7 @@
 #include "SkGraphics.h"
 #include "SkMutex.h"
 #include "SkTemplates.h"
+#include "SkTLS.h"
 #include "SkTraceMemoryDump.h"
 #include "SkTypeface.h"
 #include "SkPaintPriv.h"
@@ -36,6 +37,33 @@ struct SkStrikeCache::Node {
     std::unique_ptr<SkStrikePinner> fPinner;
 };
 
+struct SkStrikeCache::ThreadCache {
+    static constexpr int    kMaxStrikes = 4;
+    static constexpr size_t kMaxBytes   = 256 * 1024;
+
+    ~ThreadCache() {
+        // The thread is exiting; hand our strikes back to the global cache.
+        GlobalStrikeCache()->unregisterThreadCache(this);
+    }
+
+    // Removes the i'th strike, keeping the rest in order. fLock must be held.
+    Node* remove(int i) {
+        Node* node = fStrikes[i];
+        fCount -= 1;
+        fBytes -= node->fCache.getMemoryUsed();
+        memmove(fStrikes + i, fStrikes + i + 1, (fCount - i) * sizeof(Node*));
+        return node;
+    }
+
+    // Taken by the owning thread on every lookup and release, and by other threads only to
+    // purge or steal strikes while they hold the global cache's fLock. So it is almost never
+    // contended.
+    SkSpinlock fLock;
+    Node*      fStrikes[kMaxStrikes];  // Most recently released first.
+    int        fCount{0};
+    size_t     fBytes{0};
+};
+
 SkStrikeCache::ExclusiveStrikePtr::ExclusiveStrikePtr(
         SkStrikeCache::Node* node, SkStrikeCache* strikeCache)
     : fNode{node}
@@ -237,10 +265,111 @@ void SkStrikeCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
 }
 
 
+SkStrikeCache::ThreadCache* SkStrikeCache::GetThreadCache() {
+    auto create = []() -> void* {
+        auto* threadCache = new ThreadCache;
+        GlobalStrikeCache()->registerThreadCache(threadCache);
+        return threadCache;
+    };
+    auto destroy = [](void* ptr) { delete static_cast<ThreadCache*>(ptr); };
+    return static_cast<ThreadCache*>(SkTLS::Get(create, destroy));
+}
+
+void SkStrikeCache::registerThreadCache(ThreadCache* threadCache) {
+    SkAutoExclusive ac(fLock);
+    fThreadCaches.push_back(threadCache);
+}
+
+void SkStrikeCache::unregisterThreadCache(ThreadCache* threadCache) {
+    SkAutoExclusive ac(fLock);
+
+    int index = fThreadCaches.find(threadCache);
+    SkASSERT(index >= 0);
+    fThreadCaches.removeShuffle(index);
+
+    {
+        SkAutoExclusive tac(threadCache->fLock);
+        while (threadCache->fCount > 0) {
+            Node* node = this->internalDetachFromThreadCache(threadCache, threadCache->fCount - 1);
+            this->internalAttachToHead(node);
+        }
+    }
+    this->internalPurge();
+}
+
+bool SkStrikeCache::attachNodeToThreadCache(Node* node) {
+    // Pinned strikes are managed by their pinner through the shared list.
+    if (this != GlobalStrikeCache() || node->fPinner != nullptr) {
+        return false;
+    }
+
+    size_t bytes = node->fCache.getMemoryUsed();
+    if (bytes > ThreadCache::kMaxBytes) {
+        return false;
+    }
+
+    ThreadCache* threadCache = GetThreadCache();
+    Node* evicted[ThreadCache::kMaxStrikes];
+    int evictedCount = 0;
+    {
+        SkAutoExclusive tac(threadCache->fLock);
+        while (threadCache->fCount == ThreadCache::kMaxStrikes ||
+               threadCache->fBytes + bytes > ThreadCache::kMaxBytes) {
+            evicted[evictedCount++] =
+                    this->internalDetachFromThreadCache(threadCache, threadCache->fCount - 1);
+        }
+
+        Node** strikes = threadCache->fStrikes;
+        memmove(strikes + 1, strikes, threadCache->fCount * sizeof(Node*));
+        strikes[0] = node;
+        threadCache->fCount += 1;
+        threadCache->fBytes += bytes;
+        fThreadCacheCount += 1;
+        fThreadCacheMemoryUsed += bytes;
+    }
+
+    // fLock must not be taken while holding a thread cache's lock.
+    for (int i = 0; i < evictedCount; i++) {
+        this->attachNodeToList(evicted[i]);
+    }
+    if (evictedCount == 0) {
+        // The strike may have grown while it was out, so check the budget as attachNodeToList()
+        // does. Each evicted strike above already did.
+        SkAutoExclusive ac(fLock);
+        this->internalPurge();
+    }
+    return true;
+}
+
+SkStrikeCache::Node* SkStrikeCache::findNodeInThreadCache(ThreadCache* threadCache,
+                                                          const SkDescriptor& desc) {
+    SkAutoExclusive tac(threadCache->fLock);
+    for (int i = 0; i < threadCache->fCount; i++) {
+        if (threadCache->fStrikes[i]->fCache.getDescriptor() == desc) {
+            return this->internalDetachFromThreadCache(threadCache, i);
+        }
+    }
+    return nullptr;
+}
+
+SkStrikeCache::Node* SkStrikeCache::internalDetachFromThreadCache(ThreadCache* threadCache,
+                                                                  int index) {
+    Node* node = threadCache->remove(index);
+    fThreadCacheCount -= 1;
+    fThreadCacheMemoryUsed -= node->fCache.getMemoryUsed();
+    return node;
+}
+
 void SkStrikeCache::attachNode(Node* node) {
     if (node == nullptr) {
         return;
     }
+    if (!this->attachNodeToThreadCache(node)) {
+        this->attachNodeToList(node);
+    }
+}
+
+void SkStrikeCache::attachNodeToList(Node* node) {
     SkAutoExclusive ac(fLock);
 
     this->validate();
@@ -251,6 +380,12 @@ void SkStrikeCache::attachNode(Node* node) {
 }
 
 SkExclusiveStrikePtr SkStrikeCache::findStrikeExclusive(const SkDescriptor& desc) {
+    if (this == GlobalStrikeCache()) {
+        if (Node* node = this->findNodeInThreadCache(GetThreadCache(), desc)) {
+            return SkExclusiveStrikePtr(node, this);
+        }
+    }
+
     SkAutoExclusive ac(fLock);
 
     for (Node* node = internalGetHead(); node != nullptr; node = node->fNext) {
@@ -260,6 +395,13 @@ SkExclusiveStrikePtr SkStrikeCache::findStrikeExclusive(const SkDescriptor& desc
         }
     }
 
+    // Take the strike from another thread's front cache rather than build a second copy of it.
+    for (ThreadCache* threadCache : fThreadCaches) {
+        if (Node* node = this->findNodeInThreadCache(threadCache, desc)) {
+            return SkExclusiveStrikePtr(node, this);
+        }
+    }
+
     return SkExclusiveStrikePtr();
 }
 
@@ -375,17 +517,17 @@ SkExclusiveStrikePtr SkStrikeCache::createStrikeExclusive(
 
 void SkStrikeCache::purgeAll() {
     SkAutoExclusive ac(fLock);
-    this->internalPurge(fTotalMemoryUsed);
+    this->internalPurge(fTotalMemoryUsed + fThreadCacheMemoryUsed);
 }
 
 size_t SkStrikeCache::getTotalMemoryUsed() const {
     SkAutoExclusive ac(fLock);
-    return fTotalMemoryUsed;
+    return fTotalMemoryUsed + fThreadCacheMemoryUsed;
 }
 
 int SkStrikeCache::getCacheCountUsed() const {
     SkAutoExclusive ac(fLock);
-    return fCacheCount;
+    return fCacheCount + fThreadCacheCount;
 }
 
 int SkStrikeCache::getCacheCountLimit() const {
@@ -450,26 +592,36 @@ void SkStrikeCache::forEachStrike(std::function<void(const SkGlyphCache&)> visit
     for (Node* node = this->internalGetHead(); node != nullptr; node = node->fNext) {
         visitor(node->fCache);
     }
+    for (ThreadCache* threadCache : fThreadCaches) {
+        SkAutoExclusive tac(threadCache->fLock);
+        for (int i = 0; i < threadCache->fCount; i++) {
+            visitor(threadCache->fStrikes[i]->fCache);
+        }
+    }
 }
 
 size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
     this->validate();
 
+    // Strikes in the threads' front caches count against the budget too.
+    size_t totalMemoryUsed = fTotalMemoryUsed + fThreadCacheMemoryUsed;
+    int    cacheCount      = fCacheCount + fThreadCacheCount;
+
     size_t bytesNeeded = 0;
-    if (fTotalMemoryUsed > fCacheSizeLimit) {
-        bytesNeeded = fTotalMemoryUsed - fCacheSizeLimit;
+    if (totalMemoryUsed > fCacheSizeLimit) {
+        bytesNeeded = totalMemoryUsed - fCacheSizeLimit;
     }
     bytesNeeded = SkTMax(bytesNeeded, minBytesNeeded);
     if (bytesNeeded) {
         // no small purges!
-        bytesNeeded = SkTMax(bytesNeeded, fTotalMemoryUsed >> 2);
+        bytesNeeded = SkTMax(bytesNeeded, totalMemoryUsed >> 2);
     }
 
     int countNeeded = 0;
-    if (fCacheCount > fCacheCountLimit) {
-        countNeeded = fCacheCount - fCacheCountLimit;
+    if (cacheCount > fCacheCountLimit) {
+        countNeeded = cacheCount - fCacheCountLimit;
         // no small purges!
-        countNeeded = SkMax32(countNeeded, fCacheCount >> 2);
+        countNeeded = SkMax32(countNeeded, cacheCount >> 2);
     }
 
     // early exit
@@ -496,6 +648,20 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
         node = prev;
     }
 
+    // The front caches hold the most recently used strikes, so they go last, oldest first.
+    for (int slot = ThreadCache::kMaxStrikes - 1;
+         slot >= 0 && (bytesFreed < bytesNeeded || countFreed < countNeeded); slot--) {
+        for (ThreadCache* threadCache : fThreadCaches) {
+            SkAutoExclusive tac(threadCache->fLock);
+            if (slot < threadCache->fCount) {
+                Node* node = this->internalDetachFromThreadCache(threadCache, slot);
+                bytesFreed += node->fCache.getMemoryUsed();
+                countFreed += 1;
+                delete node;
+            }
+        }
+    }
+
     this->validate();
 
 #ifdef SPEW_PURGE_STATUS
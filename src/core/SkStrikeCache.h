@@ -8,11 +8,13 @@
 #ifndef SkStrikeCache_DEFINED
 #define SkStrikeCache_DEFINED
 
+#include <atomic>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "SkDescriptor.h"
 #include "SkSpinlock.h"
+#include "SkTDArray.h"
 #include "SkTemplates.h"
 
 class SkGlyphCache;
@@ -40,6 +42,7 @@ public:
 
 class SkStrikeCache {
     struct Node;
+    struct ThreadCache;
 
 public:
     SkStrikeCache() = default;
@@ -124,6 +127,7 @@ public:
     // call when a glyphcache is available for caching (i.e. not in use)
     void attachNode(Node* node);
 
+    // Also drops the strikes in every thread's front cache.
     void purgeAll(); // does not change budget
 
     int getCacheCountLimit() const;
@@ -162,6 +166,22 @@ private:
 
     void forEachStrike(std::function<void(const SkGlyphCache&)> visitor) const;
 
+    // The global cache keeps a few recently released strikes per thread, so that a thread
+    // drawing text with the same few strikes over and over doesn't contend on fLock to find
+    // them. They count against the budget like any other unused strike, and internalPurge()
+    // drops them once the shared list alone can't meet the budget. A thread's front cache
+    // holds at most ThreadCache::kMaxBytes. When fLock and a ThreadCache's lock are both
+    // taken, fLock is taken first.
+    static ThreadCache* GetThreadCache();
+    void registerThreadCache(ThreadCache*);
+    void unregisterThreadCache(ThreadCache*);
+    // Returns false if node should go into the shared list instead.
+    bool attachNodeToThreadCache(Node*);
+    Node* findNodeInThreadCache(ThreadCache*, const SkDescriptor&);
+    void attachNodeToList(Node*);
+    // The ThreadCache's lock must be held.
+    Node* internalDetachFromThreadCache(ThreadCache*, int index);
+
     mutable SkSpinlock fLock;
     Node*              fHead{nullptr};
     Node*              fTail{nullptr};
@@ -170,6 +190,12 @@ private:
     int32_t            fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
     int32_t            fCacheCount{0};
     int32_t            fPointSizeLimit{SK_DEFAULT_FONT_CACHE_POINT_SIZE_LIMIT};
+
+    // Registered under fLock. The totals are kept apart from fTotalMemoryUsed and fCacheCount
+    // because front caches change them without fLock.
+    SkTDArray<ThreadCache*> fThreadCaches;
+    std::atomic<size_t>     fThreadCacheMemoryUsed{0};
+    std::atomic<int32_t>    fThreadCacheCount{0};
 };
 
 using SkExclusiveStrikePtr = SkStrikeCache::ExclusiveStrikePtr;
@@ -0,0 +1,364 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkThreadedBMPDevice.h"
+
+#include "SkAutoBlitterChoose.h"
+#include "SkBlitter.h"
+#include "SkPath.h"
+#include "SkPathPriv.h"
+#include "SkRRect.h"
+#include "SkScan.h"
+#include "SkSpecialImage.h"
+#include "SkTaskGroup.h"
+#include "SkVertices.h"
+
+// SkDraw (and hence SkBitmapDevice) has to tile anything larger than this because of SkFixed
+// overflow. We draw every tile in root device coordinates, so we simply don't defer such devices.
+static constexpr int kMaxDeferredDim = 8192 - 1;
+
+// Small paths are cheaper to scan convert per tile than to record coverage for.
+static constexpr int kMinVerbsForInitOnce = 4;
+
+SkThreadedBMPDevice::SkThreadedBMPDevice(const SkBitmap& bitmap, int tiles, int threads,
+                                         SkExecutor* executor)
+        : INHERITED(bitmap) {
+    this->init(tiles, threads, executor);
+}
+
+SkThreadedBMPDevice::SkThreadedBMPDevice(const SkBitmap& bitmap, const SkSurfaceProps& props,
+                                         int tiles, int threads, SkExecutor* executor)
+        : INHERITED(bitmap, props, nullptr, nullptr) {
+    this->init(tiles, threads, executor);
+}
+
+SkThreadedBMPDevice::~SkThreadedBMPDevice() {
+    this->flush();
+}
+
+void SkThreadedBMPDevice::init(int tiles, int threads, SkExecutor* executor) {
+    if (!INHERITED::onPeekPixels(&fRootPixmap)) {
+        fRootPixmap.reset(this->imageInfo(), nullptr, 0);
+    }
+
+    fTileCnt = SkTPin(tiles, 1, SkTMax(this->height(), 1));
+    fTileHeight = (this->height() + fTileCnt - 1) / fTileCnt;
+
+    if (executor) {
+        fExecutor = executor;
+    } else {
+        fInternalExecutor = SkExecutor::MakeFIFOThreadPool(threads > 0 ? threads : fTileCnt);
+        fExecutor = fInternalExecutor.get();
+    }
+}
+
+bool SkThreadedBMPDevice::canDefer() const {
+    return fRootPixmap.addr() &&
+           fTileCnt > 1 &&
+           this->width() <= kMaxDeferredDim &&
+           this->height() <= kMaxDeferredDim;
+}
+
+SkIRect SkThreadedBMPDevice::tileBounds(int tile) const {
+    int top = tile * fTileHeight;
+    return SkIRect::MakeLTRB(0, top, this->width(), SkTMin(top + fTileHeight, this->height()));
+}
+
+bool SkThreadedBMPDevice::computeDrawBounds(const SkRect* localBounds, const SkPaint& paint,
+                                            SkIRect* devBounds) const {
+    const SkIRect& clipBounds = fRCStack.rc().getBounds();
+    if (!localBounds || !paint.canComputeFastBounds()) {
+        *devBounds = clipBounds;
+        return !devBounds->isEmpty();
+    }
+
+    SkRect storage;
+    const SkRect& paintBounds = paint.computeFastBounds(*localBounds, &storage);
+    SkRect mapped;
+    this->ctm().mapRect(&mapped, paintBounds);
+    if (!mapped.isFinite()) {
+        *devBounds = clipBounds;
+        return !devBounds->isEmpty();
+    }
+
+    // Outset by one pixel for anti-aliasing and hairlines.
+    *devBounds = mapped.makeOutset(1, 1).roundOut();
+    return devBounds->intersect(clipBounds);
+}
+
+void SkThreadedBMPDevice::push(const SkIRect& devBounds, DrawFn drawFn, InitFn initFn) {
+    SkDAARecord* record = nullptr;
+    if (initFn) {
+        // Each record gets its own arena since records are computed concurrently.
+        record = fAlloc.make<SkDAARecord>(fAlloc.make<SkArenaAlloc>(4096));
+    }
+    fQueue.push_back(DrawElement{devBounds, this->ctm(), fRCStack.rc(),
+                                 std::move(drawFn), std::move(initFn), record});
+}
+
+void SkThreadedBMPDevice::flush() {
+    if (fQueue.empty()) {
+        return;
+    }
+
+    SkTArray<int> initIndices;
+    for (int i = 0; i < fQueue.count(); ++i) {
+        if (fQueue[i].fInitFn) {
+            initIndices.push_back(i);
+        }
+    }
+
+    SkTaskGroup group(*fExecutor);
+    if (!initIndices.empty()) {
+        group.batch(initIndices.count(), [this, &initIndices](int i) {
+            DrawElement& element = fQueue[initIndices[i]];
+            SkDraw draw;
+            draw.fDst    = fRootPixmap;
+            draw.fMatrix = &element.fMatrix;
+            draw.fRC     = &element.fRC;
+            element.fInitFn(draw, element.fDAARecord);
+        });
+        group.wait();
+    }
+
+    group.batch(fTileCnt, [this](int tile) {
+        const SkIRect tileBounds = this->tileBounds(tile);
+        for (const DrawElement& element : fQueue) {
+            if (!SkIRect::Intersects(element.fDrawBounds, tileBounds)) {
+                continue;
+            }
+            SkRasterClip tileRC(element.fRC);
+            if (!tileRC.op(tileBounds, SkRegion::kIntersect_Op)) {
+                continue;
+            }
+            SkDraw draw;
+            draw.fDst    = fRootPixmap;
+            draw.fMatrix = &element.fMatrix;
+            draw.fRC     = &tileRC;
+
+            // The init phase may have bailed out early (e.g. a fat rect or an empty path), in
+            // which case the record was never filled and each tile has to scan convert itself.
+            SkDAARecord* record = element.fDAARecord;
+            if (record && record->fType != SkDAARecord::Type::kMask &&
+                          record->fType != SkDAARecord::Type::kList) {
+                record = nullptr;
+            }
+            element.fDrawFn(draw, record);
+        }
+    });
+    group.wait();
+
+    fQueue.reset();
+    fAlloc.reset();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SkThreadedBMPDevice::drawPaint(const SkPaint& paint) {
+    if (!this->canDefer()) {
+        return INHERITED::drawPaint(paint);
+    }
+    SkIRect devBounds;
+    if (this->computeDrawBounds(nullptr, paint, &devBounds)) {
+        this->push(devBounds, [=](const SkDraw& draw, SkDAARecord*) {
+            draw.drawPaint(paint);
+        });
+    }
+}
+
+void SkThreadedBMPDevice::drawPoints(SkCanvas::PointMode mode, size_t count,
+                                     const SkPoint pts[], const SkPaint& paint) {
+    if (!this->canDefer() || !SkTFitsIn<int>(count)) {
+        return INHERITED::drawPoints(mode, count, pts, paint);
+    }
+    SkRect bounds;
+    bounds.set(pts, SkToInt(count));
+    SkRect storage;
+    const SkRect* localBounds = nullptr;
+    if (bounds.isFinite() && paint.canComputeFastBounds()) {
+        localBounds = &paint.computeFastStrokeBounds(bounds, &storage);
+    }
+    SkIRect devBounds;
+    if (this->computeDrawBounds(localBounds, paint, &devBounds)) {
+        SkPoint* ptsCopy = fAlloc.makeArrayDefault<SkPoint>(count);
+        memcpy(ptsCopy, pts, count * sizeof(SkPoint));
+        this->push(devBounds, [=](const SkDraw& draw, SkDAARecord*) {
+            draw.drawPoints(mode, count, ptsCopy, paint, nullptr);
+        });
+    }
+}
+
+void SkThreadedBMPDevice::drawRect(const SkRect& r, const SkPaint& paint) {
+    if (!this->canDefer()) {
+        return INHERITED::drawRect(r, paint);
+    }
+    SkIRect devBounds;
+    if (this->computeDrawBounds(&r, paint, &devBounds)) {
+        this->push(devBounds, [=](const SkDraw& draw, SkDAARecord*) {
+            draw.drawRect(r, paint);
+        });
+    }
+}
+
+// Can we compute this fill's coverage once (in the init phase) and blit it per tile?
+static bool can_init_once(const SkPaint& paint) {
+#if defined(SK_DISABLE_DAA)
+    return false;
+#else
+    return paint.isAntiAlias() &&
+           paint.getStyle() == SkPaint::kFill_Style &&
+           !paint.getPathEffect() &&
+           !paint.getMaskFilter();
+#endif
+}
+
+static bool can_init_once(const SkPath& path, const SkPaint& paint) {
+    return can_init_once(paint) &&
+           !SkPathPriv::IsBadForDAA(path) &&
+           path.countVerbs() >= kMinVerbsForInitOnce;
+}
+
+void SkThreadedBMPDevice::drawRRect(const SkRRect& rrect, const SkPaint& paint) {
+    if (!this->canDefer()) {
+        return INHERITED::drawRRect(rrect, paint);
+    }
+    if (can_init_once(paint)) {
+        // SkDraw would turn this into a path anyway; doing it here lets us share its coverage.
+        SkPath path;
+        path.addRRect(rrect);
+        return this->drawPath(path, paint, true);
+    }
+    SkIRect devBounds;
+    if (this->computeDrawBounds(&rrect.getBounds(), paint, &devBounds)) {
+        this->push(devBounds, [=](const SkDraw& draw, SkDAARecord*) {
+            draw.drawRRect(rrect, paint);
+        });
+    }
+}
+
+void SkThreadedBMPDevice::drawPath(const SkPath& path, const SkPaint& paint, bool pathIsMutable) {
+    if (!this->canDefer()) {
+        return INHERITED::drawPath(path, paint, pathIsMutable);
+    }
+    SkIRect devBounds;
+    const SkRect* localBounds = path.isInverseFillType() ? nullptr : &path.getBounds();
+    if (!this->computeDrawBounds(localBounds, paint, &devBounds)) {
+        return;
+    }
+
+    if (can_init_once(path, paint)) {
+        SkPath devPath;
+        path.transform(this->ctm(), &devPath);
+        if (devPath.isFinite() && !SkPathPriv::TooBigForMath(devPath)) {
+            auto initFn = [=](const SkDraw& draw, SkDAARecord* record) {
+                // Only the coverage is computed here; nothing is blitted until the draw phase.
+                SkNullBlitter nullBlitter;
+                SkScan::AntiFillPath(devPath, *draw.fRC, &nullBlitter, record);
+            };
+            auto drawFn = [=](const SkDraw& draw, SkDAARecord* record) {
+                SkAutoBlitterChoose blitter(draw, nullptr, paint);
+                SkScan::AntiFillPath(devPath, *draw.fRC, blitter.get(), record);
+            };
+            this->push(devBounds, std::move(drawFn), std::move(initFn));
+            return;
+        }
+    }
+
+    // The lambda owns its own copy of the path, so it's always safe to mutate.
+    this->push(devBounds, [=](const SkDraw& draw, SkDAARecord*) {
+        draw.drawPath(path, paint, nullptr, false);
+    });
+}
+
+void SkThreadedBMPDevice::drawBitmap(const SkBitmap& bitmap, const SkMatrix& matrix,
+                                     const SkRect* dstOrNull, const SkPaint& paint) {
+    // Mutable pixels may change before the queue is flushed, so draw those right away.
+    if (!this->canDefer() || !bitmap.isImmutable()) {
+        this->flush();
+        return INHERITED::drawBitmap(bitmap, matrix, dstOrNull, paint);
+    }
+    SkRect localBounds;
+    if (dstOrNull) {
+        localBounds = *dstOrNull;
+    } else {
+        matrix.mapRect(&localBounds, SkRect::MakeIWH(bitmap.width(), bitmap.height()));
+    }
+    SkIRect devBounds;
+    if (this->computeDrawBounds(&localBounds, paint, &devBounds)) {
+        SkRect dst = dstOrNull ? *dstOrNull : SkRect::MakeEmpty();
+        bool hasDst = dstOrNull != nullptr;
+        this->push(devBounds, [=](const SkDraw& draw, SkDAARecord*) {
+            draw.drawBitmap(bitmap, matrix, hasDst ? &dst : nullptr, paint);
+        });
+    }
+}
+
+void SkThreadedBMPDevice::drawSprite(const SkBitmap& bitmap, int x, int y, const SkPaint& paint) {
+    if (!this->canDefer() || !bitmap.isImmutable()) {
+        this->flush();
+        return INHERITED::drawSprite(bitmap, x, y, paint);
+    }
+    // Sprites ignore the CTM, so their bounds are already in device space.
+    SkIRect devBounds = SkIRect::MakeXYWH(x, y, bitmap.width(), bitmap.height());
+    if (devBounds.intersect(fRCStack.rc().getBounds())) {
+        this->push(devBounds, [=](const SkDraw& draw, SkDAARecord*) {
+            draw.drawSprite(bitmap, x, y, paint);
+        });
+    }
+}
+
+// The following draws reference data that is not ours to keep (glyph run buffers, vertices,
+// layer devices and special images), so they're drawn serially after flushing the queue.
+
+void SkThreadedBMPDevice::drawGlyphRunList(const SkGlyphRunList& glyphRunList) {
+    this->flush();
+    INHERITED::drawGlyphRunList(glyphRunList);
+}
+
+void SkThreadedBMPDevice::drawVertices(const SkVertices* vertices, const SkVertices::Bone bones[],
+                                       int boneCount, SkBlendMode bmode, const SkPaint& paint) {
+    this->flush();
+    INHERITED::drawVertices(vertices, bones, boneCount, bmode, paint);
+}
+
+void SkThreadedBMPDevice::drawDevice(SkBaseDevice* device, int x, int y, const SkPaint& paint) {
+    this->flush();
+    INHERITED::drawDevice(device, x, y, paint);
+}
+
+void SkThreadedBMPDevice::drawSpecial(SkSpecialImage* src, int x, int y, const SkPaint& paint,
+                                      SkImage* clipImage, const SkMatrix& clipMatrix) {
+    this->flush();
+    INHERITED::drawSpecial(src, x, y, paint, clipImage, clipMatrix);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+sk_sp<SkSpecialImage> SkThreadedBMPDevice::snapSpecial() {
+    this->flush();
+    return INHERITED::snapSpecial();
+}
+
+bool SkThreadedBMPDevice::onReadPixels(const SkPixmap& pm, int x, int y) {
+    this->flush();
+    return INHERITED::onReadPixels(pm, x, y);
+}
+
+bool SkThreadedBMPDevice::onWritePixels(const SkPixmap& pm, int x, int y) {
+    this->flush();
+    return INHERITED::onWritePixels(pm, x, y);
+}
+
+bool SkThreadedBMPDevice::onPeekPixels(SkPixmap* pmap) {
+    this->flush();
+    return INHERITED::onPeekPixels(pmap);
+}
+
+bool SkThreadedBMPDevice::onAccessPixels(SkPixmap* pmap) {
+    this->flush();
+    return INHERITED::onAccessPixels(pmap);
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkThreadedBMPDevice_DEFINED
+#define SkThreadedBMPDevice_DEFINED
+
+#include "SkArenaAlloc.h"
+#include "SkBitmapDevice.h"
+#include "SkCoverageDelta.h"
+#include "SkDraw.h"
+#include "SkExecutor.h"
+#include "SkRasterClip.h"
+#include "SkTArray.h"
+
+#include <functional>
+
+/**
+ *  A raster device that splits its pixels into horizontal tiles and rasterizes them concurrently
+ *  on an SkExecutor.
+ *
+ *  Draws are queued (with a snapshot of the matrix and clip) until flush(), or until something
+ *  needs to observe the pixels. A flush runs in two phases:
+ *    1. init: each queued anti-aliased path fill computes its coverage (SkDAARecord) once, with
+ *       all paths running in parallel.
+ *    2. draw: each tile replays the whole queue in order, clipped to its own rows, blitting the
+ *       precomputed coverage. Tiles never touch each other's pixels, so they run in parallel.
+ *
+ *  Draws that are not (yet) safe to defer, e.g. text and vertices, flush the queue and then draw
+ *  serially through SkBitmapDevice.
+ */
+class SkThreadedBMPDevice : public SkBitmapDevice {
+public:
+    // When threads = 0, we make the thread count equal to tiles. Otherwise it's threads.
+    // When executor = nullptr, we create and own a thread pool. Otherwise, the caller owns it.
+    SkThreadedBMPDevice(const SkBitmap& bitmap, int tiles, int threads = 0,
+                        SkExecutor* executor = nullptr);
+    SkThreadedBMPDevice(const SkBitmap& bitmap, const SkSurfaceProps& props, int tiles,
+                        int threads = 0, SkExecutor* executor = nullptr);
+    ~SkThreadedBMPDevice() override;
+
+    int tileCount() const { return fTileCnt; }
+
+    void flush() override;
+
+protected:
+    void drawPaint(const SkPaint& paint) override;
+    void drawPoints(SkCanvas::PointMode mode, size_t count,
+                    const SkPoint[], const SkPaint& paint) override;
+    void drawRect(const SkRect& r, const SkPaint& paint) override;
+    void drawRRect(const SkRRect& rr, const SkPaint& paint) override;
+    void drawPath(const SkPath&, const SkPaint&, bool pathIsMutable) override;
+    using SkBitmapDevice::drawBitmap;
+    void drawBitmap(const SkBitmap&, const SkMatrix&, const SkRect* dstOrNull,
+                    const SkPaint&) override;
+    void drawSprite(const SkBitmap&, int x, int y, const SkPaint&) override;
+
+    void drawGlyphRunList(const SkGlyphRunList& glyphRunList) override;
+    void drawVertices(const SkVertices*, const SkVertices::Bone bones[], int boneCount, SkBlendMode,
+                      const SkPaint& paint) override;
+    void drawDevice(SkBaseDevice*, int x, int y, const SkPaint&) override;
+    void drawSpecial(SkSpecialImage*, int x, int y, const SkPaint&,
+                     SkImage*, const SkMatrix&) override;
+
+    sk_sp<SkSpecialImage> snapSpecial() override;
+
+    bool onReadPixels(const SkPixmap&, int x, int y) override;
+    bool onWritePixels(const SkPixmap&, int x, int y) override;
+    bool onPeekPixels(SkPixmap*) override;
+    bool onAccessPixels(SkPixmap*) override;
+
+private:
+    // Called once per tile with an SkDraw whose clip is restricted to that tile.
+    // The SkDAARecord is non-null only if the element's coverage was computed in the init phase.
+    using DrawFn = std::function<void(const SkDraw&, SkDAARecord*)>;
+
+    // Called once per element before any tile is drawn, concurrently with other elements.
+    using InitFn = std::function<void(const SkDraw&, SkDAARecord*)>;
+
+    struct DrawElement {
+        SkIRect      fDrawBounds;   // conservative device-space bounds, already clipped
+        SkMatrix     fMatrix;
+        SkRasterClip fRC;
+        DrawFn       fDrawFn;
+        InitFn       fInitFn;       // optional
+        SkDAARecord* fDAARecord;    // non-null iff fInitFn is set
+    };
+
+    void init(int tiles, int threads, SkExecutor* executor);
+
+    // Returns false if draws must go straight to SkBitmapDevice instead of the queue.
+    bool canDefer() const;
+
+    // Returns false if the draw is clipped out entirely. localBounds may be null (unbounded).
+    bool computeDrawBounds(const SkRect* localBounds, const SkPaint&, SkIRect* devBounds) const;
+
+    void push(const SkIRect& devBounds, DrawFn drawFn, InitFn initFn = nullptr);
+
+    SkIRect tileBounds(int tile) const;
+
+    SkPixmap                    fRootPixmap;
+    int                         fTileCnt;
+    int                         fTileHeight;
+    std::unique_ptr<SkExecutor> fInternalExecutor;
+    SkExecutor*                 fExecutor;
+
+    SkTArray<DrawElement>       fQueue;
+    SkArenaAlloc                fAlloc{4096};   // copied draw data and DAA records; reset on flush
+
+    typedef SkBitmapDevice INHERITED;
+};
+
+#endif // SkThreadedBMPDevice_DEFINED
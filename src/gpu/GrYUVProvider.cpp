@@ -24,10 +24,15 @@
 sk_sp<SkCachedData> GrYUVProvider::getPlanes(SkYUVSizeInfo* size,
                                              SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
                                              SkYUVColorSpace* colorSpace,
-                                             const void* constPlanes[SkYUVSizeInfo::kMaxCount]) {
+                                             const void* constPlanes[SkYUVSizeInfo::kMaxCount],
+                                             const SkYUVDecodeOptions& options) {
     sk_sp<SkCachedData> data;
     SkYUVPlanesCache::Info yuvInfo;
-    data.reset(SkYUVPlanesCache::FindAndRef(this->onGetID(), &yuvInfo));
+    // The cache is keyed by ID alone, so it only holds the default planes.
+    const bool useCache = options.isDefault();
+    if (useCache) {
+        data.reset(SkYUVPlanesCache::FindAndRef(this->onGetID(), &yuvInfo));
+    }
 
     void* planes[SkYUVSizeInfo::kMaxCount];
 
@@ -47,7 +52,8 @@ sk_sp<SkCachedData> GrYUVProvider::getPlanes(SkYUVSizeInfo* size,
         }
     } else {
         // Fetch yuv plane sizes for memory allocation.
-        if (!this->onQueryYUVA8(&yuvInfo.fSizeInfo, yuvInfo.fYUVAIndices, &yuvInfo.fColorSpace)) {
+        if (!this->onQueryYUVA8(&yuvInfo.fSizeInfo, yuvInfo.fYUVAIndices, &yuvInfo.fColorSpace,
+                                options)) {
             return nullptr;
         }
 
@@ -77,12 +83,14 @@ sk_sp<SkCachedData> GrYUVProvider::getPlanes(SkYUVSizeInfo* size,
         }
 
         // Get the YUV planes.
-        if (!this->onGetYUVA8Planes(yuvInfo.fSizeInfo, yuvInfo.fYUVAIndices, planes)) {
+        if (!this->onGetYUVA8Planes(yuvInfo.fSizeInfo, yuvInfo.fYUVAIndices, planes, options)) {
             return nullptr;
         }
 
         // Decoding is done, cache the resulting YUV planes
-        SkYUVPlanesCache::Add(this->onGetID(), data.get(), &yuvInfo);
+        if (useCache) {
+            SkYUVPlanesCache::Add(this->onGetID(), data.get(), &yuvInfo);
+        }
     }
 
     *size = yuvInfo.fSizeInfo;
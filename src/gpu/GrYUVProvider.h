@@ -44,8 +44,13 @@ public:
                                             SkColorSpace* srcColorSpace,
                                             SkColorSpace* dstColorSpace);
 
+    /**
+     *  Returns the planes selected by options, decoding them if needed. Only the default, whole
+     *  planes are kept in the SkYUVPlanesCache.
+     */
     sk_sp<SkCachedData> getPlanes(SkYUVSizeInfo*, SkYUVAIndex[SkYUVAIndex::kIndexCount],
-                                  SkYUVColorSpace*, const void* planes[SkYUVSizeInfo::kMaxCount]);
+                                  SkYUVColorSpace*, const void* planes[SkYUVSizeInfo::kMaxCount],
+                                  const SkYUVDecodeOptions& options = SkYUVDecodeOptions());
 
 private:
     virtual uint32_t onGetID() const = 0;
@@ -60,10 +65,12 @@ private:
      *                     allocation widths of the Y, U, V, and A planes.
      *  @param yuvaIndices How the YUVA planes are used/organized
      *  @param colorSpace  Output parameter.
+     *  @param options     The scaled size and subset of the planes.
      */
     virtual bool onQueryYUVA8(SkYUVSizeInfo* sizeInfo,
                               SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
-                              SkYUVColorSpace* colorSpace) const = 0;
+                              SkYUVColorSpace* colorSpace,
+                              const SkYUVDecodeOptions& options) const = 0;
 
     /**
      *  Returns true on success and false on failure.
@@ -75,10 +82,12 @@ private:
      *                     recommendation (but not smaller).
      *  @param yuvaIndices How the YUVA planes are used/organized
      *  @param planes      Memory for each of the Y, U, V, and A planes.
+     *  @param options     Needs to match the options passed to the query.
      */
     virtual bool onGetYUVA8Planes(const SkYUVSizeInfo& sizeInfo,
                                   const SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
-                                  void* planes[]) = 0;
+                                  void* planes[],
+                                  const SkYUVDecodeOptions& options) = 0;
 
     // This is used as release callback for the YUV data that we capture in an SkImage when
     // uploading to a gpu. When the upload is complete and we release the SkImage this callback will
@@ -221,7 +221,8 @@ bool SkImage::asLegacyBitmap(SkBitmap* bitmap, LegacyBitmapMode ) const {
 }
 
 sk_sp<SkCachedData> SkImage_Base::getPlanes(SkYUVSizeInfo*, SkYUVAIndex[4],
-                                            SkYUVColorSpace*, const void*[4]) {
+                                            SkYUVColorSpace*, const void*[4],
+                                            const SkYUVDecodeOptions&) {
     return nullptr;
 }
 
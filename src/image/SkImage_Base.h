@@ -10,6 +10,7 @@
 
 #include "SkImage.h"
 #include "SkSurface.h"
+#include "SkYUVSizeInfo.h"
 #include <atomic>
 
 #if SK_SUPPORT_GPU
@@ -23,7 +24,6 @@ class GrTexture;
 
 class GrSamplerState;
 class SkCachedData;
-struct SkYUVSizeInfo;
 
 enum {
     kNeedNewImageUniqueID = 0
@@ -70,8 +70,11 @@ public:
 
     virtual sk_sp<SkImage> onMakeSubset(const SkIRect&) const = 0;
 
+    // Returns the YUV planes selected by options, which refer to the whole image of the
+    // generator, or nullptr if they can not be produced without decoding to RGB.
     virtual sk_sp<SkCachedData> getPlanes(SkYUVSizeInfo*, SkYUVAIndex[4],
-                                          SkYUVColorSpace*, const void* planes[4]);
+                                          SkYUVColorSpace*, const void* planes[4],
+                                          const SkYUVDecodeOptions& = SkYUVDecodeOptions());
     virtual sk_sp<SkData> onRefEncoded() const { return nullptr; }
 
     virtual bool onAsLegacyBitmap(SkBitmap*) const;
@@ -298,13 +298,15 @@ private:
     uint32_t onGetID() const override { return fGen->uniqueID(); }
     bool onQueryYUVA8(SkYUVSizeInfo* sizeInfo,
                       SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
-                      SkYUVColorSpace* colorSpace) const override {
-        return fGen->queryYUVA8(sizeInfo, yuvaIndices, colorSpace);
+                      SkYUVColorSpace* colorSpace,
+                      const SkYUVDecodeOptions& options) const override {
+        return fGen->queryYUVA8(sizeInfo, yuvaIndices, colorSpace, options);
     }
     bool onGetYUVA8Planes(const SkYUVSizeInfo& sizeInfo,
                           const SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
-                          void* planes[]) override {
-        return fGen->getYUVA8Planes(sizeInfo, yuvaIndices, planes);
+                          void* planes[],
+                          const SkYUVDecodeOptions& options) override {
+        return fGen->getYUVA8Planes(sizeInfo, yuvaIndices, planes, options);
     }
 
     SkImageGenerator* fGen;
@@ -332,11 +334,13 @@ static void set_key_on_proxy(GrProxyProvider* proxyProvider,
 sk_sp<SkCachedData> SkImage_Lazy::getPlanes(SkYUVSizeInfo* yuvaSizeInfo,
                                             SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
                                             SkYUVColorSpace* yuvColorSpace,
-                                            const void* planes[SkYUVSizeInfo::kMaxCount]) {
+                                            const void* planes[SkYUVSizeInfo::kMaxCount],
+                                            const SkYUVDecodeOptions& options) {
     ScopedGenerator generator(fSharedGenerator);
     Generator_GrYUVProvider provider(generator);
 
-    sk_sp<SkCachedData> data = provider.getPlanes(yuvaSizeInfo, yuvaIndices, yuvColorSpace, planes);
+    sk_sp<SkCachedData> data = provider.getPlanes(yuvaSizeInfo, yuvaIndices, yuvColorSpace, planes,
+                                                  options);
     if (!data) {
         return nullptr;
     }
@@ -10,14 +10,19 @@
 #ifdef SK_HAS_PNG_LIBRARY
 
 #include "SkColorTable.h"
+#include "SkExecutor.h"
 #include "SkImageEncoderFns.h"
 #include "SkImageInfoPriv.h"
 #include "SkStream.h"
 #include "SkString.h"
 #include "SkPngEncoder.h"
 #include "SkPngPriv.h"
+#include "SkTaskGroup.h"
+
+#include <atomic>
 
 #include "png.h"
+#include "zlib.h"
 
 static_assert(PNG_FILTER_NONE  == (int)SkPngEncoder::FilterFlag::kNone,  "Skia libpng filter err.");
 static_assert(PNG_FILTER_SUB   == (int)SkPngEncoder::FilterFlag::kSub,   "Skia libpng filter err.");
@@ -43,6 +48,21 @@ static void sk_write_fn(png_structp png_ptr, png_bytep data, png_size_t len) {
     }
 }
 
+namespace {
+
+// A band of rows, filtered and deflated independently of the other bands.
+struct PngBand {
+    int                    fTop;
+    int                    fBottom;
+    SkAutoTMalloc<uint8_t> fFiltered;       // filter type byte + filtered bytes, for each row
+    size_t                 fFilteredSize;
+    SkAutoTMalloc<uint8_t> fDeflated;       // raw deflate data, ending on a byte boundary
+    size_t                 fDeflatedSize;
+    uLong                  fAdler;          // adler32 of fFiltered
+};
+
+}  // namespace
+
 class SkPngEncoderMgr final : SkNoncopyable {
 public:
 
@@ -61,6 +81,14 @@ public:
     png_infop infoPtr() { return fInfoPtr; }
     int pngBytesPerPixel() const { return fPngBytesPerPixel; }
     transform_scanline_proc proc() const { return fProc; }
+    SkExecutor* executor() const { return fExecutor; }
+
+    /*
+     * Filters and deflates rows [startRow, startRow + numRows) of src in bands on executor(),
+     * and writes them as IDAT chunks, bypassing libpng's own compression.  After the last row,
+     * this also writes IEND.
+     */
+    bool writeRowsInParallel(const SkPixmap& src, int startRow, int numRows);
 
     ~SkPngEncoderMgr() {
         png_destroy_write_struct(&fPngPtr, &fInfoPtr);
@@ -71,12 +99,30 @@ private:
     SkPngEncoderMgr(png_structp pngPtr, png_infop infoPtr)
         : fPngPtr(pngPtr)
         , fInfoPtr(infoPtr)
+        , fExecutor(nullptr)
+        , fStripFiller(false)
+        , fAdler(adler32(0L, Z_NULL, 0))
+        , fWindowSize(0)
     {}
 
+    void transformRow(const SkPixmap& src, int y, uint8_t* dst) const;
+    void filterBand(const SkPixmap& src, PngBand* band) const;
+    bool deflateBand(const PngBand bands[], int index, bool finish) const;
+    bool writeIDAT(PngBand bands[], int count, bool first, bool last);
+
     png_structp             fPngPtr;
     png_infop               fInfoPtr;
     int                     fPngBytesPerPixel;
     transform_scanline_proc fProc;
+
+    // Only used when encoding in parallel.
+    SkExecutor*             fExecutor;
+    int                     fFilters;
+    int                     fZLibLevel;
+    bool                    fStripFiller;   // see png_set_filler() in writeInfo()
+    uLong                   fAdler;         // of all the filtered data written so far
+    SkAutoTMalloc<uint8_t>  fWindow;        // the last fWindowSize (up to 32K) bytes of
+    size_t                  fWindowSize;    // filtered data written, at the end of fWindow
 };
 
 std::unique_ptr<SkPngEncoderMgr> SkPngEncoderMgr::Make(SkWStream* stream) {
@@ -199,6 +245,11 @@ bool SkPngEncoderMgr::setHeader(const SkImageInfo& srcInfo, const SkPngEncoder::
     SkASSERT(zlibLevel == options.fZLibLevel);
     png_set_compression_level(fPngPtr, zlibLevel);
 
+    fExecutor = options.fExecutor;
+    // png_set_filter() maps kZero (PNG_FILTER_VALUE_NONE) to PNG_FILTER_NONE, so match it here.
+    fFilters = filters ? filters : PNG_FILTER_NONE;
+    fZLibLevel = zlibLevel;
+
     // Set comments in tEXt chunk
     const sk_sp<SkDataTable>& comments = options.fComments;
     if (comments != nullptr) {
@@ -358,6 +409,7 @@ bool SkPngEncoderMgr::writeInfo(const SkImageInfo& srcInfo) {
         // For kOpaque, kRGBA_F16, we will keep the row as RGBA and tell libpng
         // to skip the alpha channel.
         png_set_filler(fPngPtr, 0, PNG_FILLER_AFTER);
+        fStripFiller = true;
     }
 
     return true;
@@ -367,6 +419,306 @@ void SkPngEncoderMgr::chooseProc(const SkImageInfo& srcInfo) {
     fProc = choose_proc(srcInfo);
 }
 
+// Each band is about this many bytes of filtered data.  The deflate window is 32K, so priming
+// with the previous band's last 32K loses little compression at this size.
+static constexpr size_t kPngBandBytes   = 128 * 1024;
+static constexpr size_t kZLibWindowSize = 32 * 1024;
+
+// Bounds the memory used by one wave of bands, and the size of each IDAT chunk.
+static constexpr int kMaxPngBandsPerWave = 64;
+
+static inline int paeth_predictor(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = SkTAbs(p - a),
+        pb = SkTAbs(p - b),
+        pc = SkTAbs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return a;
+    }
+    return pb <= pc ? b : c;
+}
+
+/*
+ * Writes the filter type byte for type (a PNG_FILTER_VALUE_*), followed by row filtered against
+ * prior, the previous unfiltered row.
+ */
+static void apply_filter(int type, const uint8_t* row, const uint8_t* prior, size_t rowBytes,
+                         size_t bpp, uint8_t* dst) {
+    *dst++ = SkToU8(type);
+    switch (type) {
+        case PNG_FILTER_VALUE_NONE:
+            memcpy(dst, row, rowBytes);
+            break;
+        case PNG_FILTER_VALUE_SUB:
+            for (size_t i = 0; i < rowBytes; i++) {
+                dst[i] = row[i] - (i >= bpp ? row[i - bpp] : 0);
+            }
+            break;
+        case PNG_FILTER_VALUE_UP:
+            for (size_t i = 0; i < rowBytes; i++) {
+                dst[i] = row[i] - prior[i];
+            }
+            break;
+        case PNG_FILTER_VALUE_AVG:
+            for (size_t i = 0; i < rowBytes; i++) {
+                dst[i] = row[i] - (((i >= bpp ? row[i - bpp] : 0) + prior[i]) >> 1);
+            }
+            break;
+        case PNG_FILTER_VALUE_PAETH:
+            for (size_t i = 0; i < rowBytes; i++) {
+                dst[i] = row[i] - (i >= bpp ? paeth_predictor(row[i - bpp], prior[i],
+                                                              prior[i - bpp])
+                                            : prior[i]);
+            }
+            break;
+        default:
+            SkASSERT(false);
+            break;
+    }
+}
+
+/*
+ * Filters row with the filter chosen from filters (SkPngEncoder::FilterFlags).  Like libpng, when
+ * several filters are allowed, picks the one whose output has the smallest sum of absolute
+ * values (as signed bytes).  scratch must hold rowBytes + 1 bytes.
+ */
+static void filter_row(int filters, const uint8_t* row, const uint8_t* prior, size_t rowBytes,
+                       size_t bpp, uint8_t* dst, uint8_t* scratch) {
+    if (0 == (filters & (filters - 1))) {
+        int type = PNG_FILTER_VALUE_NONE;
+        while (filters > (PNG_FILTER_NONE << type)) {
+            type++;
+        }
+        apply_filter(type, row, prior, rowBytes, bpp, dst);
+        return;
+    }
+
+    size_t bestCost = SIZE_MAX;
+    for (int type = PNG_FILTER_VALUE_NONE; type < PNG_FILTER_VALUE_LAST; type++) {
+        if (!(filters & (PNG_FILTER_NONE << type))) {
+            continue;
+        }
+        apply_filter(type, row, prior, rowBytes, bpp, scratch);
+        size_t cost = 0;
+        for (size_t i = 1; i <= rowBytes; i++) {
+            cost += SkTAbs((int) (int8_t) scratch[i]);
+        }
+        if (cost < bestCost) {
+            bestCost = cost;
+            memcpy(dst, scratch, rowBytes + 1);
+        }
+    }
+}
+
+void SkPngEncoderMgr::transformRow(const SkPixmap& src, int y, uint8_t* dst) const {
+    fProc((char*) dst, (const char*) src.addr(0, y), src.width(),
+          SkColorTypeBytesPerPixel(src.colorType()), nullptr);
+    if (fStripFiller) {
+        // Do what png_set_filler() does for libpng: drop the trailing 16-bit alpha.
+        for (int x = 0; x < src.width(); x++) {
+            memmove(dst + 6 * x, dst + 8 * x, 6);
+        }
+    }
+}
+
+void SkPngEncoderMgr::filterBand(const SkPixmap& src, PngBand* band) const {
+    const size_t rowBytes = png_get_rowbytes(fPngPtr, fInfoPtr);
+    const size_t bpp = png_get_channels(fPngPtr, fInfoPtr) *
+                       png_get_bit_depth(fPngPtr, fInfoPtr) / 8;
+
+    // The transform procs may write more than rowBytes, e.g. the filler for opaque F16.
+    const size_t transformBytes = SkTMax(rowBytes, (size_t) fPngBytesPerPixel * src.width());
+    SkAutoTMalloc<uint8_t> storage(2 * transformBytes + rowBytes + 1);
+    uint8_t* prior = storage.get();
+    uint8_t* row = prior + transformBytes;
+    uint8_t* scratch = row + transformBytes;
+
+    // Filters look at the previous row, so transform it too.  The first row has none.
+    if (band->fTop > 0) {
+        this->transformRow(src, band->fTop - 1, prior);
+    } else {
+        sk_bzero(prior, rowBytes);
+    }
+
+    band->fFilteredSize = (band->fBottom - band->fTop) * (rowBytes + 1);
+    band->fFiltered.reset(band->fFilteredSize);
+    uint8_t* dst = band->fFiltered.get();
+    for (int y = band->fTop; y < band->fBottom; y++) {
+        this->transformRow(src, y, row);
+        filter_row(fFilters, row, prior, rowBytes, bpp, dst, scratch);
+        dst += rowBytes + 1;
+        std::swap(prior, row);
+    }
+
+    band->fAdler = adler32(adler32(0L, Z_NULL, 0), band->fFiltered.get(),
+                           SkToUInt(band->fFilteredSize));
+}
+
+bool SkPngEncoderMgr::deflateBand(const PngBand bands[], int index, bool finish) const {
+    PngBand* band = const_cast<PngBand*>(&bands[index]);
+
+    // Prime the window with the filtered data that precedes this band, as if a single deflate
+    // stream had compressed everything.  It may span earlier bands and earlier waves.
+    SkAutoTMalloc<uint8_t> dictionary(kZLibWindowSize);
+    size_t dictionaryStart = kZLibWindowSize;
+    for (int i = index - 1; i >= 0 && dictionaryStart > 0; i--) {
+        size_t n = SkTMin(dictionaryStart, bands[i].fFilteredSize);
+        memcpy(dictionary.get() + dictionaryStart - n,
+               bands[i].fFiltered.get() + bands[i].fFilteredSize - n, n);
+        dictionaryStart -= n;
+    }
+    if (dictionaryStart > 0) {
+        size_t n = SkTMin(dictionaryStart, fWindowSize);
+        memcpy(dictionary.get() + dictionaryStart - n, fWindow.get() + kZLibWindowSize - n, n);
+        dictionaryStart -= n;
+    }
+
+    // Raw deflate, since each band is only a piece of the zlib stream.  Match libpng's choice of
+    // strategy.
+    const int strategy = (int) SkPngEncoder::FilterFlag::kNone == fFilters ? Z_DEFAULT_STRATEGY
+                                                                            : Z_FILTERED;
+    z_stream stream;
+    sk_bzero(&stream, sizeof(stream));
+    if (Z_OK != deflateInit2(&stream, fZLibLevel, Z_DEFLATED, -MAX_WBITS, 8, strategy)) {
+        return false;
+    }
+
+    bool success = kZLibWindowSize == dictionaryStart ||
+                   Z_OK == deflateSetDictionary(&stream, dictionary.get() + dictionaryStart,
+                                                SkToUInt(kZLibWindowSize - dictionaryStart));
+
+    // Every band but the last ends with a sync flush, which leaves the stream unfinished but
+    // byte aligned, so that the next band's data can simply be appended.
+    const int flush = finish ? Z_FINISH : Z_SYNC_FLUSH;
+    size_t capacity = deflateBound(&stream, band->fFilteredSize) + 16;
+    band->fDeflated.reset(capacity);
+    stream.next_in = band->fFiltered.get();
+    stream.avail_in = SkToUInt(band->fFilteredSize);
+    stream.next_out = band->fDeflated.get();
+    stream.avail_out = SkToUInt(capacity);
+    while (success) {
+        int result = deflate(&stream, flush);
+        if (Z_STREAM_ERROR == result) {
+            success = false;
+        } else if (finish ? Z_STREAM_END == result
+                          : (0 == stream.avail_in && 0 != stream.avail_out)) {
+            break;
+        } else {
+            // Out of space.
+            size_t used = capacity - stream.avail_out;
+            capacity *= 2;
+            band->fDeflated.realloc(capacity);
+            stream.next_out = band->fDeflated.get() + used;
+            stream.avail_out = SkToUInt(capacity - used);
+        }
+    }
+
+    band->fDeflatedSize = capacity - stream.avail_out;
+    deflateEnd(&stream);
+    return success;
+}
+
+bool SkPngEncoderMgr::writeIDAT(PngBand bands[], int count, bool first, bool last) {
+    if (setjmp(png_jmpbuf(fPngPtr))) {
+        return false;
+    }
+
+    // The zlib header: a 32K deflate window, and the level as zlib would report it.
+    uint8_t header[2] = { 0x78, 0 };
+    header[1] = (fZLibLevel < 2 ? 0 : fZLibLevel < 6 ? 1 : 6 == fZLibLevel ? 2 : 3) << 6;
+    header[1] += 31 - ((header[0] << 8) + header[1]) % 31;
+
+    size_t length = first ? sizeof(header) : 0;
+    for (int i = 0; i < count; i++) {
+        length += bands[i].fDeflatedSize;
+    }
+    length += last ? 4 : 0;
+
+    png_write_chunk_start(fPngPtr, (png_const_bytep) "IDAT", SkToU32(length));
+    if (first) {
+        png_write_chunk_data(fPngPtr, header, sizeof(header));
+    }
+    for (int i = 0; i < count; i++) {
+        png_write_chunk_data(fPngPtr, bands[i].fDeflated.get(), bands[i].fDeflatedSize);
+        fAdler = adler32_combine(fAdler, bands[i].fAdler, bands[i].fFilteredSize);
+    }
+    if (last) {
+        uint8_t adler[4] = { SkToU8(fAdler >> 24), SkToU8((fAdler >> 16) & 0xFF),
+                             SkToU8((fAdler >>  8) & 0xFF), SkToU8(fAdler & 0xFF) };
+        png_write_chunk_data(fPngPtr, adler, sizeof(adler));
+    }
+    png_write_chunk_end(fPngPtr);
+
+    if (last) {
+        png_write_chunk(fPngPtr, (png_const_bytep) "IEND", nullptr, 0);
+    }
+    return true;
+}
+
+bool SkPngEncoderMgr::writeRowsInParallel(const SkPixmap& src, int startRow, int numRows) {
+    SkASSERT(fExecutor);
+    const size_t filteredRowBytes = png_get_rowbytes(fPngPtr, fInfoPtr) + 1;
+    const int rowsPerBand = SkTMax(1, SkToInt(kPngBandBytes / filteredRowBytes));
+    const int endRow = startRow + numRows;
+
+    if (!fWindow.get()) {
+        fWindow.reset(kZLibWindowSize);
+    }
+
+    SkTaskGroup taskGroup(*fExecutor);
+    for (int waveTop = startRow; waveTop < endRow;) {
+        const int bandCount = SkTMin(kMaxPngBandsPerWave,
+                                     (endRow - waveTop + rowsPerBand - 1) / rowsPerBand);
+        const int waveBottom = SkTMin(endRow, waveTop + bandCount * rowsPerBand);
+        const bool last = waveBottom == src.height();
+
+        // Filtering only reads src, so every band can run at once.  Deflating needs the filtered
+        // data of the bands before it, so it waits for all of the filtering.
+        SkAutoTArray<PngBand> bands(bandCount);
+        taskGroup.batch(bandCount, [&](int i) {
+            bands[i].fTop = waveTop + i * rowsPerBand;
+            bands[i].fBottom = SkTMin(bands[i].fTop + rowsPerBand, waveBottom);
+            this->filterBand(src, &bands[i]);
+        });
+        taskGroup.wait();
+
+        std::atomic<bool> success{true};
+        taskGroup.batch(bandCount, [&](int i) {
+            if (!this->deflateBand(bands.get(), i, last && i == bandCount - 1)) {
+                success = false;
+            }
+        });
+        taskGroup.wait();
+
+        if (!success || !this->writeIDAT(bands.get(), bandCount, 0 == waveTop, last)) {
+            return false;
+        }
+
+        // Keep the end of this wave, after whatever is left of the old window, to prime the
+        // next one.
+        size_t waveBytes = 0;
+        for (int i = 0; i < bandCount; i++) {
+            waveBytes += bands[i].fFilteredSize;
+        }
+        const size_t newBytes = SkTMin(waveBytes, kZLibWindowSize);
+        const size_t keptBytes = SkTMin(fWindowSize, kZLibWindowSize - newBytes);
+        memmove(fWindow.get() + kZLibWindowSize - newBytes - keptBytes,
+                fWindow.get() + kZLibWindowSize - keptBytes, keptBytes);
+        size_t windowStart = kZLibWindowSize;
+        for (int i = bandCount - 1; i >= 0 && windowStart > kZLibWindowSize - newBytes; i--) {
+            size_t n = SkTMin(windowStart - (kZLibWindowSize - newBytes), bands[i].fFilteredSize);
+            windowStart -= n;
+            memcpy(fWindow.get() + windowStart,
+                   bands[i].fFiltered.get() + bands[i].fFilteredSize - n, n);
+        }
+        fWindowSize = newBytes + keptBytes;
+
+        waveTop = waveBottom;
+    }
+
+    return true;
+}
+
 std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream* dst, const SkPixmap& src,
                                               const Options& options) {
     if (!SkPixmapIsValid(src)) {
@@ -403,6 +755,14 @@ SkPngEncoder::SkPngEncoder(std::unique_ptr<SkPngEncoderMgr> encoderMgr, const Sk
 SkPngEncoder::~SkPngEncoder() {}
 
 bool SkPngEncoder::onEncodeRows(int numRows) {
+    if (fEncoderMgr->executor()) {
+        if (!fEncoderMgr->writeRowsInParallel(fSrc, fCurrRow, numRows)) {
+            return false;
+        }
+        fCurrRow += numRows;
+        return true;
+    }
+
     if (setjmp(png_jmpbuf(fEncoderMgr->pngPtr()))) {
         return false;
     }
@@ -38,6 +38,24 @@ void blit_row_color32(SkPMColor* dst, const SkPMColor* src, int count, SkPMColor
     });
 }
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+
+// The same math as SkPMSrcOver_SSE2(), 16 pixels at a time.
+static inline __m512i SkPMSrcOver_SKX(const __m512i& src, const __m512i& dst) {
+    const __m512i mask = _mm512_set1_epi32(0x00FF00FF);
+
+    // Duplicate each pixel's 256 - alpha into both of its 16-bit halves.
+    __m512i scale = _mm512_sub_epi32(_mm512_set1_epi32(256), _mm512_srli_epi32(src, 24));
+    scale = _mm512_or_si512(_mm512_slli_epi32(scale, 16), scale);
+
+    __m512i rb = _mm512_srli_epi16(_mm512_mullo_epi16(_mm512_and_si512(mask, dst), scale), 8),
+            ag = _mm512_andnot_si512(mask, _mm512_mullo_epi16(_mm512_srli_epi16(dst, 8), scale));
+
+    return _mm512_add_epi32(src, _mm512_or_si512(rb, ag));
+}
+
+#endif
+
 #if defined(SK_ARM_HAS_NEON)
 
 // Return a uint8x8_t value, r, computed as r[i] = SkMulDiv255Round(x[i], y[i]), where r[i], x[i],
@@ -82,7 +100,29 @@ void blit_row_s32a_opaque(SkPMColor* dst, const SkPMColor* src, int len, U8CPU a
     SkASSERT(alpha == 0xFF);
     sk_msan_assert_initialized(src, src+len);
 
-#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE41
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    const __m512i alphaMask = _mm512_set1_epi32(0xFF000000);
+    while (len >= 16) {
+        __m512i s = _mm512_loadu_si512(src);
+
+        // One mask bit per pixel, set where that pixel's alpha is non-zero / 0xFF.
+        __mmask16 visible = _mm512_test_epi32_mask(s, alphaMask),
+                  opaque  = _mm512_cmpeq_epi32_mask(_mm512_and_si512(s, alphaMask), alphaMask);
+
+        if (visible == 0) {
+            // All 16 source pixels are transparent.  Nothing to do.
+        } else if (opaque == 0xFFFF) {
+            // All 16 source pixels are opaque.  SrcOver becomes Src.
+            _mm512_storeu_si512(dst, s);
+        } else {
+            _mm512_storeu_si512(dst, SkPMSrcOver_SKX(s, _mm512_loadu_si512(dst)));
+        }
+        src += 16;
+        dst += 16;
+        len -= 16;
+    }
+
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE41
     while (len >= 16) {
         // Load 16 source pixels.
         auto s0 = _mm_loadu_si128((const __m128i*)(src) + 0),
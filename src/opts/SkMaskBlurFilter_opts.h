@@ -0,0 +1,154 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMaskBlurFilter_opts_DEFINED
+#define SkMaskBlurFilter_opts_DEFINED
+
+#include "SkNx.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace SK_OPTS_NS {
+
+// The large sigma blur in SkMaskBlurFilter slides three box filters along each line of the mask.
+// Each step depends on the one before it, so instead of vectorizing along a line we run eight
+// lines side by side, one per lane. Lines are read in 8x8 blocks that are transposed so that each
+// column of the block feeds one step, and because the output of a pass is stored transposed, the
+// eight results of a step land in eight adjacent bytes of a dst row.
+
+using Sk8u = SkNx<8, uint32_t>;
+
+// Writes column x of the n columns starting at src to the 8 bytes at dst + 8*x.
+static inline void transpose_8_lines(const uint8_t* src, size_t srcRB, int n, uint8_t dst[64]) {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    if (n == 8) {
+        auto row = [&](int y) { return _mm_loadl_epi64((const __m128i*)(src + y * srcRB)); };
+
+        __m128i r01 = _mm_unpacklo_epi8(row(0), row(1)),
+                r23 = _mm_unpacklo_epi8(row(2), row(3)),
+                r45 = _mm_unpacklo_epi8(row(4), row(5)),
+                r67 = _mm_unpacklo_epi8(row(6), row(7));
+
+        __m128i c03lo = _mm_unpacklo_epi16(r01, r23),   // columns 0-3 of lines 0-3
+                c47lo = _mm_unpackhi_epi16(r01, r23),   // columns 4-7 of lines 0-3
+                c03hi = _mm_unpacklo_epi16(r45, r67),   // columns 0-3 of lines 4-7
+                c47hi = _mm_unpackhi_epi16(r45, r67);   // columns 4-7 of lines 4-7
+
+        _mm_storeu_si128((__m128i*)(dst +  0), _mm_unpacklo_epi32(c03lo, c03hi));
+        _mm_storeu_si128((__m128i*)(dst + 16), _mm_unpackhi_epi32(c03lo, c03hi));
+        _mm_storeu_si128((__m128i*)(dst + 32), _mm_unpacklo_epi32(c47lo, c47hi));
+        _mm_storeu_si128((__m128i*)(dst + 48), _mm_unpackhi_epi32(c47lo, c47hi));
+        return;
+    }
+#endif
+    for (int y = 0; y < 8; y++) {
+        for (int x = 0; x < n; x++) {
+            dst[8*x + y] = src[y * srcRB + x];
+        }
+    }
+}
+
+static inline Sk8u load_column(const uint8_t column[8]) {
+    return { SkNx_cast<uint32_t>(Sk4b::Load(column + 0)),
+             SkNx_cast<uint32_t>(Sk4b::Load(column + 4)) };
+}
+
+// Computes (weight * sum + 2^31) >> 32 per lane without 64-bit lanes: the high half of the
+// product, plus one if rounding the low half carries into it.
+static inline void store_scaled(uint8_t* dst, const Sk8u& sum, const Sk8u& weight) {
+    Sk8u scaled = sum.mulHi(weight) + ((sum * weight) >> 31);
+    SkNx_cast<uint8_t>(scaled.fLo).store(dst + 0);
+    SkNx_cast<uint8_t>(scaled.fHi).store(dst + 4);
+}
+
+// Blurs the 8 lines of srcW bytes at src (srcRB apart), producing dstW values per line. Value x
+// of line i is written to dst[x * dstRB + i]. The pass sizes and weight are the ones of
+// PlanGauss in SkMaskBlurFilter.cpp; every pass must be at least one wide. buffer must hold
+// 8 * (pass0Size + pass1Size + pass2Size) values.
+static void blur_lines_8(const uint8_t src[], size_t srcRB, int srcW,
+                         uint8_t dst[], size_t dstRB, int dstW,
+                         uint32_t weight, int pass0Size, int pass1Size, int pass2Size,
+                         uint32_t buffer[]) {
+    SkASSERT(pass0Size > 0 && pass1Size > 0 && pass2Size > 0);
+
+    uint32_t* buffer0    = buffer;
+    uint32_t* buffer0End = buffer0 + 8 * pass0Size;
+    uint32_t* buffer1    = buffer0End;
+    uint32_t* buffer1End = buffer1 + 8 * pass1Size;
+    uint32_t* buffer2    = buffer1End;
+    uint32_t* buffer2End = buffer2 + 8 * pass2Size;
+
+    const Sk8u w{weight};
+    Sk8u sum0, sum1, sum2;
+    uint32_t *cursor0, *cursor1, *cursor2;
+
+    auto reset = [&] {
+        std::memset(buffer, 0, (buffer2End - buffer0) * sizeof(*buffer));
+        sum0 = sum1 = sum2 = Sk8u{0};
+        cursor0 = buffer0;
+        cursor1 = buffer1;
+        cursor2 = buffer2;
+    };
+
+    auto step = [&](const Sk8u& leadingEdge, uint8_t* out) {
+        sum0 = sum0 + leadingEdge;
+        sum1 = sum1 + sum0;
+        sum2 = sum2 + sum1;
+
+        store_scaled(out, sum2, w);
+
+        sum2 = sum2 - Sk8u::Load(cursor2);
+        sum1.store(cursor2);
+        cursor2 = (cursor2 + 8) < buffer2End ? cursor2 + 8 : buffer2;
+
+        sum1 = sum1 - Sk8u::Load(cursor1);
+        sum0.store(cursor1);
+        cursor1 = (cursor1 + 8) < buffer1End ? cursor1 + 8 : buffer1;
+
+        sum0 = sum0 - Sk8u::Load(cursor0);
+        leadingEdge.store(cursor0);
+        cursor0 = (cursor0 + 8) < buffer0End ? cursor0 + 8 : buffer0;
+    };
+
+    uint8_t columns[64];
+
+    // Consume the source generating values.
+    reset();
+    uint8_t* dstCursor = dst;
+    for (int x = 0; x < srcW; x += 8) {
+        int n = std::min(8, srcW - x);
+        transpose_8_lines(src + x, srcRB, n, columns);
+        for (int i = 0; i < n; i++) {
+            step(load_column(columns + 8*i), dstCursor);
+            dstCursor += dstRB;
+        }
+    }
+
+    // The leading edge is off the end of the lines. The sliding window is dstW - srcW + 1 wide.
+    int noChangeCount = std::max(0, std::min(dstW - srcW, dstW - srcW + 1 - srcW));
+    for (int i = 0; i < noChangeCount; i++) {
+        step(Sk8u{0}, dstCursor);
+        dstCursor += dstRB;
+    }
+
+    // Starting from the end, fill in the rest of the values.
+    reset();
+    uint8_t* dstEnd = dst + dstW * dstRB;
+    for (int x = srcW; x > 0 && dstEnd > dstCursor; x -= 8) {
+        int n = std::min(8, x);
+        transpose_8_lines(src + x - n, srcRB, n, columns);
+        for (int i = n - 1; i >= 0 && dstEnd > dstCursor; i--) {
+            dstEnd -= dstRB;
+            step(load_column(columns + 8*i), dstEnd);
+        }
+    }
+}
+
+}  // namespace SK_OPTS_NS
+
+#endif//SkMaskBlurFilter_opts_DEFINED
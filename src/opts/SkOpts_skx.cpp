@@ -0,0 +1,51 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkOpts.h"
+
+#define SK_OPTS_NS skx
+#include "SkBlitRow_opts.h"
+#include "SkMaskBlurFilter_opts.h"
+#include "SkRasterPipeline_opts.h"
+#include "SkSwizzler_opts.h"
+#include "SkUtils_opts.h"
+
+namespace SkOpts {
+    void Init_skx() {
+        memset16 = SK_OPTS_NS::memset16;
+        memset32 = SK_OPTS_NS::memset32;
+        memset64 = SK_OPTS_NS::memset64;
+
+        blit_row_color32     = SK_OPTS_NS::blit_row_color32;
+        blit_row_s32a_opaque = SK_OPTS_NS::blit_row_s32a_opaque;
+
+        blur_lines_8 = SK_OPTS_NS::blur_lines_8;
+
+        RGBA_to_BGRA          = SK_OPTS_NS::RGBA_to_BGRA;
+        RGBA_to_rgbA          = SK_OPTS_NS::RGBA_to_rgbA;
+        RGBA_to_bgrA          = SK_OPTS_NS::RGBA_to_bgrA;
+        RGB_to_RGB1           = SK_OPTS_NS::RGB_to_RGB1;
+        RGB_to_BGR1           = SK_OPTS_NS::RGB_to_BGR1;
+        gray_to_RGB1          = SK_OPTS_NS::gray_to_RGB1;
+        grayA_to_RGBA         = SK_OPTS_NS::grayA_to_RGBA;
+        grayA_to_rgbA         = SK_OPTS_NS::grayA_to_rgbA;
+        inverted_CMYK_to_RGB1 = SK_OPTS_NS::inverted_CMYK_to_RGB1;
+        inverted_CMYK_to_BGR1 = SK_OPTS_NS::inverted_CMYK_to_BGR1;
+
+    #define M(st) stages_highp[SkRasterPipeline::st] = (StageFn)SK_OPTS_NS::st;
+        SK_RASTER_PIPELINE_STAGES(M)
+        just_return_highp = (StageFn)SK_OPTS_NS::just_return;
+        start_pipeline_highp = SK_OPTS_NS::start_pipeline;
+    #undef M
+
+    #define M(st) stages_lowp[SkRasterPipeline::st] = (StageFn)SK_OPTS_NS::lowp::st;
+        SK_RASTER_PIPELINE_STAGES(M)
+        just_return_lowp = (StageFn)SK_OPTS_NS::lowp::just_return;
+        start_pipeline_lowp = SK_OPTS_NS::lowp::start_pipeline;
+    #undef M
+    }
+}
@@ -10,10 +10,12 @@
 #define SK_OPTS_NS sse41
 #include "SkRasterPipeline_opts.h"
 #include "SkBlitRow_opts.h"
+#include "SkMaskBlurFilter_opts.h"
 
 namespace SkOpts {
     void Init_sse41() {
         blit_row_s32a_opaque = sse41::blit_row_s32a_opaque;
+        blur_lines_8         = sse41::blur_lines_8;
 
     #define M(st) stages_highp[SkRasterPipeline::st] = (StageFn)SK_OPTS_NS::st;
         SK_RASTER_PIPELINE_STAGES(M)
@@ -83,8 +83,8 @@ struct Ctx {
     #define JUMPER_IS_SCALAR
 #elif defined(SK_ARM_HAS_NEON)
     #define JUMPER_IS_NEON
-#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX512
-    #define JUMPER_IS_AVX512
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    #define JUMPER_IS_SKX
 #elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
     #define JUMPER_IS_HSW
 #elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX
@@ -289,7 +289,171 @@ namespace SK_OPTS_NS {
         }
     }
 
-#elif defined(JUMPER_IS_AVX) || defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#elif defined(JUMPER_IS_SKX)
+    // These are __m512 and __m512i, but friendlier and strongly-typed.
+    template <typename T> using V = T __attribute__((ext_vector_type(16)));
+    using F   = V<float   >;
+    using I32 = V< int32_t>;
+    using U64 = V<uint64_t>;
+    using U32 = V<uint32_t>;
+    using U16 = V<uint16_t>;
+    using U8  = V<uint8_t >;
+
+    // 16 pixels of 16-bit channels don't fit in one register, so we shuffle pairs of these.
+    using U16x32 = uint16_t __attribute__((ext_vector_type(32)));
+
+    SI F   mad(F f, F m, F a)   { return _mm512_fmadd_ps(f,m,a);    }
+    SI F   min(F a, F b)        { return _mm512_min_ps(a,b);        }
+    SI F   max(F a, F b)        { return _mm512_max_ps(a,b);        }
+    SI F   abs_  (F v)          { return _mm512_and_ps(v, 0-v);     }
+    SI F   floor_(F v)          { return _mm512_floor_ps(v);        }
+    SI F   rcp   (F v)          { return _mm512_rcp14_ps  (v);      }
+    SI F   rsqrt (F v)          { return _mm512_rsqrt14_ps(v);      }
+    SI F    sqrt_(F v)          { return _mm512_sqrt_ps (v);        }
+    SI U32 round (F v, F scale) { return _mm512_cvtps_epi32(v*scale); }
+
+    SI U16 pack(U32 v) { return _mm512_cvtepi32_epi16(v); }  // vpmovdw, truncating like NEON.
+    SI U8  pack(U16 v) { return _mm256_cvtepi16_epi8(v);  }  // vpmovwb, AVX-512BW.
+
+    SI F if_then_else(I32 c, F t, F e) {
+        return _mm512_mask_blend_ps(_mm512_movepi32_mask(c), e,t);
+    }
+
+    template <typename T>
+    SI V<T> gather(const T* p, U32 ix) {
+        return { p[ix[ 0]], p[ix[ 1]], p[ix[ 2]], p[ix[ 3]],
+                 p[ix[ 4]], p[ix[ 5]], p[ix[ 6]], p[ix[ 7]],
+                 p[ix[ 8]], p[ix[ 9]], p[ix[10]], p[ix[11]],
+                 p[ix[12]], p[ix[13]], p[ix[14]], p[ix[15]], };
+    }
+    SI F   gather(const float*    p, U32 ix) { return _mm512_i32gather_ps   (ix, p, 4); }
+    SI U32 gather(const uint32_t* p, U32 ix) { return _mm512_i32gather_epi32(ix, p, 4); }
+    SI U64 gather(const uint64_t* p, U32 ix) {
+        __m512i parts[] = {
+            _mm512_i32gather_epi64(_mm512_castsi512_si256(ix),      p, 8),
+            _mm512_i32gather_epi64(_mm512_extracti64x4_epi64(ix,1), p, 8),
+        };
+        return bit_cast<U64>(parts);
+    }
+
+    // Masked loads and stores only touch the first n lanes, so tails never run past the row.
+    SI __mmask16 first16(size_t n) { return (__mmask16)((1u   << n) - 1); }  // n <= 16
+    SI __mmask32 first32(size_t n) { return (__mmask32)((1ull << n) - 1); }  // n <= 32
+
+    SI void load3(const uint16_t* ptr, size_t tail, U16* r, U16* g, U16* b) {
+        // 16 pixels are 48 uint16_t, which we load as 32 + 16 and then de-interlace.
+        size_t n = 3*(tail ? tail : 16);
+        auto lo = bit_cast<U16x32>(_mm512_maskz_loadu_epi16(first32(n < 32 ? n : 32), ptr+ 0)),
+             hi = bit_cast<U16x32>(_mm512_maskz_loadu_epi16(first32(n > 32 ? n-32 : 0), ptr+32));
+
+        *r = __builtin_shufflevector(lo,hi,  0, 3, 6, 9,12,15,18,21,24,27,30,33,36,39,42,45);
+        *g = __builtin_shufflevector(lo,hi,  1, 4, 7,10,13,16,19,22,25,28,31,34,37,40,43,46);
+        *b = __builtin_shufflevector(lo,hi,  2, 5, 8,11,14,17,20,23,26,29,32,35,38,41,44,47);
+    }
+    SI void load4(const uint16_t* ptr, size_t tail, U16* r, U16* g, U16* b, U16* a) {
+        U16x32 _0_7, _8_f;  // rgba rgba ... for pixels 0-7, then 8-15.
+        if (__builtin_expect(tail,0)) {
+            _0_7 = bit_cast<U16x32>(_mm512_maskz_loadu_epi16(first32(tail < 8 ? 4*tail : 32),
+                                                             ptr+ 0));
+            _8_f = bit_cast<U16x32>(_mm512_maskz_loadu_epi16(first32(tail > 8 ? 4*(tail-8) : 0),
+                                                             ptr+32));
+        } else {
+            _0_7 = unaligned_load<U16x32>(ptr+ 0);
+            _8_f = unaligned_load<U16x32>(ptr+32);
+        }
+
+        *r = __builtin_shufflevector(_0_7,_8_f, 0, 4, 8,12,16,20,24,28,32,36,40,44,48,52,56,60);
+        *g = __builtin_shufflevector(_0_7,_8_f, 1, 5, 9,13,17,21,25,29,33,37,41,45,49,53,57,61);
+        *b = __builtin_shufflevector(_0_7,_8_f, 2, 6,10,14,18,22,26,30,34,38,42,46,50,54,58,62);
+        *a = __builtin_shufflevector(_0_7,_8_f, 3, 7,11,15,19,23,27,31,35,39,43,47,51,55,59,63);
+    }
+    SI void store4(uint16_t* ptr, size_t tail, U16 r, U16 g, U16 b, U16 a) {
+        U16x32 rg = __builtin_shufflevector(r,g, 0,16, 1,17, 2,18, 3,19, 4,20, 5,21, 6,22, 7,23,
+                                                 8,24, 9,25,10,26,11,27,12,28,13,29,14,30,15,31),
+               ba = __builtin_shufflevector(b,a, 0,16, 1,17, 2,18, 3,19, 4,20, 5,21, 6,22, 7,23,
+                                                 8,24, 9,25,10,26,11,27,12,28,13,29,14,30,15,31);
+
+        U16x32 _0_7 = __builtin_shufflevector(rg,ba,  0, 1,32,33,  2, 3,34,35,  4, 5,36,37,
+                                                      6, 7,38,39,  8, 9,40,41, 10,11,42,43,
+                                                     12,13,44,45, 14,15,46,47),
+               _8_f = __builtin_shufflevector(rg,ba, 16,17,48,49, 18,19,50,51, 20,21,52,53,
+                                                     22,23,54,55, 24,25,56,57, 26,27,58,59,
+                                                     28,29,60,61, 30,31,62,63);
+
+        if (__builtin_expect(tail,0)) {
+            _mm512_mask_storeu_epi16(ptr+ 0, first32(tail < 8 ? 4*tail : 32),     _0_7);
+            _mm512_mask_storeu_epi16(ptr+32, first32(tail > 8 ? 4*(tail-8) : 0), _8_f);
+        } else {
+            unaligned_store(ptr+ 0, _0_7);
+            unaligned_store(ptr+32, _8_f);
+        }
+    }
+
+    SI void load4(const float* ptr, size_t tail, F* r, F* g, F* b, F* a) {
+        F _0123, _4567, _89ab, _cdef;  // rgba rgba rgba rgba for 4 pixels at a time.
+        if (__builtin_expect(tail,0)) {
+            auto load_masked = [&](int i) -> F {
+                size_t n = 4*tail > 16*(size_t)i ? 4*tail - 16*(size_t)i : 0;
+                return _mm512_maskz_loadu_ps(first16(n < 16 ? n : 16), ptr + 16*i);
+            };
+            _0123 = load_masked(0);
+            _4567 = load_masked(1);
+            _89ab = load_masked(2);
+            _cdef = load_masked(3);
+        } else {
+            _0123 = unaligned_load<F>(ptr+ 0);
+            _4567 = unaligned_load<F>(ptr+16);
+            _89ab = unaligned_load<F>(ptr+32);
+            _cdef = unaligned_load<F>(ptr+48);
+        }
+
+        F rg0_7 = __builtin_shufflevector(_0123,_4567, 0, 4, 8,12,16,20,24,28,
+                                                       1, 5, 9,13,17,21,25,29),
+          ba0_7 = __builtin_shufflevector(_0123,_4567, 2, 6,10,14,18,22,26,30,
+                                                       3, 7,11,15,19,23,27,31),
+          rg8_f = __builtin_shufflevector(_89ab,_cdef, 0, 4, 8,12,16,20,24,28,
+                                                       1, 5, 9,13,17,21,25,29),
+          ba8_f = __builtin_shufflevector(_89ab,_cdef, 2, 6,10,14,18,22,26,30,
+                                                       3, 7,11,15,19,23,27,31);
+
+        *r = __builtin_shufflevector(rg0_7,rg8_f, 0, 1, 2, 3, 4, 5, 6, 7,16,17,18,19,20,21,22,23);
+        *g = __builtin_shufflevector(rg0_7,rg8_f, 8, 9,10,11,12,13,14,15,24,25,26,27,28,29,30,31);
+        *b = __builtin_shufflevector(ba0_7,ba8_f, 0, 1, 2, 3, 4, 5, 6, 7,16,17,18,19,20,21,22,23);
+        *a = __builtin_shufflevector(ba0_7,ba8_f, 8, 9,10,11,12,13,14,15,24,25,26,27,28,29,30,31);
+    }
+    SI void store4(float* ptr, size_t tail, F r, F g, F b, F a) {
+        F rg0_7 = __builtin_shufflevector(r,g, 0,16, 1,17, 2,18, 3,19, 4,20, 5,21, 6,22, 7,23),
+          ba0_7 = __builtin_shufflevector(b,a, 0,16, 1,17, 2,18, 3,19, 4,20, 5,21, 6,22, 7,23),
+          rg8_f = __builtin_shufflevector(r,g, 8,24, 9,25,10,26,11,27,12,28,13,29,14,30,15,31),
+          ba8_f = __builtin_shufflevector(b,a, 8,24, 9,25,10,26,11,27,12,28,13,29,14,30,15,31);
+
+        F _0123 = __builtin_shufflevector(rg0_7,ba0_7,  0, 1,16,17,  2, 3,18,19,
+                                                        4, 5,20,21,  6, 7,22,23),
+          _4567 = __builtin_shufflevector(rg0_7,ba0_7,  8, 9,24,25, 10,11,26,27,
+                                                       12,13,28,29, 14,15,30,31),
+          _89ab = __builtin_shufflevector(rg8_f,ba8_f,  0, 1,16,17,  2, 3,18,19,
+                                                        4, 5,20,21,  6, 7,22,23),
+          _cdef = __builtin_shufflevector(rg8_f,ba8_f,  8, 9,24,25, 10,11,26,27,
+                                                       12,13,28,29, 14,15,30,31);
+
+        if (__builtin_expect(tail,0)) {
+            auto store_masked = [&](int i, F v) {
+                size_t n = 4*tail > 16*(size_t)i ? 4*tail - 16*(size_t)i : 0;
+                _mm512_mask_storeu_ps(ptr + 16*i, first16(n < 16 ? n : 16), v);
+            };
+            store_masked(0, _0123);
+            store_masked(1, _4567);
+            store_masked(2, _89ab);
+            store_masked(3, _cdef);
+        } else {
+            unaligned_store(ptr+ 0, _0123);
+            unaligned_store(ptr+16, _4567);
+            unaligned_store(ptr+32, _89ab);
+            unaligned_store(ptr+48, _cdef);
+        }
+    }
+
+#elif defined(JUMPER_IS_AVX) || defined(JUMPER_IS_HSW)
     // These are __m256 and __m256i, but friendlier and strongly-typed.
     template <typename T> using V = T __attribute__((ext_vector_type(8)));
     using F   = V<float   >;
@@ -300,7 +464,7 @@ namespace SK_OPTS_NS {
     using U8  = V<uint8_t >;
 
     SI F mad(F f, F m, F a)  {
-    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+    #if defined(JUMPER_IS_HSW)
         return _mm256_fmadd_ps(f,m,a);
     #else
         return f*m+a;
@@ -332,7 +496,7 @@ namespace SK_OPTS_NS {
         return { p[ix[0]], p[ix[1]], p[ix[2]], p[ix[3]],
                  p[ix[4]], p[ix[5]], p[ix[6]], p[ix[7]], };
     }
-    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+    #if defined(JUMPER_IS_HSW)
         SI F   gather(const float*    p, U32 ix) { return _mm256_i32gather_ps   (p, ix, 4); }
         SI U32 gather(const uint32_t* p, U32 ix) { return _mm256_i32gather_epi32(p, ix, 4); }
         SI U64 gather(const uint64_t* p, U32 ix) {
@@ -728,7 +892,10 @@ SI F from_half(U16 h) {
 #if defined(SK_CPU_ARM64) && !defined(SK_BUILD_FOR_GOOGLE3)  // Temporary workaround for some Google3 builds.
     return vcvt_f32_f16(h);
 
-#elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#elif defined(JUMPER_IS_SKX)
+    return _mm512_cvtph_ps(h);
+
+#elif defined(JUMPER_IS_HSW)
     return _mm256_cvtph_ps(h);
 
 #else
@@ -748,7 +915,10 @@ SI U16 to_half(F f) {
 #if defined(SK_CPU_ARM64) && !defined(SK_BUILD_FOR_GOOGLE3)  // Temporary workaround for some Google3 builds.
     return vcvt_f16_f32(f);
 
-#elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#elif defined(JUMPER_IS_SKX)
+    return _mm512_cvtps_ph(f, _MM_FROUND_CUR_DIRECTION);
+
+#elif defined(JUMPER_IS_HSW)
     return _mm256_cvtps_ph(f, _MM_FROUND_CUR_DIRECTION);
 
 #else
@@ -888,6 +1058,16 @@ SI V load(const T* src, size_t tail) {
     if (__builtin_expect(tail, 0)) {
         V v{};  // Any inactive lanes are zeroed.
         switch (tail) {
+        #if defined(JUMPER_IS_SKX)
+            case 15: v[14] = src[14];
+            case 14: v[13] = src[13];
+            case 13: v[12] = src[12];
+            case 12: memcpy(&v, src, 12*sizeof(T)); break;
+            case 11: v[10] = src[10];
+            case 10: v[ 9] = src[ 9];
+            case  9: v[ 8] = src[ 8];
+            case  8: memcpy(&v, src,  8*sizeof(T)); break;
+        #endif
             case 7: v[6] = src[6];
             case 6: v[5] = src[5];
             case 5: v[4] = src[4];
@@ -908,6 +1088,16 @@ SI void store(T* dst, V v, size_t tail) {
     __builtin_assume(tail < N);
     if (__builtin_expect(tail, 0)) {
         switch (tail) {
+        #if defined(JUMPER_IS_SKX)
+            case 15: dst[14] = v[14];
+            case 14: dst[13] = v[13];
+            case 13: dst[12] = v[12];
+            case 12: memcpy(dst, &v, 12*sizeof(T)); break;
+            case 11: dst[10] = v[10];
+            case 10: dst[ 9] = v[ 9];
+            case  9: dst[ 8] = v[ 8];
+            case  8: memcpy(dst, &v,  8*sizeof(T)); break;
+        #endif
             case 7: dst[6] = v[6];
             case 6: dst[5] = v[5];
             case 5: dst[4] = v[4];
@@ -1007,7 +1197,7 @@ STAGE(seed_shader, Ctx::None) {
 
 STAGE(dither, const float* rate) {
     // Get [(dx,dy), (dx+1,dy), (dx+2,dy), ...] loaded up in integer vectors.
-    uint32_t iota[] = {0,1,2,3,4,5,6,7};
+    uint32_t iota[] = {0,1,2,3,4,5,6,7, 8,9,10,11,12,13,14,15};
     U32 X = dx + unaligned_load<U32>(iota),
         Y = dy;
 
@@ -1558,7 +1748,7 @@ STAGE(to_srgb, Ctx::None) {
         U32 sign;
         l = strip_sign(l, &sign);
         // We tweak c and d for each instruction set to make sure fn(1) is exactly 1.
-    #if defined(JUMPER_IS_AVX512)
+    #if defined(JUMPER_IS_SKX)
         const float c = 1.130026340485f,
                     d = 0.141387879848f;
     #elif defined(JUMPER_IS_SSE2) || defined(JUMPER_IS_SSE41) || \
@@ -1901,7 +2091,18 @@ STAGE(matrix_perspective, const float* m) {
 SI void gradient_lookup(const SkRasterPipeline_GradientCtx* c, U32 idx, F t,
                         F* r, F* g, F* b, F* a) {
     F fr, br, fg, bg, fb, bb, fa, ba;
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_SKX)
+    if (c->stopCount <= 16) {
+        fr = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->fs[0]));
+        br = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->bs[0]));
+        fg = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->fs[1]));
+        bg = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->bs[1]));
+        fb = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->fs[2]));
+        bb = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->bs[2]));
+        fa = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->fs[3]));
+        ba = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->bs[3]));
+    } else
+#elif defined(JUMPER_IS_HSW)
     if (c->stopCount <=8) {
         fr = _mm256_permutevar8x32_ps(_mm256_loadu_ps(c->fs[0]), idx);
         br = _mm256_permutevar8x32_ps(_mm256_loadu_ps(c->bs[0]), idx);
@@ -2238,7 +2439,14 @@ namespace lowp {
 
 #else  // We are compiling vector code with Clang... let's make some lowp stages!
 
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_SKX)
+    using U8  = uint8_t  __attribute__((ext_vector_type(32)));
+    using U16 = uint16_t __attribute__((ext_vector_type(32)));
+    using I16 =  int16_t __attribute__((ext_vector_type(32)));
+    using I32 =  int32_t __attribute__((ext_vector_type(32)));
+    using U32 = uint32_t __attribute__((ext_vector_type(32)));
+    using F   = float    __attribute__((ext_vector_type(32)));
+#elif defined(JUMPER_IS_HSW)
     using U8  = uint8_t  __attribute__((ext_vector_type(16)));
     using U16 = uint16_t __attribute__((ext_vector_type(16)));
     using I16 =  int16_t __attribute__((ext_vector_type(16)));
@@ -2464,7 +2672,11 @@ SI F mad(F f, F m, F a) { return f*m+a; }
 SI U32 trunc_(F x) { return (U32)cast<I32>(x); }
 
 SI F rcp(F x) {
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_SKX)
+    __m512 lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(_mm512_rcp14_ps(lo), _mm512_rcp14_ps(hi));
+#elif defined(JUMPER_IS_HSW)
     __m256 lo,hi;
     split(x, &lo,&hi);
     return join<F>(_mm256_rcp_ps(lo), _mm256_rcp_ps(hi));
@@ -2485,7 +2697,11 @@ SI F rcp(F x) {
 #endif
 }
 SI F sqrt_(F x) {
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_SKX)
+    __m512 lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(_mm512_sqrt_ps(lo), _mm512_sqrt_ps(hi));
+#elif defined(JUMPER_IS_HSW)
     __m256 lo,hi;
     split(x, &lo,&hi);
     return join<F>(_mm256_sqrt_ps(lo), _mm256_sqrt_ps(hi));
@@ -2520,7 +2736,11 @@ SI F floor_(F x) {
     float32x4_t lo,hi;
     split(x, &lo,&hi);
     return join<F>(vrndmq_f32(lo), vrndmq_f32(hi));
-#elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#elif defined(JUMPER_IS_SKX)
+    __m512 lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(_mm512_floor_ps(lo), _mm512_floor_ps(hi));
+#elif defined(JUMPER_IS_HSW)
     __m256 lo,hi;
     split(x, &lo,&hi);
     return join<F>(_mm256_floor_ps(lo), _mm256_floor_ps(hi));
@@ -2540,8 +2760,10 @@ SI F abs_(F x) { return bit_cast<F>( bit_cast<I32>(x) & 0x7fffffff ); }
 
 STAGE_GG(seed_shader, Ctx::None) {
     static const float iota[] = {
-        0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f,
-        8.5f, 9.5f,10.5f,11.5f,12.5f,13.5f,14.5f,15.5f,
+         0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f,
+         8.5f, 9.5f,10.5f,11.5f,12.5f,13.5f,14.5f,15.5f,
+        16.5f,17.5f,18.5f,19.5f,20.5f,21.5f,22.5f,23.5f,
+        24.5f,25.5f,26.5f,27.5f,28.5f,29.5f,30.5f,31.5f,
     };
     x = cast<F>(I32(dx)) + unaligned_load<F>(iota);
     y = cast<F>(I32(dy)) + 0.5f;
@@ -2721,9 +2943,14 @@ SI U32 ix_and_ptr(T** ptr, const SkRasterPipeline_GatherCtx* ctx, F x, F y) {
 template <typename V, typename T>
 SI V load(const T* ptr, size_t tail) {
     V v = 0;
+#if defined(JUMPER_IS_SKX)
+    // With 32 lanes, one variable-length copy of the tail beats a 32-way switch.
+    size_t n = tail & (N-1);
+    memcpy(&v, ptr, (n ? n : N) * sizeof(T));
+#else
     switch (tail & (N-1)) {
         case  0: memcpy(&v, ptr, sizeof(v)); break;
-    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+    #if defined(JUMPER_IS_HSW)
         case 15: v[14] = ptr[14];
         case 14: v[13] = ptr[13];
         case 13: v[12] = ptr[12];
@@ -2741,13 +2968,18 @@ SI V load(const T* ptr, size_t tail) {
         case  2: memcpy(&v, ptr,  2*sizeof(T)); break;
         case  1: v[ 0] = ptr[ 0];
     }
+#endif
     return v;
 }
 template <typename V, typename T>
 SI void store(T* ptr, size_t tail, V v) {
+#if defined(JUMPER_IS_SKX)
+    size_t n = tail & (N-1);
+    memcpy(ptr, &v, (n ? n : N) * sizeof(T));
+#else
     switch (tail & (N-1)) {
         case  0: memcpy(ptr, &v, sizeof(v)); break;
-    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+    #if defined(JUMPER_IS_HSW)
         case 15: ptr[14] = v[14];
         case 14: ptr[13] = v[13];
         case 13: ptr[12] = v[12];
@@ -2765,9 +2997,40 @@ SI void store(T* ptr, size_t tail, V v) {
         case  2: memcpy(ptr, &v,  2*sizeof(T)); break;
         case  1: ptr[ 0] = v[ 0];
     }
+#endif
 }
 
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_SKX)
+    template <typename V, typename T>
+    SI V gather(const T* ptr, U32 ix) {
+        return V{ ptr[ix[ 0]], ptr[ix[ 1]], ptr[ix[ 2]], ptr[ix[ 3]],
+                  ptr[ix[ 4]], ptr[ix[ 5]], ptr[ix[ 6]], ptr[ix[ 7]],
+                  ptr[ix[ 8]], ptr[ix[ 9]], ptr[ix[10]], ptr[ix[11]],
+                  ptr[ix[12]], ptr[ix[13]], ptr[ix[14]], ptr[ix[15]],
+                  ptr[ix[16]], ptr[ix[17]], ptr[ix[18]], ptr[ix[19]],
+                  ptr[ix[20]], ptr[ix[21]], ptr[ix[22]], ptr[ix[23]],
+                  ptr[ix[24]], ptr[ix[25]], ptr[ix[26]], ptr[ix[27]],
+                  ptr[ix[28]], ptr[ix[29]], ptr[ix[30]], ptr[ix[31]], };
+    }
+
+    template<>
+    F gather(const float* ptr, U32 ix) {
+        __m512i lo, hi;
+        split(ix, &lo, &hi);
+
+        return join<F>(_mm512_i32gather_ps(lo, ptr, 4),
+                       _mm512_i32gather_ps(hi, ptr, 4));
+    }
+
+    template<>
+    U32 gather(const uint32_t* ptr, U32 ix) {
+        __m512i lo, hi;
+        split(ix, &lo, &hi);
+
+        return join<U32>(_mm512_i32gather_epi32(lo, ptr, 4),
+                         _mm512_i32gather_epi32(hi, ptr, 4));
+    }
+#elif defined(JUMPER_IS_HSW)
     template <typename V, typename T>
     SI V gather(const T* ptr, U32 ix) {
         return V{ ptr[ix[ 0]], ptr[ix[ 1]], ptr[ix[ 2]], ptr[ix[ 3]],
@@ -2805,7 +3068,7 @@ SI void store(T* ptr, size_t tail, V v) {
 // ~~~~~~ 32-bit memory loads and stores ~~~~~~ //
 
 SI void from_8888(U32 rgba, U16* r, U16* g, U16* b, U16* a) {
-#if 1 && defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if 1 && defined(JUMPER_IS_HSW)
     // Swap the middle 128-bit lanes to make _mm256_packus_epi32() in cast_U16() work out nicely.
     __m256i _01,_23;
     split(rgba, &_01, &_23);
@@ -3091,6 +3354,9 @@ STAGE_GG(mirror_x_1, Ctx::None) {
 
 SI I16 cond_to_mask_16(I32 cond) { return cast<I16>(cond); }
 
+// The mask is kept here as 16-bit lanes, so all N of them fit in the context's mask.
+static_assert(sizeof(I16) <= sizeof(SkRasterPipeline_DecalTileCtx::mask), "");
+
 STAGE_GG(decal_x, SkRasterPipeline_DecalTileCtx* ctx) {
     auto w = ctx->limit_x;
     unaligned_store(ctx->mask, cond_to_mask_16((0 <= x) & (x < w)));
@@ -3128,7 +3394,29 @@ SI void gradient_lookup(const SkRasterPipeline_GradientCtx* c, U32 idx, F t,
                         U16* r, U16* g, U16* b, U16* a) {
 
     F fr, fg, fb, fa, br, bg, bb, ba;
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_SKX)
+    if (c->stopCount <= 16) {
+        __m512i lo, hi;
+        split(idx, &lo, &hi);
+
+        fr = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->fs[0])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->fs[0])));
+        br = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->bs[0])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->bs[0])));
+        fg = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->fs[1])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->fs[1])));
+        bg = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->bs[1])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->bs[1])));
+        fb = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->fs[2])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->fs[2])));
+        bb = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->bs[2])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->bs[2])));
+        fa = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->fs[3])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->fs[3])));
+        ba = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->bs[3])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->bs[3])));
+    } else
+#elif defined(JUMPER_IS_HSW)
     if (c->stopCount <=8) {
         __m256i lo, hi;
         split(idx, &lo, &hi);
@@ -489,8 +489,52 @@ static __m128i scale(__m128i x, __m128i y) {
     return _mm_mulhi_epu16(_mm_add_epi16(_mm_mullo_epi16(x, y), _128), _257);
 }
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+static __m512i scale(__m512i x, __m512i y) {
+    const __m512i _128 = _mm512_set1_epi16(128);
+    const __m512i _257 = _mm512_set1_epi16(257);
+
+    // (x+127)/255 == ((x+128)*257)>>16 for 0 <= x <= 255*255.
+    return _mm512_mulhi_epu16(_mm512_add_epi16(_mm512_mullo_epi16(x, y), _128), _257);
+}
+
+// Premultiply 8 pixels whose channels have been zero-extended to 16 bits.
+static __m512i premul8_skx(__m512i px) {
+    // Splat each pixel's alpha across its four channels...
+    const __m512i splatA = _mm512_broadcast_i32x4(
+            _mm_setr_epi8(6,7,6,7,6,7,6,7, 14,15,14,15,14,15,14,15));
+    __m512i a = _mm512_shuffle_epi8(px, splatA);
+
+    // ... except alpha itself, which we scale by 255 to leave it unchanged.
+    a = _mm512_mask_blend_epi16(0x88888888, a, _mm512_set1_epi16(255));
+    return scale(px, a);
+}
+#endif
+
 template <bool kSwapRB>
 static void premul_should_swapRB(uint32_t* dst, const uint32_t* src, int count) {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    const __m512i swapRB = _mm512_broadcast_i32x4(
+            _mm_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15));
+
+    while (count >= 16) {
+        __m512i px = _mm512_loadu_si512(src);
+        if (kSwapRB) {
+            px = _mm512_shuffle_epi8(px, swapRB);
+        }
+
+        __m512i lo = _mm512_cvtepu8_epi16(_mm512_castsi512_si256(px)),
+                hi = _mm512_cvtepu8_epi16(_mm512_extracti64x4_epi64(px, 1));
+
+        _mm256_storeu_si256((__m256i*) (dst + 0), _mm512_cvtepi16_epi8(premul8_skx(lo)));
+        _mm256_storeu_si256((__m256i*) (dst + 8), _mm512_cvtepi16_epi8(premul8_skx(hi)));
+
+        src += 16;
+        dst += 16;
+        count -= 16;
+    }
+#endif
+
 
     auto premul8 = [](__m128i* lo, __m128i* hi) {
         const __m128i zeros = _mm_setzero_si128();
@@ -568,6 +612,17 @@ static void premul_should_swapRB(uint32_t* dst, const uint32_t* src, int count)
 /*not static*/ inline void RGBA_to_BGRA(uint32_t* dst, const uint32_t* src, int count) {
     const __m128i swapRB = _mm_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15);
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    while (count >= 16) {
+        __m512i rgba = _mm512_loadu_si512(src);
+        _mm512_storeu_si512(dst, _mm512_shuffle_epi8(rgba, _mm512_broadcast_i32x4(swapRB)));
+
+        src += 16;
+        dst += 16;
+        count -= 16;
+    }
+#endif
+
     while (count >= 4) {
         __m128i rgba = _mm_loadu_si128((const __m128i*) src);
         __m128i bgra = _mm_shuffle_epi8(rgba, swapRB);
@@ -623,6 +678,20 @@ static void insert_alpha_should_swaprb(uint32_t dst[], const uint8_t* src, int c
 }
 
 /*not static*/ inline void gray_to_RGB1(uint32_t dst[], const uint8_t* src, int count) {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    // Widen each gray byte to its own 32-bit pixel, then copy it into r, g, and b.
+    while (count >= 16) {
+        __m512i g    = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*) src)),
+                ggg1 = _mm512_or_si512(_mm512_mullo_epi32(g, _mm512_set1_epi32(0x010101)),
+                                       _mm512_set1_epi32(0xFF000000));
+        _mm512_storeu_si512(dst, ggg1);
+
+        src += 16;
+        dst += 16;
+        count -= 16;
+    }
+#endif
+
     const __m128i alphas = _mm_set1_epi8((uint8_t) 0xFF);
     while (count >= 16) {
         __m128i grays = _mm_loadu_si128((const __m128i*) src);
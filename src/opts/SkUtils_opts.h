@@ -11,6 +11,10 @@
 #include <stdint.h>
 #include "SkNx.h"
 
+#if defined(SK_CPU_SSE_LEVEL) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    #include <immintrin.h>
+#endif
+
 namespace SK_OPTS_NS {
 
     template <typename T>
@@ -30,6 +34,37 @@ namespace SK_OPTS_NS {
         }
     }
 
+#if defined(SK_CPU_SSE_LEVEL) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    // With AVX-512 we write 64 bytes at a time, then finish with a single masked store
+    // that touches only the remaining elements.
+    /*not static*/ inline void memset16(uint16_t buffer[], uint16_t value, int count) {
+        const __m512i v = _mm512_set1_epi16(value);
+        for (; count >= 32; count -= 32, buffer += 32) {
+            _mm512_storeu_si512(buffer, v);
+        }
+        if (count > 0) {
+            _mm512_mask_storeu_epi16(buffer, (__mmask32)((1ull << count) - 1), v);
+        }
+    }
+    /*not static*/ inline void memset32(uint32_t buffer[], uint32_t value, int count) {
+        const __m512i v = _mm512_set1_epi32(value);
+        for (; count >= 16; count -= 16, buffer += 16) {
+            _mm512_storeu_si512(buffer, v);
+        }
+        if (count > 0) {
+            _mm512_mask_storeu_epi32(buffer, (__mmask16)((1u << count) - 1), v);
+        }
+    }
+    /*not static*/ inline void memset64(uint64_t buffer[], uint64_t value, int count) {
+        const __m512i v = _mm512_set1_epi64(value);
+        for (; count >= 8; count -= 8, buffer += 8) {
+            _mm512_storeu_si512(buffer, v);
+        }
+        if (count > 0) {
+            _mm512_mask_storeu_epi64(buffer, (__mmask8)((1u << count) - 1), v);
+        }
+    }
+#else
     /*not static*/ inline void memset16(uint16_t buffer[], uint16_t value, int count) {
         memsetT(buffer, value, count);
     }
@@ -39,6 +74,7 @@ namespace SK_OPTS_NS {
     /*not static*/ inline void memset64(uint64_t buffer[], uint64_t value, int count) {
         memsetT(buffer, value, count);
     }
+#endif
 
 }
 
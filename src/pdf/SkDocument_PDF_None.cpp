@@ -13,3 +13,5 @@ sk_sp<SkDocument> SkPDF::MakeDocument(SkWStream*, const SkPDF::Metadata&) { retu
 void SkPDF::SetNodeId(SkCanvas* c, int n) {
     c->drawAnnotation({0, 0, 0, 0}, "PDF_Node_Key", SkData::MakeWithCopy(&n, sizeof(n)).get());
 }
+
+sk_sp<SkPDF::FontCache> SkPDF::FontCache::Make(int, size_t) { return nullptr; }
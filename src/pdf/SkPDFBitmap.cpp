@@ -7,6 +7,7 @@
 
 #include "SkPDFBitmap.h"
 
+#include "SkCodec.h"
 #include "SkColorData.h"
 #include "SkData.h"
 #include "SkDeflate.h"
@@ -276,11 +277,17 @@ static void bitmap_alpha_to_a8(const SkBitmap& bitmap, SkWStream* out) {
     }
 }
 
-static void emit_image_xobject(SkWStream* stream,
-                               const SkImage* image,
-                               bool alpha,
-                               const sk_sp<SkPDFObject>& smask,
-                               const SkPDFObjNumMap& objNumMap) {
+namespace {
+// The deflated pixels of an image, along with what the XObject dictionary says about them.
+struct DeflatedImage {
+    sk_sp<SkData> fData;
+    int fWidth = 0;
+    int fHeight = 0;
+    bool fGray = false;
+};
+}  // namespace
+
+static DeflatedImage deflate_image(const SkImage* image, bool alpha) {
     SkBitmap bitmap;
     if (!SkPDFUtils::ToBitmap(image, &bitmap)) {
         // no pixels or wrong size: fill with zeros.
@@ -295,29 +302,35 @@ static void emit_image_xobject(SkWStream* stream,
     } else {
         bitmap_to_pdf_pixels(bitmap, &deflateWStream);
     }
-    deflateWStream.finalize();  // call before buffer.bytesWritten().
+    deflateWStream.finalize();  // call before buffer.detachAsData().
+
+    DeflatedImage deflated;
+    deflated.fData = buffer.detachAsData();
+    deflated.fWidth = bitmap.width();
+    deflated.fHeight = bitmap.height();
+    deflated.fGray = alpha || 1 == pdf_color_component_count(bitmap.colorType());
+    return deflated;
+}
 
+static void emit_image_xobject(SkWStream* stream,
+                               const DeflatedImage& deflated,
+                               const sk_sp<SkPDFObject>& smask,
+                               const SkPDFObjNumMap& objNumMap) {
     SkPDFDict pdfDict("XObject");
     pdfDict.insertName("Subtype", "Image");
-    pdfDict.insertInt("Width", bitmap.width());
-    pdfDict.insertInt("Height", bitmap.height());
-    if (alpha) {
-        pdfDict.insertName("ColorSpace", "DeviceGray");
-    } else if (1 == pdf_color_component_count(bitmap.colorType())) {
-        pdfDict.insertName("ColorSpace", "DeviceGray");
-    } else {
-        pdfDict.insertName("ColorSpace", "DeviceRGB");
-    }
+    pdfDict.insertInt("Width", deflated.fWidth);
+    pdfDict.insertInt("Height", deflated.fHeight);
+    pdfDict.insertName("ColorSpace", deflated.fGray ? "DeviceGray" : "DeviceRGB");
     if (smask) {
         pdfDict.insertObjRef("SMask", smask);
     }
     pdfDict.insertInt("BitsPerComponent", 8);
     pdfDict.insertName("Filter", "FlateDecode");
-    pdfDict.insertInt("Length", buffer.bytesWritten());
+    pdfDict.insertInt("Length", deflated.fData->size());
     pdfDict.emitObject(stream, objNumMap);
 
     stream->writeText(kStreamBegin);
-    buffer.writeToAndReset(stream);
+    stream->write(deflated.fData->data(), deflated.fData->size());
     stream->writeText(kStreamEnd);
 }
 
@@ -331,12 +344,21 @@ public:
     void emitObject(SkWStream*  stream,
                     const SkPDFObjNumMap& objNumMap) const override {
         SkASSERT(fImage);
-        emit_image_xobject(stream, fImage.get(), true, nullptr, objNumMap);
+        emit_image_xobject(stream,
+                           fDeflated.fData ? fDeflated : deflate_image(fImage.get(), true),
+                           nullptr, objNumMap);
+    }
+    void prepare() override {
+        SkASSERT(fImage);
+        if (!fDeflated.fData) {
+            fDeflated = deflate_image(fImage.get(), true);
+        }
     }
-    void drop() override { fImage = nullptr; }
+    void drop() override { fImage = nullptr; fDeflated = DeflatedImage(); }
 
 private:
     sk_sp<SkImage> fImage;
+    DeflatedImage fDeflated;  // Set by prepare().
 };
 
 }  // namespace
@@ -349,18 +371,27 @@ public:
     void emitObject(SkWStream* stream,
                     const SkPDFObjNumMap& objNumMap) const override {
         SkASSERT(fImage);
-        emit_image_xobject(stream, fImage.get(), false, fSMask, objNumMap);
+        emit_image_xobject(stream,
+                           fDeflated.fData ? fDeflated : deflate_image(fImage.get(), false),
+                           fSMask, objNumMap);
     }
     void addResources(SkPDFObjNumMap* catalog) const override {
         catalog->addObjectRecursively(fSMask.get());
     }
-    void drop() override { fImage = nullptr; fSMask = nullptr; }
+    void prepare() override {
+        SkASSERT(fImage);
+        if (!fDeflated.fData) {
+            fDeflated = deflate_image(fImage.get(), false);
+        }
+    }
+    void drop() override { fImage = nullptr; fSMask = nullptr; fDeflated = DeflatedImage(); }
     PDFDefaultBitmap(sk_sp<SkImage> image, sk_sp<SkPDFObject> smask)
         : fImage(std::move(image)), fSMask(std::move(smask)) { SkASSERT(fImage); }
 
 private:
     sk_sp<SkImage> fImage;
     sk_sp<SkPDFObject> fSMask;
+    DeflatedImage fDeflated;  // Set by prepare().
 };
 }  // namespace
 
@@ -455,3 +486,44 @@ sk_sp<SkPDFObject> SkPDFCreateBitmapObject(sk_sp<SkImage> image, int encodingQua
     #endif
     return sk_make_sp<PDFDefaultBitmap>(std::move(image), std::move(smask));
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+// A lazy subset (SkImage::makeSubset) returns the encoded data of the whole
+// image, so that data only describes the image if it decodes to the same size.
+static sk_sp<SkData> encoded_data_of_whole_image(const SkImage* image) {
+    sk_sp<SkData> data = image->refEncodedData();
+    if (!data) {
+        return nullptr;
+    }
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+    if (!codec || codec->dimensions() != image->dimensions()) {
+        return nullptr;
+    }
+    return data;
+}
+
+bool SkPDFComputeImageContentKey(const SkImage* image, SkPDFImageContentKey* key) {
+    SkASSERT(image);
+    SkASSERT(key);
+    SkMD5 md5;
+    if (sk_sp<SkData> data = encoded_data_of_whole_image(image)) {
+        md5.write(data->data(), data->size());
+        key->fFormat = 0;
+    } else {
+        SkBitmap bitmap;
+        if (!SkPDFUtils::ToBitmap(image, &bitmap) || !bitmap.getPixels()) {
+            return false;
+        }
+        // Hash the rows without any padding between them.
+        size_t rowBytes = bitmap.info().minRowBytes();
+        for (int y = 0; y < bitmap.height(); ++y) {
+            md5.write(bitmap.getAddr(0, y), rowBytes);
+        }
+        key->fFormat = 1 + (bitmap.colorType() << 8 | bitmap.alphaType());
+    }
+    md5.finish(key->fDigest);
+    key->fWidth = image->width();
+    key->fHeight = image->height();
+    return true;
+}
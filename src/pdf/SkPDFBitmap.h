@@ -7,6 +7,7 @@
 #ifndef SkPDFBitmap_DEFINED
 #define SkPDFBitmap_DEFINED
 
+#include "SkMD5.h"
 #include "SkRefCnt.h"
 
 class SkImage;
@@ -15,10 +16,33 @@ class SkPDFObject;
 /**
  * SkPDFBitmap wraps a SkImage and serializes it as an image Xobject.
  * It is designed to use a minimal amout of memory, aside from refing
- * the image, and its emitObject() does not cache any data.
+ * the image, and unless it is prepared, its emitObject() does not cache
+ * any data.
  *
  *  quality > 100 means lossless
  */
 sk_sp<SkPDFObject> SkPDFCreateBitmapObject(sk_sp<SkImage>, int encodingQuality = 101);
 
+/**
+ *  Identifies an image by what SkPDFCreateBitmapObject() would embed for it:
+ *  the digest of its encoded data if that decodes to the image's size (a
+ *  subset shares the encoded data of the whole image), and of its pixels
+ *  otherwise.
+ *  Two images with the same key can share one image XObject.
+ */
+struct SkPDFImageContentKey {
+    SkMD5::Digest fDigest;
+    int32_t fWidth;
+    int32_t fHeight;
+    uint32_t fFormat;  // Encoded data, or the color and alpha type of the pixels.
+
+    bool operator==(const SkPDFImageContentKey& that) const {
+        return fDigest == that.fDigest && fWidth == that.fWidth &&
+               fHeight == that.fHeight && fFormat == that.fFormat;
+    }
+};
+
+/** Returns false if the image has neither encoded data nor readable pixels. */
+bool SkPDFComputeImageContentKey(const SkImage*, SkPDFImageContentKey*);
+
 #endif  // SkPDFBitmap_DEFINED
@@ -11,6 +11,7 @@
 
 #include "SkBitmapKey.h"
 #include "SkMacros.h"
+#include "SkPDFBitmap.h"
 #include "SkPDFGradientShader.h"
 #include "SkPDFGraphicState.h"
 #include "SkPDFShader.h"
@@ -19,6 +20,7 @@
 #include "SkTypeface.h"
 
 class SkPDFFont;
+class SkPDFFontCache;
 struct SkAdvancedTypefaceMetrics;
 
 /**
@@ -39,12 +41,16 @@ public:
     SkPDFGradientShader::HashMap fGradientPatternMap;
 
     SkTHashMap<SkBitmapKey, sk_sp<SkPDFObject>> fPDFBitmapMap;
+    // Only used with SkPDF::Metadata::fDeduplicateImagesByContent.
+    SkTHashMap<SkPDFImageContentKey, sk_sp<SkPDFObject>> fPDFImageContentMap;
 
     SkTHashMap<uint32_t, std::unique_ptr<SkAdvancedTypefaceMetrics>> fTypefaceMetrics;
     SkTHashMap<uint32_t, std::vector<SkString>> fType1GlyphNames;
     SkTHashMap<uint32_t, std::vector<SkUnichar>> fToUnicodeMap;
     SkTHashMap<uint32_t, sk_sp<SkPDFDict>> fFontDescriptors;
     SkTHashMap<uint64_t, sk_sp<SkPDFFont>> fFontMap;
+    // Only with SkPDF::Metadata::fFontCache, which owns it.
+    SkPDFFontCache* fFontCache = nullptr;
 
     SkTHashMap<SkPDFStrokeGraphicState, sk_sp<SkPDFDict>> fStrokeGSMap;
     SkTHashMap<SkPDFFillGraphicState, sk_sp<SkPDFDict>> fFillGSMap;
@@ -16,6 +16,7 @@
 #include "SkClusterator.h"
 #include "SkColor.h"
 #include "SkColorFilter.h"
+#include "SkDeflate.h"
 #include "SkDraw.h"
 #include "SkGlyphCache.h"
 #include "SkGlyphRun.h"
@@ -430,6 +431,7 @@ public:
                 shape = nullptr;
             }
             fDevice->finishContentEntry(fClipStack, fBlendMode, std::move(fDstFormXObject), shape);
+            fDevice->deflateFullContent();
         }
     }
 
@@ -502,6 +504,8 @@ void SkPDFDevice::reset() {
     fShaderResources = std::vector<sk_sp<SkPDFObject>>();
     fFontResources = std::vector<sk_sp<SkPDFFont>>();
     fContent.reset();
+    fContentDeflater = nullptr;
+    fDeflatedContent = nullptr;
     fActiveStackState = GraphicStackState();
 }
 
@@ -1343,6 +1347,7 @@ sk_sp<SkPDFDict> SkPDFDevice::makeResourceDict() {
 }
 
 std::unique_ptr<SkStreamAsset> SkPDFDevice::content() {
+    SkASSERT(!fContentDeflater);
     if (fActiveStackState.fContentStream) {
         fActiveStackState.drainStack();
         fActiveStackState = GraphicStackState();
@@ -1365,6 +1370,44 @@ std::unique_ptr<SkStreamAsset> SkPDFDevice::content() {
     return std::unique_ptr<SkStreamAsset>(buffer.detachAsStream());
 }
 
+void SkPDFDevice::deflateFullContent() {
+    #ifndef SK_PDF_LESS_COMPRESSION
+    if (fDeflateChunkSize == 0 || fContent.bytesWritten() < fDeflateChunkSize ||
+        fContentBuffer.bytesWritten() != 0) {
+        return;
+    }
+    if (!fContentDeflater) {
+        // Whether content() would need its extra save is not known yet, so always add it.
+        fDeflatedContent = skstd::make_unique<SkDynamicMemoryWStream>();
+        fContentDeflater = skstd::make_unique<SkDeflateWStream>(fDeflatedContent.get());
+        if (fInitialTransform.getType() != SkMatrix::kIdentity_Mask) {
+            append_transform(fInitialTransform, fContentDeflater.get());
+        }
+        fContentDeflater->writeText("q\n");
+    }
+    fContent.writeToAndReset(fContentDeflater.get());
+    #endif
+}
+
+sk_sp<SkPDFStream> SkPDFDevice::makeContentStream(bool deferCompression) {
+    if (!fContentDeflater) {
+        return deferCompression ? SkPDFStream::MakeDeferred(this->content())
+                                : sk_make_sp<SkPDFStream>(this->content());
+    }
+    if (fActiveStackState.fContentStream) {
+        fActiveStackState.drainStack();
+        fActiveStackState = GraphicStackState();
+    }
+    fContent.writeToAndReset(fContentDeflater.get());
+    fContentDeflater->writeText("Q\n");
+    fContentDeflater->finalize();
+    fContentDeflater = nullptr;
+    fNeedsExtraSave = false;
+    std::unique_ptr<SkStreamAsset> deflated(fDeflatedContent->detachAsStream());
+    fDeflatedContent = nullptr;
+    return SkPDFStream::MakeDeflated(std::move(deflated));
+}
+
 /* Draws an inverse filled path by using Path Ops to compute the positive
  * inverse using the current clip as the inverse bounds.
  * Return true if this was an inverse path and was properly handled,
@@ -1476,7 +1519,7 @@ sk_sp<SkPDFObject> SkPDFDevice::makeFormXObjectFromDevice(bool alpha) {
     const char* colorSpace = alpha ? "DeviceGray" : nullptr;
 
     sk_sp<SkPDFObject> xobject =
-        SkPDFMakeFormXObject(this->content(),
+        SkPDFMakeFormXObject(this->makeContentStream(false),
                              SkPDFMakeArray(0, 0, this->width(), this->height()),
                              this->makeResourceDict(), inverseTransform, colorSpace);
     // We always draw the form xobjects that we create back into the device, so
@@ -1522,8 +1565,11 @@ SkDynamicMemoryWStream* SkPDFDevice::setUpContentEntry(const SkClipStack* clipSt
     }
 
     // For the following modes, we want to handle source and destination
-    // separately, so make an object of what's already there.
-    if (!treat_as_regular_pdf_blend_mode(blendMode) && blendMode != SkBlendMode::kDstOver) {
+    // separately, so make an object of what's already there.  DstOver
+    // prepends the source to the content instead, unless the content has
+    // been deflated.
+    if (!treat_as_regular_pdf_blend_mode(blendMode) &&
+        (blendMode != SkBlendMode::kDstOver || fContentDeflater)) {
         if (!isContentEmpty()) {
             *dst = this->makeFormXObjectFromDevice();
             SkASSERT(isContentEmpty());
@@ -1539,7 +1585,7 @@ SkDynamicMemoryWStream* SkPDFDevice::setUpContentEntry(const SkClipStack* clipSt
 
     if (treat_as_regular_pdf_blend_mode(blendMode)) {
         if (!fActiveStackState.fContentStream) {
-            if (fContent.bytesWritten() != 0) {
+            if (this->hasContent()) {
                 fContent.writeText("Q\nq\n");
                 fNeedsExtraSave = true;
             }
@@ -1577,7 +1623,17 @@ void SkPDFDevice::finishContentEntry(const SkClipStack* clipStack,
     fActiveStackState = GraphicStackState();
 
     if (blendMode == SkBlendMode::kDstOver) {
-        SkASSERT(!dst);
+        if (dst) {
+            // The deflated content could not be prepended to, so it was made
+            // into dst, which now goes over the source.
+            SkASSERT(!this->hasContent());
+            fContentBuffer.writeToAndReset(&fContent);
+            ScopedContentEntry content(this, nullptr, SkMatrix::I(), SkPaint());
+            if (content) {
+                this->drawFormXObject(std::move(dst), content.stream());
+            }
+            return;
+        }
         if (fContentBuffer.bytesWritten() != 0) {
             if (fContent.bytesWritten() != 0) {
                 fContentBuffer.writeText("Q\nq\n");
@@ -1589,7 +1645,7 @@ void SkPDFDevice::finishContentEntry(const SkClipStack* clipStack,
         return;
     }
     if (fContentBuffer.bytesWritten() != 0) {
-        if (fContent.bytesWritten() != 0) {
+        if (this->hasContent()) {
             fContent.writeText("Q\nq\n");
             fNeedsExtraSave = true;
         }
@@ -1700,7 +1756,7 @@ void SkPDFDevice::finishContentEntry(const SkClipStack* clipStack,
 }
 
 bool SkPDFDevice::isContentEmpty() {
-    return fContent.bytesWritten() == 0 && fContentBuffer.bytesWritten() == 0;
+    return !this->hasContent() && fContentBuffer.bytesWritten() == 0;
 }
 
 void SkPDFDevice::populateGraphicStateEntryFromPaint(
@@ -2034,12 +2090,26 @@ void SkPDFDevice::internalDrawImageRect(SkKeyedImage imageSubset,
     sk_sp<SkPDFObject> pdfimage = pdfimagePtr ? *pdfimagePtr : nullptr;
     if (!pdfimage) {
         SkASSERT(imageSubset);
-        pdfimage = SkPDFCreateBitmapObject(imageSubset.release(),
-                                           fDocument->metadata().fEncodingQuality);
+        // A different SkImage may already have been embedded with the same contents.
+        SkPDFImageContentKey contentKey;
+        bool hasContentKey = fDocument->metadata().fDeduplicateImagesByContent &&
+                             SkPDFComputeImageContentKey(imageSubset.image().get(), &contentKey);
+        if (hasContentKey) {
+            if (sk_sp<SkPDFObject>* ptr = fDocument->canon()->fPDFImageContentMap.find(contentKey)) {
+                pdfimage = *ptr;
+            }
+        }
         if (!pdfimage) {
-            return;
+            pdfimage = SkPDFCreateBitmapObject(imageSubset.release(),
+                                               fDocument->metadata().fEncodingQuality);
+            if (!pdfimage) {
+                return;
+            }
+            fDocument->serialize(pdfimage);  // serialize images early.
+            if (hasContentKey) {
+                fDocument->canon()->fPDFImageContentMap.set(contentKey, pdfimage);
+            }
         }
-        fDocument->serialize(pdfimage);  // serialize images early.
         SkASSERT((key != SkBitmapKey{{0, 0, 0, 0}, 0}));
         fDocument->canon()->fPDFBitmapMap.set(key, pdfimage);
     }
@@ -22,6 +22,7 @@
 
 #include <vector>
 
+class SkDeflateWStream;
 class SkGlyphRunList;
 class SkKeyedImage;
 class SkPath;
@@ -109,10 +110,23 @@ public:
      */
     void appendDestinations(SkPDFDict* dict, SkPDFObject* page) const;
 
-    /** Returns a SkStream with the page contents.
+    /** Returns a SkStream with the page contents.  Not for a device that
+     *  deflates its content as it is drawn.
      */
     std::unique_ptr<SkStreamAsset> content();
 
+    /** Deflate the content while it is drawn, each time chunkSize bytes of it
+     *  are waiting, so that the uncompressed content never exists in full.
+     *  Zero, the default, keeps the content until makeContentStream().
+     */
+    void setDeflateChunkSize(size_t chunkSize) { fDeflateChunkSize = chunkSize; }
+
+    /** Returns a PDF stream of the contents.  Unless the content was deflated
+     *  as it was drawn, it is compressed now, or in prepare() if
+     *  deferCompression is true.  Destructive.
+     */
+    sk_sp<SkPDFStream> makeContentStream(bool deferCompression);
+
     SkPDFCanon* getCanon() const;
 
     SkISize size() const { return this->imageInfo().dimensions(); }
@@ -174,6 +188,12 @@ private:
     SkDynamicMemoryWStream fContent;
     SkDynamicMemoryWStream fContentBuffer;
     bool fNeedsExtraSave = false;
+
+    // With a deflate chunk size, the start of the content, once fContent holds
+    // a chunk of it, is compressed by fContentDeflater into fDeflatedContent.
+    size_t fDeflateChunkSize = 0;
+    std::unique_ptr<SkDynamicMemoryWStream> fDeflatedContent;
+    std::unique_ptr<SkDeflateWStream> fContentDeflater;
     struct GraphicStackState {
         GraphicStackState(SkDynamicMemoryWStream* s = nullptr);
         void updateClip(const SkClipStack* clipStack, const SkIRect& bounds);
@@ -215,6 +235,8 @@ private:
                                     sk_sp<SkPDFObject>* dst);
     void finishContentEntry(const SkClipStack*, SkBlendMode, sk_sp<SkPDFObject> dst, SkPath* shape);
     bool isContentEmpty();
+    bool hasContent() const { return fContent.bytesWritten() != 0 || fContentDeflater; }
+    void deflateFullContent();
 
     void populateGraphicStateEntryFromPaint(const SkMatrix& matrix,
                                             const SkClipStack* clipStack,
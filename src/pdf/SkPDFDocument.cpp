@@ -9,13 +9,17 @@
 #include "SkPDFDocumentPriv.h"
 
 #include "SkMakeUnique.h"
+#include "SkMathPriv.h"
 #include "SkPDFCanon.h"
 #include "SkPDFDevice.h"
+#include "SkPDFFontCache.h"
 #include "SkPDFTag.h"
 #include "SkPDFUtils.h"
 #include "SkStream.h"
+#include "SkTaskGroup.h"
 #include "SkTo.h"
 
+#include <algorithm>
 #include <utility>
 
 // For use in SkCanvas::drawAnnotation
@@ -24,9 +28,21 @@ const char* SkPDFGetNodeIdKey() {
     return key;
 }
 
-SkPDFObjectSerializer::SkPDFObjectSerializer() : fBaseOffset(0), fNextToBeSerialized(0) {}
+SkPDFObjectSerializer::SkPDFObjectSerializer()
+    : fBaseOffset(0), fNextToBeSerialized(0), fNextToBePrepared(0), fUseObjectStreams(false) {}
+
+SkPDFObjectSerializer::SkPDFObjectSerializer(const SkPDF::Metadata& metadata)
+    : SkPDFObjectSerializer() {
+    if (metadata.fExecutor) {
+        fPrepareTasks = skstd::make_unique<SkTaskGroup>(*metadata.fExecutor);
+    }
+    fUseObjectStreams = metadata.fUseObjectStreams;
+}
 
 SkPDFObjectSerializer::~SkPDFObjectSerializer() {
+    if (fPrepareTasks) {
+        fPrepareTasks->wait();
+    }
     for (const sk_sp<SkPDFObject>& obj: fObjNumMap.objects()) {
         obj->drop();
     }
@@ -40,6 +56,19 @@ void SkPDFObjectSerializer::addObjectRecursively(const sk_sp<SkPDFObject>& objec
     fObjNumMap.addObjectRecursively(object.get());
 }
 
+void SkPDFObjectSerializer::prepareObjects() {
+    if (!fPrepareTasks) {
+        return;
+    }
+    const std::vector<sk_sp<SkPDFObject>>& objects = fObjNumMap.objects();
+    // Object streams are added and written while serializing; don't prepare them afterwards.
+    fNextToBePrepared = SkTMax(fNextToBePrepared, fNextToBeSerialized);
+    for (; fNextToBePrepared < objects.size(); ++fNextToBePrepared) {
+        sk_sp<SkPDFObject> object = objects[fNextToBePrepared];
+        fPrepareTasks->add([object]() { object->prepare(); });
+    }
+}
+
 #define SKPDF_MAGIC "\xD3\xEB\xE9\xE1"
 #ifndef SK_BUILD_FOR_WIN
 static_assert((SKPDF_MAGIC[0] & 0x7F) == "Skia"[0], "");
@@ -47,39 +76,180 @@ static_assert((SKPDF_MAGIC[1] & 0x7F) == "Skia"[1], "");
 static_assert((SKPDF_MAGIC[2] & 0x7F) == "Skia"[2], "");
 static_assert((SKPDF_MAGIC[3] & 0x7F) == "Skia"[3], "");
 #endif
-void SkPDFObjectSerializer::serializeHeader(SkWStream* wStream,
-                                            const SkPDF::Metadata& md) {
-    fBaseOffset = wStream->bytesWritten();
+static void write_header(SkWStream* wStream, bool useObjectStreams) {
+    // Object streams and cross-reference streams are new in PDF 1.5.
     static const char kHeader[] = "%PDF-1.4\n%" SKPDF_MAGIC "\n";
-    wStream->writeText(kHeader);
+    static const char kHeader15[] = "%PDF-1.5\n%" SKPDF_MAGIC "\n";
+    wStream->writeText(useObjectStreams ? kHeader15 : kHeader);
     // The PDF spec recommends including a comment with four
     // bytes, all with their high bits set.  "\xD3\xEB\xE9\xE1" is
     // "Skia" with the high bits set.
+}
+#undef SKPDF_MAGIC
+
+void SkPDFObjectSerializer::serializeHeader(SkWStream* wStream,
+                                            const SkPDF::Metadata& md) {
+    fBaseOffset = wStream->bytesWritten();
+    write_header(wStream, fUseObjectStreams);
     fInfoDict = SkPDFMetadata::MakeDocumentInformationDict(md);
     this->addObjectRecursively(fInfoDict);
     this->serializeObjects(wStream);
 }
-#undef SKPDF_MAGIC
+
+static void emit_indirect_object(SkWStream* wStream, int32_t objectNumber,
+                                 const SkPDFObject& object, const SkPDFObjNumMap& objNumMap) {
+    wStream->writeDecAsText(objectNumber);
+    wStream->writeText(" 0 obj\n");  // Generation number is always 0.
+    object.emitObject(wStream, objNumMap);
+    wStream->writeText("\nendobj\n");
+}
 
 // Serialize all objects in the fObjNumMap that have not yet been serialized;
+// Objects are always written in the order they were added, so the output does not depend on
+// whether or how they were prepared.  Deferred objects are skipped.  With object streams,
+// objects that can go into one are collected, and each full object stream is written as the
+// next object.
 void SkPDFObjectSerializer::serializeObjects(SkWStream* wStream) {
+    if (fPrepareTasks) {
+        this->prepareObjects();
+        fPrepareTasks->wait();
+    }
     const std::vector<sk_sp<SkPDFObject>>& objects = fObjNumMap.objects();
-    while (fNextToBeSerialized < objects.size()) {
-        SkPDFObject* object = objects[fNextToBeSerialized].get();
-        // Maximum number of indirect objects is 2^23-1.
-        int32_t index = SkToS32(fNextToBeSerialized + 1);  // Skip object 0.
-        // "The first entry in the [XREF] table (object number 0) is
-        // always free and has a generation number of 65,535; it is
-        // the head of the linked list of free objects."
-        SkASSERT(fOffsets.size() == fNextToBeSerialized);
-        fOffsets.push_back(this->offset(wStream));
-        wStream->writeDecAsText(index);
-        wStream->writeText(" 0 obj\n");  // Generation number is always 0.
-        object->emitObject(wStream, fObjNumMap);
-        wStream->writeText("\nendobj\n");
+    while (true) {
+        while (fNextToBeSerialized < objects.size()) {
+            if (fDeferred.contains(objects[fNextToBeSerialized].get())) {
+                fDeferredIndices.push_back(fNextToBeSerialized);
+            } else {
+                this->serializeObject(wStream, fNextToBeSerialized);
+            }
+            ++fNextToBeSerialized;
+            if (fObjectStreamMembers.size() == kMaxObjectStreamMembers) {
+                this->flushObjectStream();
+            }
+        }
+        if (fObjectStreamMembers.empty()) {
+            break;
+        }
+        // The object stream is itself a new object, written by the next pass of the loop.
+        this->flushObjectStream();
+    }
+}
+
+void SkPDFObjectSerializer::serializeDeferredObjects(SkWStream* wStream) {
+    for (size_t index : fDeferredIndices) {
+        fObjNumMap.objects()[index]->addResources(&fObjNumMap);
+    }
+    for (size_t index : fDeferredIndices) {
+        this->serializeObject(wStream, index);
+    }
+    fDeferred.reset();
+    fDeferredIndices.clear();
+}
+
+void SkPDFObjectSerializer::serializeObject(SkWStream* wStream, size_t index) {
+    SkPDFObject* object = fObjNumMap.objects()[index].get();
+    if (fOffsets.size() <= index) {
+        fOffsets.resize(index + 1, 0);
+    }
+    if (fUseObjectStreams && object->canBeInObjectStream()) {
+        fObjectStreamMembers.push_back({index, fObjectStreamBody.bytesWritten()});
+        object->emitObject(&fObjectStreamBody, fObjNumMap);
+        fObjectStreamBody.writeText("\n");
         object->drop();
-        ++fNextToBeSerialized;
+        return;
+    }
+    // Maximum number of indirect objects is 2^23-1.
+    int32_t objectNumber = SkToS32(index + 1);  // Skip object 0.
+    // "The first entry in the [XREF] table (object number 0) is
+    // always free and has a generation number of 65,535; it is
+    // the head of the linked list of free objects."
+    SkASSERT(fOffsets[index] == 0);
+    fOffsets[index] = this->offset(wStream);
+    emit_indirect_object(wStream, objectNumber, *object, fObjNumMap);
+    object->drop();
+}
+
+void SkPDFObjectSerializer::flushObjectStream() {
+    SkASSERT(!fObjectStreamMembers.empty());
+    // An object stream starts with pairs of object numbers and offsets, which are relative to
+    // the first object, found at /First.
+    SkDynamicMemoryWStream data;
+    for (const ObjectStreamMember& member : fObjectStreamMembers) {
+        data.writeDecAsText(SkToS32(member.fIndex + 1));
+        data.writeText(" ");
+        data.writeBigDecAsText(member.fOffset);
+        data.writeText(" ");
     }
+    size_t first = data.bytesWritten();
+    fObjectStreamBody.writeToAndReset(&data);
+
+    auto objectStream = sk_make_sp<SkPDFStream>(data.detachAsStream());
+    objectStream->dict()->insertName("Type", "ObjStm");
+    objectStream->dict()->insertInt("N", SkToInt(fObjectStreamMembers.size()));
+    objectStream->dict()->insertInt("First", SkToInt(first));
+    fObjNumMap.addObjectRecursively(objectStream.get());
+
+    int32_t objectStreamNumber = SkToS32(fObjNumMap.objects().size());
+    if (fObjectStreamLocations.size() < fObjNumMap.objects().size()) {
+        fObjectStreamLocations.resize(fObjNumMap.objects().size());
+    }
+    for (size_t i = 0; i < fObjectStreamMembers.size(); ++i) {
+        fObjectStreamLocations[fObjectStreamMembers[i].fIndex] = {objectStreamNumber, SkToS32(i)};
+    }
+    fObjectStreamMembers.clear();
+}
+
+// The cross-reference stream replaces both the xref table and the trailer.  Each entry is a
+// one byte type, then a four byte offset (type 1) or object stream number (type 2), then a two
+// byte generation number (type 1) or index within the object stream (type 2).
+void SkPDFObjectSerializer::serializeXRefStream(SkWStream* wStream,
+                                                const sk_sp<SkPDFObject>& docCatalog,
+                                                sk_sp<SkPDFObject> id) {
+    int32_t xRefFileOffset = this->offset(wStream);
+    // The xref stream is an object too, the one after all the others.
+    int32_t xRefNumber = SkToS32(fOffsets.size() + 1);
+    int32_t objCount = xRefNumber + 1;
+    fObjectStreamLocations.resize(fOffsets.size());
+
+    SkDynamicMemoryWStream entries;
+    auto writeEntry = [&entries](uint8_t type, uint32_t field2, uint16_t field3) {
+        uint8_t entry[7] = {
+            type,
+            SkToU8(field2 >> 24), SkToU8(field2 >> 16), SkToU8(field2 >> 8), SkToU8(field2),
+            SkToU8(field3 >> 8), SkToU8(field3),
+        };
+        entries.write(entry, sizeof(entry));
+    };
+    writeEntry(0, 0, 0xFFFF);
+    for (size_t i = 0; i < fOffsets.size(); i++) {
+        const ObjectStreamLocation& location = fObjectStreamLocations[i];
+        if (location.fObjectStream) {
+            writeEntry(2, location.fObjectStream, SkToU16(location.fIndex));
+        } else {
+            writeEntry(1, fOffsets[i], 0);
+        }
+    }
+    writeEntry(1, xRefFileOffset, 0);
+
+    SkPDFStream xRefStream(entries.detachAsStream());
+    SkPDFDict* dict = xRefStream.dict();
+    dict->insertName("Type", "XRef");
+    dict->insertInt("Size", objCount);
+    dict->insertObject("W", SkPDFMakeArray(1, 4, 2));
+    SkASSERT(docCatalog);
+    dict->insertObjRef("Root", docCatalog);
+    SkASSERT(fInfoDict);
+    dict->insertObjRef("Info", std::move(fInfoDict));
+    if (id) {
+        dict->insertObject("ID", std::move(id));
+    }
+    wStream->writeDecAsText(xRefNumber);
+    wStream->writeText(" 0 obj\n");
+    xRefStream.emitObject(wStream, fObjNumMap);
+    wStream->writeText("\nendobj\n");
+    wStream->writeText("startxref\n");
+    wStream->writeBigDecAsText(xRefFileOffset);
+    wStream->writeText("\n%%EOF");
 }
 
 // Xref table and footer
@@ -87,6 +257,12 @@ void SkPDFObjectSerializer::serializeFooter(SkWStream* wStream,
                                             const sk_sp<SkPDFObject> docCatalog,
                                             sk_sp<SkPDFObject> id) {
     this->serializeObjects(wStream);
+    SkASSERT(fDeferredIndices.empty());
+    SkASSERT(fOffsets.size() == fObjNumMap.objects().size());
+    if (fUseObjectStreams) {
+        this->serializeXRefStream(wStream, docCatalog, std::move(id));
+        return;
+    }
     int32_t xRefFileOffset = this->offset(wStream);
     // Include the special zeroth object in the count.
     int32_t objCount = SkToS32(fOffsets.size() + 1);
@@ -113,6 +289,402 @@ void SkPDFObjectSerializer::serializeFooter(SkWStream* wStream,
     wStream->writeText("\n%%EOF");
 }
 
+// Writes the big-endian bit fields that linearization hint tables are made of.
+class SkPDFHintTableWriter {
+public:
+    void write(uint32_t value, int bits) {
+        SkASSERT(bits == 32 || (bits < 32 && (value >> bits) == 0));
+        for (int i = bits - 1; i >= 0; --i) {
+            fByte = (fByte << 1) | ((value >> i) & 1);
+            if (++fBitCount == 8) {
+                fData.write8(fByte);
+                fByte = 0;
+                fBitCount = 0;
+            }
+        }
+    }
+    // Each table, and each item of its entries, starts on a byte boundary.
+    void align() {
+        if (fBitCount > 0) {
+            this->write(0, 8 - fBitCount);
+        }
+    }
+    size_t bytesWritten() const {
+        SkASSERT(fBitCount == 0);
+        return fData.bytesWritten();
+    }
+    sk_sp<SkData> detachAsData() {
+        this->align();
+        return fData.detachAsData();
+    }
+
+private:
+    SkDynamicMemoryWStream fData;
+    uint32_t fByte = 0;
+    int fBitCount = 0;
+};
+
+static int bits_needed(uint32_t value) { return 32 - SkCLZ(value); }
+
+// One item of the per-page or per-shared-object-group hint entries.  Each value is stored as
+// its difference from the least one, in as many bits as the largest difference needs.
+struct SkPDFHintItem {
+    uint32_t fLeast;
+    int fBits;
+
+    explicit SkPDFHintItem(const std::vector<uint32_t>& values) {
+        SkASSERT(!values.empty());
+        auto minMax = std::minmax_element(values.begin(), values.end());
+        fLeast = *minMax.first;
+        fBits = bits_needed(*minMax.second - fLeast);
+    }
+    void writeEntries(SkPDFHintTableWriter* writer, const std::vector<uint32_t>& values) const {
+        for (uint32_t value : values) {
+            writer->write(value - fLeast, fBits);
+        }
+        writer->align();
+    }
+};
+
+// What the hint tables of a linearized file say about it.  Offsets are from the start of the
+// body, which starts with the first page.
+struct SkPDFLinearizedLayout {
+    struct Page {
+        uint32_t fOffset;          // of the page object; the other objects of the page follow.
+        uint32_t fLength;
+        uint32_t fObjectCount;
+        uint32_t fContentOffset;   // from fOffset
+        uint32_t fContentLength;
+        std::vector<uint32_t> fSharedGroups;  // Indices into fGroupLengths.
+    };
+    std::vector<Page> fPages;
+    // Every object of the first page is a group of its own, and so is every object shared by
+    // the other pages.
+    std::vector<uint32_t> fGroupLengths;
+    uint32_t fFirstPageGroupCount;
+    uint32_t fFirstSharedNumber;  // Zero if no objects are shared by the other pages.
+    uint32_t fFirstSharedOffset;
+};
+
+// The page offset hint table, then the shared object hint table (PDF 32000-1:2008, F.4).
+// Offsets in hint tables disregard the hint stream itself, so bodyOffset is where the body
+// would start without it.
+static sk_sp<SkData> make_hint_tables(const SkPDFLinearizedLayout& layout, uint32_t bodyOffset,
+                                      size_t* sharedTableOffset) {
+    std::vector<uint32_t> objectCounts, lengths, sharedCounts, contentOffsets, contentLengths;
+    uint32_t maxSharedGroup = 0;
+    for (const SkPDFLinearizedLayout::Page& page : layout.fPages) {
+        objectCounts.push_back(page.fObjectCount);
+        lengths.push_back(page.fLength);
+        sharedCounts.push_back(SkToU32(page.fSharedGroups.size()));
+        contentOffsets.push_back(page.fContentOffset);
+        contentLengths.push_back(page.fContentLength);
+        for (uint32_t group : page.fSharedGroups) {
+            maxSharedGroup = SkTMax(maxSharedGroup, group);
+        }
+    }
+    SkPDFHintItem objectCountItem(objectCounts), lengthItem(lengths),
+                  contentOffsetItem(contentOffsets), contentLengthItem(contentLengths);
+    const int sharedCountBits =
+            bits_needed(*std::max_element(sharedCounts.begin(), sharedCounts.end()));
+    const int sharedGroupBits = bits_needed(maxSharedGroup);
+
+    SkPDFHintTableWriter writer;
+    writer.write(objectCountItem.fLeast, 32);
+    writer.write(bodyOffset + layout.fPages[0].fOffset, 32);
+    writer.write(objectCountItem.fBits, 16);
+    writer.write(lengthItem.fLeast, 32);
+    writer.write(lengthItem.fBits, 16);
+    writer.write(contentOffsetItem.fLeast, 32);
+    writer.write(contentOffsetItem.fBits, 16);
+    writer.write(contentLengthItem.fLeast, 32);
+    writer.write(contentLengthItem.fBits, 16);
+    writer.write(sharedCountBits, 16);
+    writer.write(sharedGroupBits, 16);
+    writer.write(0, 16);  // Bits for where in the page a shared object is needed: none.
+    writer.write(4, 16);  // Denominator of that position.
+    objectCountItem.writeEntries(&writer, objectCounts);
+    lengthItem.writeEntries(&writer, lengths);
+    for (uint32_t count : sharedCounts) {
+        writer.write(count, sharedCountBits);
+    }
+    writer.align();
+    for (const SkPDFLinearizedLayout::Page& page : layout.fPages) {
+        for (uint32_t group : page.fSharedGroups) {
+            writer.write(group, sharedGroupBits);
+        }
+    }
+    writer.align();
+    contentOffsetItem.writeEntries(&writer, contentOffsets);
+    contentLengthItem.writeEntries(&writer, contentLengths);
+
+    *sharedTableOffset = writer.bytesWritten();
+    SkPDFHintItem groupLengthItem(layout.fGroupLengths);
+    const bool hasShared = layout.fFirstSharedNumber != 0;
+    writer.write(layout.fFirstSharedNumber, 32);
+    writer.write(hasShared ? bodyOffset + layout.fFirstSharedOffset : 0, 32);
+    writer.write(layout.fFirstPageGroupCount, 32);
+    writer.write(SkToU32(layout.fGroupLengths.size()), 32);
+    writer.write(0, 16);  // Bits for the object count of a group, less one: always zero.
+    writer.write(groupLengthItem.fLeast, 32);
+    writer.write(groupLengthItem.fBits, 16);
+    groupLengthItem.writeEntries(&writer, layout.fGroupLengths);
+    for (size_t i = 0; i < layout.fGroupLengths.size(); ++i) {
+        writer.write(0, 1);  // No MD5 signatures.
+    }
+    return writer.detachAsData();
+}
+
+// A linearized file (PDF 32000-1:2008, Annex F) is laid out as
+//   header, linearization dictionary, first-page xref and trailer, catalog, hint stream,
+//   the first page and everything it uses,
+//   each other page followed by what only it uses,
+//   what the other pages share, then everything else,
+//   main xref and trailer.
+// The linearization dictionary through the first page are numbered after everything else, so
+// that each xref section is one run of object numbers.  All objects are written to memory
+// first.  The front of the file only depends on where they ended up, and on its own size,
+// so it is rewritten until its size stops changing.
+void SkPDFObjectSerializer::serializeLinearized(
+        SkWStream* wStream, const SkPDF::Metadata& md, const sk_sp<SkPDFObject>& docCatalog,
+        const std::vector<std::vector<sk_sp<SkPDFObject>>>& pageObjects,
+        const std::vector<sk_sp<SkPDFObject>>& pageContents, sk_sp<SkPDFObject> id) {
+    SkASSERT(!pageObjects.empty() && pageObjects.size() == pageContents.size());
+    fInfoDict = SkPDFMetadata::MakeDocumentInformationDict(md);
+    if (fPrepareTasks) {
+        this->addObjectRecursively(docCatalog);
+        this->addObjectRecursively(fInfoDict);
+        this->prepareObjects();
+        fPrepareTasks->wait();
+    }
+
+    SkTHashMap<const SkPDFObject*, int> pageCounts;  // How many pages use each object.
+    for (const std::vector<sk_sp<SkPDFObject>>& objects : pageObjects) {
+        for (const sk_sp<SkPDFObject>& object : objects) {
+            int* count = pageCounts.find(object.get());
+            if (count) {
+                ++*count;
+            } else {
+                pageCounts.set(object.get(), 1);
+            }
+        }
+    }
+    auto isShared = [&pageCounts](const sk_sp<SkPDFObject>& object) {
+        return *pageCounts.find(object.get()) > 1;
+    };
+
+    SkPDFObjNumMap objNumMap;
+    for (size_t i = 1; i < pageObjects.size(); ++i) {
+        for (const sk_sp<SkPDFObject>& object : pageObjects[i]) {
+            if (!isShared(object)) {
+                objNumMap.addObject(object.get());
+            }
+        }
+    }
+    SkTHashSet<const SkPDFObject*> firstPage;
+    for (const sk_sp<SkPDFObject>& object : pageObjects[0]) {
+        firstPage.add(object.get());
+    }
+    const size_t sharedIndex = objNumMap.objects().size();
+    for (size_t i = 1; i < pageObjects.size(); ++i) {
+        for (const sk_sp<SkPDFObject>& object : pageObjects[i]) {
+            if (!firstPage.contains(object.get())) {
+                objNumMap.addObject(object.get());
+            }
+        }
+    }
+    const size_t sharedEnd = objNumMap.objects().size();
+    {
+        // Everything else is what the catalog and the document information reach without
+        // going through a page.
+        SkPDFObjNumMap reachable;
+        reachable.addObject(docCatalog.get());
+        for (const std::vector<sk_sp<SkPDFObject>>& objects : pageObjects) {
+            for (const sk_sp<SkPDFObject>& object : objects) {
+                reachable.addObject(object.get());
+            }
+        }
+        const size_t pagesEnd = reachable.objects().size();
+        docCatalog->addResources(&reachable);
+        reachable.addObjectRecursively(fInfoDict.get());
+        for (size_t i = pagesEnd; i < reachable.objects().size(); ++i) {
+            objNumMap.addObject(reachable.objects()[i].get());
+        }
+    }
+    const size_t mainCount = objNumMap.objects().size();
+    // The linearization dictionary and the hint stream are written by hand; these stand-ins
+    // only reserve their object numbers.
+    auto linearizationStandIn = sk_make_sp<SkPDFDict>();
+    auto hintStreamStandIn = sk_make_sp<SkPDFDict>();
+    objNumMap.addObject(linearizationStandIn.get());
+    objNumMap.addObject(docCatalog.get());
+    objNumMap.addObject(hintStreamStandIn.get());
+    const size_t firstPageIndex = objNumMap.objects().size();
+    for (const sk_sp<SkPDFObject>& object : pageObjects[0]) {
+        objNumMap.addObject(object.get());
+    }
+    const std::vector<sk_sp<SkPDFObject>>& objects = objNumMap.objects();
+    auto indexOf = [&objNumMap](const sk_sp<SkPDFObject>& object) {
+        return SkToSizeT(objNumMap.getObjectNumber(object.get()) - 1);
+    };
+
+    SkDynamicMemoryWStream catalog;
+    emit_indirect_object(&catalog, objNumMap.getObjectNumber(docCatalog.get()), *docCatalog,
+                         objNumMap);
+    docCatalog->drop();
+    SkDynamicMemoryWStream body;
+    std::vector<uint32_t> offsets(objects.size()), lengths(objects.size());
+    auto emit = [&](size_t index) {
+        offsets[index] = SkToU32(body.bytesWritten());
+        emit_indirect_object(&body, SkToS32(index + 1), *objects[index], objNumMap);
+        lengths[index] = SkToU32(body.bytesWritten()) - offsets[index];
+        objects[index]->drop();
+    };
+    for (size_t i = firstPageIndex; i < objects.size(); ++i) {
+        emit(i);
+    }
+    const size_t firstPageEnd = body.bytesWritten();
+    for (size_t i = 0; i < mainCount; ++i) {
+        emit(i);
+    }
+
+    SkPDFLinearizedLayout layout;
+    for (size_t i = 0; i < pageObjects.size(); ++i) {
+        SkPDFLinearizedLayout::Page page;
+        page.fOffset = offsets[indexOf(pageObjects[i][0])];
+        page.fLength = 0;
+        page.fObjectCount = 0;
+        for (const sk_sp<SkPDFObject>& object : pageObjects[i]) {
+            size_t index = indexOf(object);
+            if (i == 0 || !isShared(object)) {
+                page.fLength += lengths[index];
+                ++page.fObjectCount;
+            } else if (index >= firstPageIndex) {
+                page.fSharedGroups.push_back(SkToU32(index - firstPageIndex));
+            } else {
+                page.fSharedGroups.push_back(
+                        SkToU32(pageObjects[0].size() + index - sharedIndex));
+            }
+        }
+        size_t contentIndex = indexOf(pageContents[i]);
+        page.fContentOffset = offsets[contentIndex] - page.fOffset;
+        page.fContentLength = lengths[contentIndex];
+        layout.fPages.push_back(std::move(page));
+    }
+    for (size_t i = firstPageIndex; i < objects.size(); ++i) {
+        layout.fGroupLengths.push_back(lengths[i]);
+    }
+    for (size_t i = sharedIndex; i < sharedEnd; ++i) {
+        layout.fGroupLengths.push_back(lengths[i]);
+    }
+    layout.fFirstPageGroupCount = SkToU32(pageObjects[0].size());
+    layout.fFirstSharedNumber = sharedEnd > sharedIndex ? SkToU32(sharedIndex + 1) : 0;
+    layout.fFirstSharedOffset = sharedEnd > sharedIndex ? offsets[sharedIndex] : 0;
+
+    SkDynamicMemoryWStream header, linearization, xRef, hint, mainXRef;
+    write_header(&header, false);
+    size_t linearizationLength = 0, xRefLength = 0, hintLength = 0;
+    while (true) {
+        const size_t xRefOffset = header.bytesWritten() + linearizationLength;
+        const size_t catalogOffset = xRefOffset + xRefLength;
+        const size_t hintOffset = catalogOffset + catalog.bytesWritten();
+        const size_t bodyOffset = hintOffset + hintLength;
+        const size_t mainXRefOffset = bodyOffset + body.bytesWritten();
+
+        size_t sharedTableOffset;
+        sk_sp<SkData> hintTables = make_hint_tables(layout, SkToU32(hintOffset),
+                                                    &sharedTableOffset);
+        SkPDFDict hintDict;
+        hintDict.insertInt("S", SkToInt(sharedTableOffset));
+        hintDict.insertInt("Length", SkToInt(hintTables->size()));
+        hint.reset();
+        hint.writeDecAsText(objNumMap.getObjectNumber(hintStreamStandIn.get()));
+        hint.writeText(" 0 obj\n");
+        hintDict.emitObject(&hint, objNumMap);
+        hint.writeText(" stream\n");
+        hint.write(hintTables->data(), hintTables->size());
+        hint.writeText("\nendstream\nendobj\n");
+
+        mainXRef.reset();
+        mainXRef.writeText("xref\n0 ");
+        mainXRef.writeDecAsText(SkToS32(mainCount + 1));
+        mainXRef.writeText("\n");
+        // /T is the offset of the end of line right before the first entry.
+        const size_t mainXRefFirstEntry = mainXRefOffset + mainXRef.bytesWritten() - 1;
+        mainXRef.writeText("0000000000 65535 f \n");
+        for (size_t i = 0; i < mainCount; ++i) {
+            mainXRef.writeBigDecAsText(bodyOffset + offsets[i], 10);
+            mainXRef.writeText(" 00000 n \n");
+        }
+        SkPDFDict mainTrailer;
+        mainTrailer.insertInt("Size", SkToInt(mainCount + 1));
+        mainXRef.writeText("trailer\n");
+        mainTrailer.emitObject(&mainXRef, objNumMap);
+        // Readers that ignore linearization start from the first-page xref, which is the
+        // first in the chain of /Prev links.
+        mainXRef.writeText("\nstartxref\n");
+        mainXRef.writeBigDecAsText(xRefOffset);
+        mainXRef.writeText("\n%%EOF");
+        const size_t fileLength = mainXRefOffset + mainXRef.bytesWritten();
+
+        SkPDFDict linearizationDict;
+        linearizationDict.insertInt("Linearized", 1);
+        linearizationDict.insertInt("L", SkToInt(fileLength));
+        linearizationDict.insertObject(
+                "H", SkPDFMakeArray(SkToInt(hintOffset), SkToInt(hint.bytesWritten())));
+        linearizationDict.insertInt("O", SkToInt(firstPageIndex + 1));
+        linearizationDict.insertInt("E", SkToInt(bodyOffset + firstPageEnd));
+        linearizationDict.insertInt("N", SkToInt(pageObjects.size()));
+        linearizationDict.insertInt("T", SkToInt(mainXRefFirstEntry));
+        linearization.reset();
+        emit_indirect_object(&linearization,
+                             objNumMap.getObjectNumber(linearizationStandIn.get()),
+                             linearizationDict, objNumMap);
+
+        xRef.reset();
+        xRef.writeText("xref\n");
+        xRef.writeDecAsText(SkToS32(mainCount + 1));
+        xRef.writeText(" ");
+        xRef.writeDecAsText(SkToS32(objects.size() - mainCount));
+        xRef.writeText("\n");
+        for (size_t offset : {header.bytesWritten(), catalogOffset, hintOffset}) {
+            xRef.writeBigDecAsText(offset, 10);
+            xRef.writeText(" 00000 n \n");
+        }
+        for (size_t i = firstPageIndex; i < objects.size(); ++i) {
+            xRef.writeBigDecAsText(bodyOffset + offsets[i], 10);
+            xRef.writeText(" 00000 n \n");
+        }
+        SkPDFDict trailerDict;
+        trailerDict.insertInt("Size", SkToInt(objects.size() + 1));
+        trailerDict.insertObjRef("Root", docCatalog);
+        trailerDict.insertObjRef("Info", fInfoDict);
+        if (id) {
+            trailerDict.insertObject("ID", id);
+        }
+        trailerDict.insertInt("Prev", SkToInt(mainXRefOffset));
+        xRef.writeText("trailer\n");
+        trailerDict.emitObject(&xRef, objNumMap);
+        xRef.writeText("\nstartxref\n0\n%%EOF\n");
+
+        if (linearization.bytesWritten() == linearizationLength &&
+            xRef.bytesWritten() == xRefLength &&
+            hint.bytesWritten() == hintLength) {
+            break;
+        }
+        linearizationLength = linearization.bytesWritten();
+        xRefLength = xRef.bytesWritten();
+        hintLength = hint.bytesWritten();
+    }
+
+    fBaseOffset = wStream->bytesWritten();
+    for (SkDynamicMemoryWStream* part : {&header, &linearization, &xRef, &catalog, &hint,
+                                         &body, &mainXRef}) {
+        part->writeToAndReset(wStream);
+    }
+    fInfoDict = nullptr;
+}
+
 int32_t SkPDFObjectSerializer::offset(SkWStream* wStream) {
     size_t offset = wStream->bytesWritten();
     SkASSERT(offset > fBaseOffset);
@@ -187,6 +759,7 @@ static void reset_object(T* dst, Args&&... args) {
 SkPDFDocument::SkPDFDocument(SkWStream* stream,
                              SkPDF::Metadata metadata)
     : SkDocument(stream)
+    , fObjectSerializer(metadata)
     , fMetadata(std::move(metadata)) {
     constexpr float kDpiForRasterScaleOne = 72.0f;
     if (fMetadata.fRasterDPI != kDpiForRasterScaleOne) {
@@ -196,6 +769,7 @@ SkPDFDocument::SkPDFDocument(SkWStream* stream,
     if (fMetadata.fStructureElementTreeRoot) {
         fTagRoot = recursiveBuildTagTree(*fMetadata.fStructureElementTreeRoot, nullptr);
     }
+    fCanon.fFontCache = static_cast<SkPDFFontCache*>(fMetadata.fFontCache.get());
 }
 
 SkPDFDocument::~SkPDFDocument() {
@@ -205,7 +779,11 @@ SkPDFDocument::~SkPDFDocument() {
 
 void SkPDFDocument::serialize(const sk_sp<SkPDFObject>& object) {
     fObjectSerializer.addObjectRecursively(object);
-    fObjectSerializer.serializeObjects(this->getStream());
+    if (fObjectSerializer.fPrepareTasks) {
+        fObjectSerializer.prepareObjects();
+    } else if (!fMetadata.fLinearize) {
+        fObjectSerializer.serializeObjects(this->getStream());
+    }
 }
 
 static SkSize operator*(SkISize u, SkScalar s) { return SkSize{u.width() * s, u.height() * s}; }
@@ -215,8 +793,16 @@ SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height) {
     SkASSERT(fCanvas.imageInfo().dimensions().isZero());
     if (fPages.empty()) {
         // if this is the first page if the document.
-        fObjectSerializer.serializeHeader(this->getStream(), fMetadata);
+        if (!fMetadata.fLinearize) {
+            fObjectSerializer.serializeHeader(this->getStream(), fMetadata);
+        }
         fDests = sk_make_sp<SkPDFDict>();
+        if (fMetadata.fStreamPages) {
+            // Pages are written as they end, so they need a parent to refer to right away.
+            // The root's kids are only known at the end.
+            fPageTreeRoot = sk_make_sp<SkPDFDict>("Pages");
+            fObjectSerializer.defer(fPageTreeRoot.get());
+        }
         if (fMetadata.fPDFA) {
             SkPDFMetadata::UUID uuid = SkPDFMetadata::CreateUUID(fMetadata);
             // We use the same UUID for Document ID and Instance ID since this
@@ -226,8 +812,7 @@ SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height) {
             // works best with reproducible outputs.
             fID = SkPDFMetadata::MakePdfId(uuid, uuid);
             fXMP = SkPDFMetadata::MakeXMPObject(fMetadata, uuid, uuid);
-            fObjectSerializer.addObjectRecursively(fXMP);
-            fObjectSerializer.serializeObjects(this->getStream());
+            this->serialize(fXMP);
         }
     }
     // By scaling the page at the device level, we will create bitmap layer
@@ -241,6 +826,7 @@ SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height) {
     initialTransform.setScaleTranslate(fInverseRasterScale, -fInverseRasterScale,
                                        0, fInverseRasterScale * pageSize.height());
     fPageDevice = sk_make_sp<SkPDFDevice>(pageSize, this, initialTransform);
+    fPageDevice->setDeflateChunkSize(fMetadata.fPageContentChunkSize);
     reset_object(&fCanvas, fPageDevice);
     fCanvas.scale(fRasterScale, fRasterScale);
     return &fCanvas;
@@ -255,7 +841,7 @@ void SkPDFDocument::onEndPage() {
     auto page = sk_make_sp<SkPDFDict>("Page");
 
     SkSize mediaSize = fPageDevice->imageInfo().dimensions() * fInverseRasterScale;
-    auto contentObject = sk_make_sp<SkPDFStream>(fPageDevice->content());
+    auto contentObject = fPageDevice->makeContentStream(fMetadata.fExecutor != nullptr);
     auto resourceDict = fPageDevice->makeResourceDict();
     auto annotations = fPageDevice->getAnnotations();
     fPageDevice->appendDestinations(fDests.get(), page.get());
@@ -268,11 +854,23 @@ void SkPDFDocument::onEndPage() {
         page->insertObject("Annots", std::move(annotations));
     }
     this->serialize(contentObject);
+    if (fMetadata.fLinearize) {
+        fPageContents.push_back(contentObject);
+    }
     page->insertObjRef("Contents", std::move(contentObject));
     // The StructParents unique identifier for each page is just its
     // 0-based page index.
     page->insertInt("StructParents", static_cast<int>(fPages.size()));
+    if (fPageTreeRoot) {
+        // Write the page, and everything it uses that isn't deferred, and let go of it.
+        page->insertObjRef("Parent", fPageTreeRoot);
+        this->serialize(page);
+    }
     fPages.emplace_back(std::move(page));
+    if (!fMetadata.fLinearize) {
+        // Write out anything serialize() only prepared.
+        fObjectSerializer.serializeObjects(this->getStream());
+    }
 }
 
 void SkPDFDocument::onAbort() {
@@ -284,6 +882,8 @@ void SkPDFDocument::reset() {
     fCanon = SkPDFCanon();
     reset_object(&fCanvas);
     fPages = std::vector<sk_sp<SkPDFDict>>();
+    fPageContents = std::vector<sk_sp<SkPDFObject>>();
+    fPageTreeRoot = nullptr;
     fFonts.reset();
     fDests = nullptr;
     fPageDevice = nullptr;
@@ -481,6 +1081,36 @@ void SkPDFDocument::onClose(SkWStream* stream) {
         this->reset();
         return;
     }
+    // Build font subsetting info before calling addObjectRecursively(), or
+    // collecting the objects of each page.
+    SkPDFCanon* canon = &fCanon;
+    if (fMetadata.fExecutor) {
+        // Each font only changes itself, and the canon is only read once its per-typeface
+        // caches are filled in, so the fonts can be subset concurrently.
+        std::vector<SkPDFFont*> fonts;
+        fFonts.foreach([&fonts, canon](SkPDFFont* p) {
+            SkPDFFont::GetMetrics(p->typeface(), canon);
+            SkPDFFont::GetUnicodeMap(p->typeface(), canon);
+            fonts.push_back(p);
+        });
+        SkTaskGroup(*fMetadata.fExecutor).batch(SkToInt(fonts.size()), [&fonts, canon](int i) {
+            fonts[i]->getFontSubset(canon);
+        });
+    } else {
+        fFonts.foreach([canon](SkPDFFont* p){ p->getFontSubset(canon); });
+    }
+
+    std::vector<std::vector<sk_sp<SkPDFObject>>> pageObjects;
+    if (fMetadata.fLinearize) {
+        // Collect these before the page tree makes every page reach every other page.
+        pageObjects.reserve(fPages.size());
+        for (const sk_sp<SkPDFDict>& page : fPages) {
+            SkPDFObjNumMap pageObjNumMap;
+            pageObjNumMap.addObjectRecursively(page.get());
+            pageObjects.push_back(pageObjNumMap.objects());
+        }
+    }
+
     auto docCatalog = sk_make_sp<SkPDFDict>("Catalog");
     if (fMetadata.fPDFA) {
         SkASSERT(fXMP);
@@ -490,7 +1120,20 @@ void SkPDFDocument::onClose(SkWStream* stream) {
         docCatalog->insertObject("OutputIntents", make_srgb_output_intents());
     }
 
-    sk_sp<SkPDFDict> pageTree = generate_page_tree(fPages);
+    sk_sp<SkPDFDict> pageTree;
+    if (fPageTreeRoot) {
+        // Every page already points at the root, so the tree is flat.
+        pageTree = std::move(fPageTreeRoot);
+        auto kids = sk_make_sp<SkPDFArray>();
+        kids->reserve(fPages.size());
+        for (const sk_sp<SkPDFDict>& page : fPages) {
+            kids->appendObjRef(page);
+        }
+        pageTree->insertInt("Count", SkToInt(fPages.size()));
+        pageTree->insertObject("Kids", std::move(kids));
+    } else {
+        pageTree = generate_page_tree(fPages);
+    }
     pageTree->insertObject("Resources", make_top_resource_dict());
     docCatalog->insertObjRef("Pages", std::move(pageTree));
     if (fDests->size() > 0) {
@@ -544,9 +1187,13 @@ void SkPDFDocument::onClose(SkWStream* stream) {
         }
     }
 
-    // Build font subsetting info before calling addObjectRecursively().
-    SkPDFCanon* canon = &fCanon;
-    fFonts.foreach([canon](SkPDFFont* p){ p->getFontSubset(canon); });
+    if (fMetadata.fLinearize) {
+        fObjectSerializer.serializeLinearized(this->getStream(), fMetadata, docCatalog,
+                                              pageObjects, fPageContents, fID);
+        this->reset();
+        return;
+    }
+    fObjectSerializer.serializeDeferredObjects(this->getStream());
     fObjectSerializer.addObjectRecursively(docCatalog);
     fObjectSerializer.serializeObjects(this->getStream());
     fObjectSerializer.serializeFooter(this->getStream(), docCatalog, fID);
@@ -569,6 +1216,10 @@ sk_sp<SkDocument> SkPDF::MakeDocument(SkWStream* stream, const SkPDF::Metadata&
     if (meta.fEncodingQuality < 0) {
         meta.fEncodingQuality = 0;
     }
+    if (meta.fLinearize) {
+        meta.fStreamPages = false;
+        meta.fUseObjectStreams = false;
+    }
     return stream ? sk_make_sp<SkPDFDocument>(stream, std::move(meta)) : nullptr;
 }
 
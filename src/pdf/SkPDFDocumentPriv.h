@@ -12,9 +12,12 @@
 #include "SkPDFCanon.h"
 #include "SkPDFFont.h"
 #include "SkPDFMetadata.h"
+#include "SkStream.h"
 
+class SkExecutor;
 class SkPDFDevice;
 class SkPDFTag;
+class SkTaskGroup;
 
 const char* SkPDFGetNodeIdKey();
 
@@ -26,8 +29,31 @@ struct SkPDFObjectSerializer {
     sk_sp<SkPDFObject> fInfoDict;
     size_t fBaseOffset;
     size_t fNextToBeSerialized;  // index in fObjNumMap
+    size_t fNextToBePrepared;    // index in fObjNumMap
+    // Non-null if objects are prepared concurrently; see SkPDFObject::prepare().
+    std::unique_ptr<SkTaskGroup> fPrepareTasks;
+    // Objects that serializeObjects() numbers but does not write yet, and the indices of the
+    // ones it has skipped.  They are written by serializeDeferredObjects().
+    SkTHashSet<const SkPDFObject*> fDeferred;
+    std::vector<size_t> fDeferredIndices;
+    // With object streams, the objects waiting for the next object stream, as indices and
+    // offsets in fObjectStreamBody, and where every object that went into one ended up.
+    struct ObjectStreamMember {
+        size_t fIndex;
+        size_t fOffset;
+    };
+    struct ObjectStreamLocation {
+        int32_t fObjectStream = 0;  // Object number of the object stream; zero if none.
+        int32_t fIndex = 0;
+    };
+    static constexpr size_t kMaxObjectStreamMembers = 200;
+    bool fUseObjectStreams;
+    std::vector<ObjectStreamMember> fObjectStreamMembers;
+    SkDynamicMemoryWStream fObjectStreamBody;
+    std::vector<ObjectStreamLocation> fObjectStreamLocations;  // by index in fObjNumMap
 
     SkPDFObjectSerializer();
+    explicit SkPDFObjectSerializer(const SkPDF::Metadata&);
     ~SkPDFObjectSerializer();
     SkPDFObjectSerializer(SkPDFObjectSerializer&&);
     SkPDFObjectSerializer& operator=(SkPDFObjectSerializer&&);
@@ -35,15 +61,34 @@ struct SkPDFObjectSerializer {
     SkPDFObjectSerializer& operator=(const SkPDFObjectSerializer&) = delete;
 
     void addObjectRecursively(const sk_sp<SkPDFObject>&);
+    // Starts preparing every object added since the last call, if there is an executor.
+    void prepareObjects();
     void serializeHeader(SkWStream*, const SkPDF::Metadata&);
     void serializeObjects(SkWStream*);
+    // Holds back an object that may still change after other objects refer to it.
+    void defer(const SkPDFObject* object) { fDeferred.add(object); }
+    // Writes the deferred objects.  Anything they have gained since they were added is added
+    // too, and written by the next serializeObjects().  Nothing is deferred afterwards.
+    void serializeDeferredObjects(SkWStream*);
+    void serializeObject(SkWStream*, size_t index);
+    // Adds an object stream holding fObjectStreamMembers to fObjNumMap.
+    void flushObjectStream();
     void serializeFooter(SkWStream*, const sk_sp<SkPDFObject>, sk_sp<SkPDFObject>);
+    void serializeXRefStream(SkWStream*, const sk_sp<SkPDFObject>&, sk_sp<SkPDFObject>);
+    // Writes the whole document as a linearized file, in place of serializeHeader() and
+    // everything after it.  pageObjects[i] holds every object page i uses, the page first;
+    // pageContents[i] is the page's content stream.
+    void serializeLinearized(SkWStream*, const SkPDF::Metadata&,
+                             const sk_sp<SkPDFObject>& docCatalog,
+                             const std::vector<std::vector<sk_sp<SkPDFObject>>>& pageObjects,
+                             const std::vector<sk_sp<SkPDFObject>>& pageContents,
+                             sk_sp<SkPDFObject> id);
     int32_t offset(SkWStream*);
 };
 
-/** Concrete implementation of SkDocument that creates PDF files. This
-    class does not produced linearized or optimized PDFs; instead it
-    it attempts to use a minimum amount of RAM. */
+/** Concrete implementation of SkDocument that creates PDF files. Unless
+    asked for a linearized PDF, this class does not produce linearized or
+    optimized PDFs; instead it attempts to use a minimum amount of RAM. */
 class SkPDFDocument : public SkDocument {
 public:
     SkPDFDocument(SkWStream*, SkPDF::Metadata);
@@ -61,10 +106,20 @@ public:
 
        It might go without saying that objects should not be changed
        after calling serialize, since those changes will be too late.
+
+       If the document has an executor, the objects are only prepared
+       (concurrently) here, and are written at the end of the page.  If it
+       is linearized, they are only written by close().
      */
     void serialize(const sk_sp<SkPDFObject>&);
     SkPDFCanon* canon() { return &fCanon; }
-    void registerFont(SkPDFFont* f) { fFonts.add(f); }
+    void registerFont(SkPDFFont* f) {
+        fFonts.add(f);
+        if (fMetadata.fStreamPages) {
+            // Fonts are subset at the end, when their glyph usage is known.
+            fObjectSerializer.defer(f);
+        }
+    }
     const SkPDF::Metadata& metadata() const { return fMetadata; }
 
     sk_sp<SkPDFDict> getPage(int pageIndex) const;
@@ -79,6 +134,8 @@ private:
     SkPDFCanon fCanon;
     SkCanvas fCanvas;
     std::vector<sk_sp<SkPDFDict>> fPages;
+    std::vector<sk_sp<SkPDFObject>> fPageContents;  // Only with fLinearize.
+    sk_sp<SkPDFDict> fPageTreeRoot;  // Only with fStreamPages; every page's parent.
     SkTHashSet<SkPDFFont*> fFonts;
     sk_sp<SkPDFDict> fDests;
     sk_sp<SkPDFDevice> fPageDevice;
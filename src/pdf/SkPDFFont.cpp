@@ -16,6 +16,7 @@
 #include "SkPDFCanon.h"
 #include "SkPDFConvertType1FontStream.h"
 #include "SkPDFDevice.h"
+#include "SkPDFFontCache.h"
 #include "SkPDFMakeCIDGlyphWidthsArray.h"
 #include "SkPDFMakeToUnicodeCmap.h"
 #include "SkPDFResourceDict.h"
@@ -141,10 +142,17 @@ const SkAdvancedTypefaceMetrics* SkPDFFont::GetMetrics(SkTypeface* typeface,
     if (std::unique_ptr<SkAdvancedTypefaceMetrics>* ptr = canon->fTypefaceMetrics.find(id)) {
         return ptr->get();  // canon retains ownership.
     }
+    std::unique_ptr<SkAdvancedTypefaceMetrics> cached;
+    if (canon->fFontCache && canon->fFontCache->findMetrics(id, &cached)) {
+        return canon->fTypefaceMetrics.set(id, std::move(cached))->get();
+    }
     int count = typeface->countGlyphs();
     if (count <= 0 || count > 1 + SkTo<int>(UINT16_MAX)) {
         // Cache nullptr to skip this check.  Use SkSafeUnref().
         canon->fTypefaceMetrics.set(id, nullptr);
+        if (canon->fFontCache) {
+            canon->fFontCache->addMetrics(id, nullptr);
+        }
         return nullptr;
     }
     std::unique_ptr<SkAdvancedTypefaceMetrics> metrics = typeface->getAdvancedMetrics();
@@ -179,6 +187,9 @@ const SkAdvancedTypefaceMetrics* SkPDFFont::GetMetrics(SkTypeface* typeface,
             metrics->fCapHeight = SkToS16(SkScalarRoundToInt(capHeight / 2));
         }
     }
+    if (canon->fFontCache) {
+        canon->fFontCache->addMetrics(id, metrics.get());
+    }
     return canon->fTypefaceMetrics.set(id, std::move(metrics))->get();
 }
 
@@ -190,8 +201,15 @@ const std::vector<SkUnichar>& SkPDFFont::GetUnicodeMap(const SkTypeface* typefac
     if (std::vector<SkUnichar>* ptr = canon->fToUnicodeMap.find(id)) {
         return *ptr;
     }
-    std::vector<SkUnichar> buffer(typeface->countGlyphs());
+    std::vector<SkUnichar> buffer;
+    if (canon->fFontCache && canon->fFontCache->findUnicodeMap(id, &buffer)) {
+        return *canon->fToUnicodeMap.set(id, std::move(buffer));
+    }
+    buffer.resize(typeface->countGlyphs());
     typeface->getGlyphToUnicodeMap(buffer.data());
+    if (canon->fFontCache) {
+        canon->fFontCache->addUnicodeMap(id, buffer);
+    }
     return *canon->fToUnicodeMap.set(id, std::move(buffer));
 }
 
@@ -345,7 +363,7 @@ static sk_sp<SkData> stream_to_data(std::unique_ptr<SkStreamAsset> stream) {
     return SkData::MakeFromStream(stream.get(), size);
 }
 
-static sk_sp<SkPDFStream> get_subset_font_stream(
+static sk_sp<SkData> get_subset_font_data(
         std::unique_ptr<SkStreamAsset> fontAsset,
         const SkPDFGlyphUse& glyphUsage,
         const char* fontName,
@@ -385,16 +403,43 @@ static sk_sp<SkPDFStream> get_subset_font_stream(
         return nullptr;
     }
     SkASSERT(subsetFont != nullptr);
-    auto subsetStream = sk_make_sp<SkPDFStream>(
-            SkData::MakeWithProc(
-                    subsetFont, subsetFontSize,
-                    [](const void* p, void*) { delete[] (unsigned char*)p; },
-                    nullptr));
-    subsetStream->dict()->insertInt("Length1", subsetFontSize);
-    return subsetStream;
+    return SkData::MakeWithProc(subsetFont, subsetFontSize,
+                                [](const void* p, void*) { delete[] (unsigned char*)p; },
+                                nullptr);
 }
 #endif  // SK_PDF_USE_SFNTLY
 
+namespace {
+// A direct object without references, written as another document once wrote it.
+class SkPDFEmittedObject final : public SkPDFObject {
+public:
+    explicit SkPDFEmittedObject(sk_sp<SkData> text) : fText(std::move(text)) {}
+    void emitObject(SkWStream* stream, const SkPDFObjNumMap&) const override {
+        SkASSERT(fText);
+        stream->write(fText->data(), fText->size());
+    }
+    void drop() override { fText = nullptr; }
+
+private:
+    sk_sp<SkData> fText;
+};
+}  // namespace
+
+// With a font cache, a typeface's whole font program is compressed once for every
+// document that embeds it, rather than once by each document as it is written.
+static void share_font_program(SkPDFSharedStream* stream, SkPDFFontCache* fontCache,
+                               SkFontID id) {
+    if (!fontCache) {
+        return;
+    }
+    sk_sp<SkData> compressed;
+    if (fontCache->findFontProgram(id, &compressed)) {
+        stream->setCompressedData(std::move(compressed));
+    } else {
+        fontCache->addFontProgram(id, stream->compressedData());
+    }
+}
+
 void SkPDFType0Font::getFontSubset(SkPDFCanon* canon) {
     const SkAdvancedTypefaceMetrics* metricsPtr =
         SkPDFFont::GetMetrics(this->typeface(), canon);
@@ -406,6 +451,16 @@ void SkPDFType0Font::getFontSubset(SkPDFCanon* canon) {
     SkTypeface* face = this->typeface();
     SkASSERT(face);
 
+    // Everything below that depends on the glyphs used may come from the font cache.
+    SkPDFFontCache* fontCache = canon->fFontCache;
+    SkPDFFontCache::SubsetKey subsetKey;
+    SkPDFFontCache::Subset subset;
+    bool subsetCached = false;
+    if (fontCache) {
+        subsetKey = SkPDFFontCache::MakeSubsetKey(face->uniqueID(), this->glyphUsage());
+        subsetCached = fontCache->findSubset(subsetKey, &subset);
+    }
+
     auto descriptor = sk_make_sp<SkPDFDict>("FontDescriptor");
     uint16_t emSize = SkToU16(this->typeface()->getUnitsPerEm());
     add_common_font_descriptor_entries(descriptor.get(), metrics, emSize , 0);
@@ -421,13 +476,30 @@ void SkPDFType0Font::getFontSubset(SkPDFCanon* canon) {
         switch (type) {
             case SkAdvancedTypefaceMetrics::kTrueType_Font: {
                 #ifdef SK_PDF_USE_SFNTLY
+                // A cached subset without a font program is one that could not be subset.
                 if (!SkToBool(metrics.fFlags &
-                              SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
+                              SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag) &&
+                    (!subsetCached || subset.fFontFile)) {
                     SkASSERT(this->firstGlyphID() == 1);
-                    sk_sp<SkPDFStream> subsetStream = get_subset_font_stream(
-                            std::move(fontAsset), this->glyphUsage(),
-                            metrics.fFontName.c_str(), ttcIndex);
-                    if (subsetStream) {
+                    if (!subsetCached) {
+                        subset.fFontFile = get_subset_font_data(
+                                std::move(fontAsset), this->glyphUsage(),
+                                metrics.fFontName.c_str(), ttcIndex);
+                    }
+                    if (subset.fFontFile) {
+                        // Made the same way with or without the cache, so the output matches.
+                        sk_sp<SkPDFStream> subsetStream;
+                        if (subset.fStoredFontFile) {
+                            subsetStream = SkPDFStream::MakeStored(subset.fStoredFontFile,
+                                                                   subset.fFontFileDeflated);
+                        } else {
+                            subsetStream = sk_make_sp<SkPDFStream>(subset.fFontFile);
+                            if (fontCache) {
+                                subset.fStoredFontFile =
+                                        subsetStream->storedData(&subset.fFontFileDeflated);
+                            }
+                        }
+                        subsetStream->dict()->insertInt("Length1", subset.fFontFile->size());
                         descriptor->insertObjRef("FontFile2", std::move(subsetStream));
                         break;
                     }
@@ -440,12 +512,14 @@ void SkPDFType0Font::getFontSubset(SkPDFCanon* canon) {
                 #endif  // SK_PDF_USE_SFNTLY
                 auto fontStream = sk_make_sp<SkPDFSharedStream>(std::move(fontAsset));
                 fontStream->dict()->insertInt("Length1", fontSize);
+                share_font_program(fontStream.get(), fontCache, face->uniqueID());
                 descriptor->insertObjRef("FontFile2", std::move(fontStream));
                 break;
             }
             case SkAdvancedTypefaceMetrics::kType1CID_Font: {
                 auto fontStream = sk_make_sp<SkPDFSharedStream>(std::move(fontAsset));
                 fontStream->dict()->insertName("Subtype", "CIDFontType0C");
+                share_font_program(fontStream.get(), fontCache, face->uniqueID());
                 descriptor->insertObjRef("FontFile3", std::move(fontStream));
                 break;
             }
@@ -475,18 +549,28 @@ void SkPDFType0Font::getFontSubset(SkPDFCanon* canon) {
     sysInfo->insertInt("Supplement", 0);
     newCIDFont->insertObject("CIDSystemInfo", std::move(sysInfo));
 
-    int16_t defaultWidth = 0;
-    {
+    if (subsetCached) {
+        if (subset.fWidths) {
+            newCIDFont->insertObject("W", sk_make_sp<SkPDFEmittedObject>(subset.fWidths));
+        }
+    } else {
         int emSize;
+        int16_t defaultWidth = 0;
         auto glyphCache = SkPDFFont::MakeVectorCache(face, &emSize);
         sk_sp<SkPDFArray> widths = SkPDFMakeCIDGlyphWidthsArray(
                 glyphCache.get(), &this->glyphUsage(), SkToS16(emSize), &defaultWidth);
+        subset.fDefaultWidth = scaleFromFontUnits(defaultWidth, SkToS16(emSize));
         if (widths && widths->size() > 0) {
+            if (fontCache) {
+                // The array only holds numbers, so its text is the same in every document.
+                SkDynamicMemoryWStream widthsText;
+                widths->emitObject(&widthsText, SkPDFObjNumMap());
+                subset.fWidths = widthsText.detachAsData();
+            }
             newCIDFont->insertObject("W", std::move(widths));
         }
-        newCIDFont->insertScalar(
-                "DW", scaleFromFontUnits(defaultWidth, SkToS16(emSize)));
     }
+    newCIDFont->insertScalar("DW", subset.fDefaultWidth);
 
     ////////////////////////////////////////////////////////////////////////////
 
@@ -497,15 +581,20 @@ void SkPDFType0Font::getFontSubset(SkPDFCanon* canon) {
     descendantFonts->appendObjRef(std::move(newCIDFont));
     this->insertObject("DescendantFonts", std::move(descendantFonts));
 
-    const std::vector<SkUnichar>& glyphToUnicode =
-        SkPDFFont::GetUnicodeMap(this->typeface(), canon);
-    SkASSERT(SkToSizeT(this->typeface()->countGlyphs()) == glyphToUnicode.size());
-    this->insertObjRef("ToUnicode",
-                       SkPDFMakeToUnicodeCmap(glyphToUnicode.data(),
-                                              &this->glyphUsage(),
-                                              this->multiByteGlyphs(),
-                                              this->firstGlyphID(),
-                                              this->lastGlyphID()));
+    if (!subsetCached) {
+        const std::vector<SkUnichar>& glyphToUnicode =
+            SkPDFFont::GetUnicodeMap(this->typeface(), canon);
+        SkASSERT(SkToSizeT(this->typeface()->countGlyphs()) == glyphToUnicode.size());
+        subset.fToUnicode = SkPDFMakeToUnicodeCmapData(glyphToUnicode.data(),
+                                                       &this->glyphUsage(),
+                                                       this->multiByteGlyphs(),
+                                                       this->firstGlyphID(),
+                                                       this->lastGlyphID());
+    }
+    this->insertObjRef("ToUnicode", sk_make_sp<SkPDFStream>(subset.fToUnicode));
+    if (fontCache && !subsetCached) {
+        fontCache->addSubset(subsetKey, std::move(subset));
+    }
     SkDEBUGCODE(fPopulated = true);
     return;
 }
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkPDFFontCache.h"
+
+#include "SkMakeUnique.h"
+#include "SkOpts.h"
+#include "SkPDFGlyphUse.h"
+
+sk_sp<SkPDF::FontCache> SkPDF::FontCache::Make(int subsetCount, size_t typefaceBytes) {
+    return sk_make_sp<SkPDFFontCache>(SkTMax(subsetCount, 1), typefaceBytes);
+}
+
+SkPDFFontCache::SkPDFFontCache(int subsetCount, size_t typefaceBytes)
+    : fTypefaceBudget(typefaceBytes), fSubsets(subsetCount) {}
+
+SkPDFFontCache::~SkPDFFontCache() {}
+
+SkPDFFontCache::Typeface* SkPDFFontCache::findTypeface(SkFontID id) {
+    std::unique_ptr<Typeface>* ptr = fTypefaces.find(id);
+    if (!ptr) {
+        return nullptr;
+    }
+    (*ptr)->fLastUse = ++fUseCount;
+    return ptr->get();
+}
+
+SkPDFFontCache::Typeface* SkPDFFontCache::makeTypeface(SkFontID id) {
+    if (Typeface* typeface = this->findTypeface(id)) {
+        return typeface;
+    }
+    Typeface* typeface = fTypefaces.set(id, skstd::make_unique<Typeface>())->get();
+    typeface->fLastUse = ++fUseCount;
+    this->addBytes(typeface, sizeof(Typeface));
+    return typeface;
+}
+
+void SkPDFFontCache::addBytes(Typeface* typeface, size_t bytes) {
+    typeface->fBytes += bytes;
+    fTypefaceBytes += bytes;
+    // Keep the typeface just added to, even if it is over budget on its own.
+    while (fTypefaceBytes > fTypefaceBudget && fTypefaces.count() > 1) {
+        SkFontID oldestID = 0;
+        const Typeface* oldest = nullptr;
+        fTypefaces.foreach([&](SkFontID id, std::unique_ptr<Typeface>* candidate) {
+            if (candidate->get() != typeface &&
+                (!oldest || (*candidate)->fLastUse < oldest->fLastUse)) {
+                oldestID = id;
+                oldest = candidate->get();
+            }
+        });
+        fTypefaceBytes -= oldest->fBytes;
+        fTypefaces.remove(oldestID);
+    }
+}
+
+bool SkPDFFontCache::findMetrics(SkFontID id,
+                                 std::unique_ptr<SkAdvancedTypefaceMetrics>* metrics) {
+    SkAutoMutexAcquire lock(fMutex);
+    Typeface* typeface = this->findTypeface(id);
+    if (!typeface || !typeface->fHasMetrics) {
+        return false;
+    }
+    *metrics = typeface->fMetrics
+             ? skstd::make_unique<SkAdvancedTypefaceMetrics>(*typeface->fMetrics) : nullptr;
+    return true;
+}
+
+void SkPDFFontCache::addMetrics(SkFontID id, const SkAdvancedTypefaceMetrics* metrics) {
+    SkAutoMutexAcquire lock(fMutex);
+    Typeface* typeface = this->makeTypeface(id);
+    if (typeface->fHasMetrics) {
+        return;
+    }
+    typeface->fHasMetrics = true;
+    size_t bytes = 0;
+    if (metrics) {
+        typeface->fMetrics = skstd::make_unique<SkAdvancedTypefaceMetrics>(*metrics);
+        bytes = sizeof(SkAdvancedTypefaceMetrics) +
+                metrics->fPostScriptName.size() + metrics->fFontName.size();
+    }
+    this->addBytes(typeface, bytes);
+}
+
+bool SkPDFFontCache::findUnicodeMap(SkFontID id, std::vector<SkUnichar>* map) {
+    SkAutoMutexAcquire lock(fMutex);
+    Typeface* typeface = this->findTypeface(id);
+    if (!typeface || !typeface->fHasUnicodeMap) {
+        return false;
+    }
+    *map = typeface->fUnicodeMap;
+    return true;
+}
+
+void SkPDFFontCache::addUnicodeMap(SkFontID id, const std::vector<SkUnichar>& map) {
+    SkAutoMutexAcquire lock(fMutex);
+    Typeface* typeface = this->makeTypeface(id);
+    if (typeface->fHasUnicodeMap) {
+        return;
+    }
+    typeface->fHasUnicodeMap = true;
+    typeface->fUnicodeMap = map;
+    this->addBytes(typeface, map.size() * sizeof(SkUnichar));
+}
+
+bool SkPDFFontCache::findFontProgram(SkFontID id, sk_sp<SkData>* compressed) {
+    SkAutoMutexAcquire lock(fMutex);
+    Typeface* typeface = this->findTypeface(id);
+    if (!typeface || !typeface->fFontProgram) {
+        return false;
+    }
+    *compressed = typeface->fFontProgram;
+    return true;
+}
+
+void SkPDFFontCache::addFontProgram(SkFontID id, sk_sp<SkData> compressed) {
+    SkASSERT(compressed);
+    SkAutoMutexAcquire lock(fMutex);
+    Typeface* typeface = this->makeTypeface(id);
+    if (typeface->fFontProgram) {
+        return;
+    }
+    size_t bytes = compressed->size();
+    typeface->fFontProgram = std::move(compressed);
+    this->addBytes(typeface, bytes);
+}
+
+SkPDFFontCache::SubsetKey SkPDFFontCache::MakeSubsetKey(SkFontID id,
+                                                         const SkPDFGlyphUse& glyphUsage) {
+    SubsetKey key;
+    key.fData.push_back(id);
+    key.fData.push_back(((uint32_t)glyphUsage.firstNonZero() << 16) | glyphUsage.lastGlyph());
+    glyphUsage.getSetValues([&key](unsigned gid) { key.fData.push_back(gid); });
+    return key;
+}
+
+uint32_t SkPDFFontCache::SubsetKeyHash::operator()(const SubsetKey& key) const {
+    return SkOpts::hash_fn(key.fData.data(), key.fData.size() * sizeof(uint32_t), 0);
+}
+
+bool SkPDFFontCache::findSubset(const SubsetKey& key, Subset* subset) {
+    SkAutoMutexAcquire lock(fMutex);
+    if (Subset* ptr = fSubsets.find(key)) {
+        *subset = *ptr;
+        return true;
+    }
+    return false;
+}
+
+void SkPDFFontCache::addSubset(const SubsetKey& key, Subset subset) {
+    SkAutoMutexAcquire lock(fMutex);
+    // Another document may have added the same subset since this one looked.
+    if (!fSubsets.find(key)) {
+        fSubsets.insert(key, std::move(subset));
+    }
+}
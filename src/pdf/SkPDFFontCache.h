@@ -0,0 +1,98 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#ifndef SkPDFFontCache_DEFINED
+#define SkPDFFontCache_DEFINED
+
+#include "SkAdvancedTypefaceMetrics.h"
+#include "SkData.h"
+#include "SkLRUCache.h"
+#include "SkMutex.h"
+#include "SkPDFDocument.h"
+#include "SkTHash.h"
+#include "SkTypeface.h"
+
+#include <memory>
+#include <vector>
+
+class SkPDFGlyphUse;
+
+/**
+ *  The SkPDF::FontCache shared by documents.  It only holds plain data,
+ *  never SkPDFObjects, since those belong to the document that writes
+ *  them; each document makes its own objects from what it finds here.
+ */
+class SkPDFFontCache final : public SkPDF::FontCache {
+public:
+    SkPDFFontCache(int subsetCount, size_t typefaceBytes);
+    ~SkPDFFontCache() override;
+
+    /** Returns false if the typeface has not been seen.  Otherwise sets
+        *metrics to a copy of its metrics, or to nullptr for a typeface
+        that can not be used. */
+    bool findMetrics(SkFontID, std::unique_ptr<SkAdvancedTypefaceMetrics>* metrics);
+    void addMetrics(SkFontID, const SkAdvancedTypefaceMetrics*);
+
+    bool findUnicodeMap(SkFontID, std::vector<SkUnichar>*);
+    void addUnicodeMap(SkFontID, const std::vector<SkUnichar>&);
+
+    /** The compressed font program of the whole typeface. */
+    bool findFontProgram(SkFontID, sk_sp<SkData>*);
+    void addFontProgram(SkFontID, sk_sp<SkData>);
+
+    /** What a Type0 font needs that depends on the glyphs it uses. */
+    struct Subset {
+        sk_sp<SkData> fFontFile;     // The subset font program, or nullptr for the whole font.
+        sk_sp<SkData> fStoredFontFile;  // fFontFile as its SkPDFStream writes it.
+        bool fFontFileDeflated = false;  // Whether fStoredFontFile is deflated.
+        sk_sp<SkData> fWidths;       // The W array, as it is written in the file.
+        SkScalar fDefaultWidth = 0;  // The DW value.
+        sk_sp<SkData> fToUnicode;    // The uncompressed ToUnicode CMap.
+    };
+
+    struct SubsetKey {
+        std::vector<uint32_t> fData;  // Typeface ID, glyph range, then every glyph used.
+        bool operator==(const SubsetKey& that) const { return fData == that.fData; }
+    };
+    static SubsetKey MakeSubsetKey(SkFontID, const SkPDFGlyphUse&);
+
+    bool findSubset(const SubsetKey&, Subset*);
+    void addSubset(const SubsetKey&, Subset);
+
+private:
+    struct SubsetKeyHash {
+        uint32_t operator()(const SubsetKey&) const;
+    };
+
+    // What is kept about one typeface.  SkFontIDs are never reused, so these
+    // are dropped, least recently used first, once they hold more than
+    // fTypefaceBudget bytes, or a process that keeps making typefaces would
+    // keep every one of their font programs.
+    struct Typeface {
+        bool fHasMetrics = false;
+        std::unique_ptr<SkAdvancedTypefaceMetrics> fMetrics;  // nullptr if not usable.
+        bool fHasUnicodeMap = false;
+        std::vector<SkUnichar> fUnicodeMap;
+        sk_sp<SkData> fFontProgram;  // Compressed.
+        size_t fBytes = 0;
+        uint64_t fLastUse = 0;
+    };
+
+    Typeface* findTypeface(SkFontID);  // Requires fMutex.
+    Typeface* makeTypeface(SkFontID);  // Requires fMutex.
+    void addBytes(Typeface*, size_t bytes);  // Requires fMutex.
+
+    SkMutex fMutex;
+    SkTHashMap<SkFontID, std::unique_ptr<Typeface>> fTypefaces;
+    size_t fTypefaceBytes = 0;
+    const size_t fTypefaceBudget;
+    uint64_t fUseCount = 0;
+    SkLRUCache<SubsetKey, Subset, SubsetKeyHash> fSubsets;
+
+    typedef SkPDF::FontCache INHERITED;
+};
+
+#endif  // SkPDFFontCache_DEFINED
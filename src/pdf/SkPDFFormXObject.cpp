@@ -14,7 +14,15 @@ sk_sp<SkPDFObject> SkPDFMakeFormXObject(std::unique_ptr<SkStreamAsset> content,
                                         sk_sp<SkPDFDict> resourceDict,
                                         const SkMatrix& inverseTransform,
                                         const char* colorSpace) {
-    auto form = sk_make_sp<SkPDFStream>(std::move(content));
+    return SkPDFMakeFormXObject(sk_make_sp<SkPDFStream>(std::move(content)), std::move(mediaBox),
+                                std::move(resourceDict), inverseTransform, colorSpace);
+}
+
+sk_sp<SkPDFObject> SkPDFMakeFormXObject(sk_sp<SkPDFStream> form,
+                                        sk_sp<SkPDFArray> mediaBox,
+                                        sk_sp<SkPDFDict> resourceDict,
+                                        const SkMatrix& inverseTransform,
+                                        const char* colorSpace) {
     form->dict()->insertName("Type", "XObject");
     form->dict()->insertName("Subtype", "Form");
     if (!inverseTransform.isIdentity()) {
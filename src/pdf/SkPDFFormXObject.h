@@ -22,4 +22,12 @@ sk_sp<SkPDFObject> SkPDFMakeFormXObject(std::unique_ptr<SkStreamAsset> content,
                                         sk_sp<SkPDFDict> resourceDict,
                                         const SkMatrix& inverseTransform,
                                         const char* colorSpace);
+
+/** As above, but the stream holding the content is already made, and this
+    fills in its dictionary. */
+sk_sp<SkPDFObject> SkPDFMakeFormXObject(sk_sp<SkPDFStream> form,
+                                        sk_sp<SkPDFArray> mediaBox,
+                                        sk_sp<SkPDFDict> resourceDict,
+                                        const SkMatrix& inverseTransform,
+                                        const char* colorSpace);
 #endif
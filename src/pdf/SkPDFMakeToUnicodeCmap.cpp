@@ -205,7 +205,7 @@ void SkPDFAppendCmapSections(const SkUnichar* glyphToUnicode,
     append_bfrange_section(bfrangeEntries, multiByteGlyphs, cmap);
 }
 
-sk_sp<SkPDFStream> SkPDFMakeToUnicodeCmap(
+sk_sp<SkData> SkPDFMakeToUnicodeCmapData(
         const SkUnichar* glyphToUnicode,
         const SkPDFGlyphUse* subset,
         bool multiByteGlyphs,
@@ -216,6 +216,15 @@ sk_sp<SkPDFStream> SkPDFMakeToUnicodeCmap(
     SkPDFAppendCmapSections(glyphToUnicode, subset, &cmap, multiByteGlyphs,
                             firstGlyphID, lastGlyphID);
     append_cmap_footer(&cmap);
-    return sk_make_sp<SkPDFStream>(
-            std::unique_ptr<SkStreamAsset>(cmap.detachAsStream()));
+    return cmap.detachAsData();
+}
+
+sk_sp<SkPDFStream> SkPDFMakeToUnicodeCmap(
+        const SkUnichar* glyphToUnicode,
+        const SkPDFGlyphUse* subset,
+        bool multiByteGlyphs,
+        SkGlyphID firstGlyphID,
+        SkGlyphID lastGlyphID) {
+    return sk_make_sp<SkPDFStream>(SkPDFMakeToUnicodeCmapData(
+            glyphToUnicode, subset, multiByteGlyphs, firstGlyphID, lastGlyphID));
 }
@@ -17,6 +17,14 @@ sk_sp<SkPDFStream> SkPDFMakeToUnicodeCmap(
         SkGlyphID firstGlyphID,
         SkGlyphID lastGlyphID);
 
+// The uncompressed CMap that SkPDFMakeToUnicodeCmap() puts in its stream.
+sk_sp<SkData> SkPDFMakeToUnicodeCmapData(
+        const SkUnichar* glyphToUnicode,
+        const SkPDFGlyphUse* subset,
+        bool multiByteGlyphs,
+        SkGlyphID firstGlyphID,
+        SkGlyphID lastGlyphID);
+
 // Exposed for unit testing.
 void SkPDFAppendCmapSections(const SkUnichar* glyphToUnicode,
                              const SkPDFGlyphUse* subset,
@@ -487,6 +487,7 @@ SkPDFSharedStream::~SkPDFSharedStream() { this->drop(); }
 
 void SkPDFSharedStream::drop() {
     fAsset = nullptr;;
+    fCompressedData = nullptr;
     fDict.drop();
 }
 
@@ -508,19 +509,33 @@ void SkPDFSharedStream::emitObject(
     SkStreamCopy(stream, dup.get());
     stream->writeText("\nendstream");
 }
+
+void SkPDFSharedStream::prepare() {}
 #else
-void SkPDFSharedStream::emitObject(
-        SkWStream* stream,
-        const SkPDFObjNumMap& objNumMap) const {
-    SkASSERT(fAsset);
+static sk_sp<SkData> deflate_asset(const SkStreamAsset& asset) {
     SkDynamicMemoryWStream buffer;
     SkDeflateWStream deflateWStream(&buffer);
-    // Since emitObject is const, this function doesn't change the dictionary.
-    std::unique_ptr<SkStreamAsset> dup(fAsset->duplicate());  // Cheap copy
+    std::unique_ptr<SkStreamAsset> dup(asset.duplicate());  // Cheap copy
     SkASSERT(dup);
     SkStreamCopy(&deflateWStream, dup.get());
     deflateWStream.finalize();
-    size_t length = buffer.bytesWritten();
+    return buffer.detachAsData();
+}
+
+void SkPDFSharedStream::prepare() {
+    SkASSERT(fAsset);
+    if (!fCompressedData) {
+        fCompressedData = deflate_asset(*fAsset);
+    }
+}
+
+void SkPDFSharedStream::emitObject(
+        SkWStream* stream,
+        const SkPDFObjNumMap& objNumMap) const {
+    SkASSERT(fAsset);
+    // Since emitObject is const, this function doesn't change the dictionary.
+    sk_sp<SkData> compressed = fCompressedData ? fCompressedData : deflate_asset(*fAsset);
+    size_t length = compressed->size();
     stream->writeText("<<");
     fDict.emitAll(stream, objNumMap);
     stream->writeText("\n");
@@ -533,11 +548,16 @@ void SkPDFSharedStream::emitObject(
     SkPDFUnion::Name("FlateDecode").emitObject(stream, objNumMap);
     stream->writeText(">>");
     stream->writeText(" stream\n");
-    buffer.writeToAndReset(stream);
+    stream->write(compressed->data(), length);
     stream->writeText("\nendstream");
 }
 #endif
 
+sk_sp<SkData> SkPDFSharedStream::compressedData() {
+    this->prepare();
+    return fCompressedData;
+}
+
 void SkPDFSharedStream::addResources(
         SkPDFObjNumMap* catalog) const {
     SkASSERT(fAsset);
@@ -559,13 +579,56 @@ SkPDFStream::SkPDFStream() {}
 
 SkPDFStream::~SkPDFStream() {}
 
+sk_sp<SkPDFStream> SkPDFStream::MakeDeferred(std::unique_ptr<SkStreamAsset> stream) {
+    SkASSERT(stream);
+    sk_sp<SkPDFStream> pdfStream(new SkPDFStream);
+    pdfStream->fDeferredData = std::move(stream);
+    return pdfStream;
+}
+
+sk_sp<SkPDFStream> SkPDFStream::MakeDeflated(std::unique_ptr<SkStreamAsset> deflated) {
+    SkASSERT(deflated && deflated->hasLength());
+    sk_sp<SkPDFStream> pdfStream(new SkPDFStream);
+    pdfStream->fDict.insertName("Filter", "FlateDecode");
+    pdfStream->fDict.insertInt("Length", deflated->getLength());
+    pdfStream->fCompressedData = std::move(deflated);
+    pdfStream->fDeflated = true;
+    return pdfStream;
+}
+
+sk_sp<SkPDFStream> SkPDFStream::MakeStored(sk_sp<SkData> stored, bool deflated) {
+    SkASSERT(stored);
+    if (deflated) {
+        return SkPDFStream::MakeDeflated(SkMemoryStream::Make(std::move(stored)));
+    }
+    sk_sp<SkPDFStream> pdfStream(new SkPDFStream);
+    pdfStream->fDict.insertInt("Length", stored->size());
+    pdfStream->fCompressedData = SkMemoryStream::Make(std::move(stored));
+    return pdfStream;
+}
+
+sk_sp<SkData> SkPDFStream::storedData(bool* deflated) const {
+    SkASSERT(fCompressedData && !fDeferredData);
+    std::unique_ptr<SkStreamAsset> dup(fCompressedData->duplicate());
+    SkASSERT(dup && dup->hasLength());
+    *deflated = fDeflated;
+    return SkData::MakeFromStream(dup.get(), dup->getLength());
+}
+
 void SkPDFStream::addResources(SkPDFObjNumMap* catalog) const {
-    SkASSERT(fCompressedData);
+    SkASSERT(fCompressedData || fDeferredData);
     fDict.addResources(catalog);
 }
 
+void SkPDFStream::prepare() {
+    if (fDeferredData) {
+        this->setData(std::move(fDeferredData));
+    }
+}
+
 void SkPDFStream::drop() {
     fCompressedData.reset(nullptr);
+    fDeferredData.reset(nullptr);
     fDict.drop();
 }
 
@@ -610,6 +673,7 @@ void SkPDFStream::setData(std::unique_ptr<SkStreamAsset> stream) {
         return;
     }
     fCompressedData = compressedData.detachAsStream();
+    fDeflated = true;
     fDict.insertName("Filter", "FlateDecode");
     fDict.insertInt("Length", compressedLength);
     #endif
@@ -618,13 +682,21 @@ void SkPDFStream::setData(std::unique_ptr<SkStreamAsset> stream) {
 ////////////////////////////////////////////////////////////////////////////////
 
 void SkPDFObjNumMap::addObjectRecursively(SkPDFObject* obj) {
-    if (obj && !fObjectNumbers.find(obj)) {
-        fObjectNumbers.set(obj, fObjectNumbers.count() + 1);
-        fObjects.emplace_back(sk_ref_sp(obj));
+    if (obj && this->addObject(obj)) {
         obj->addResources(this);
     }
 }
 
+bool SkPDFObjNumMap::addObject(SkPDFObject* obj) {
+    SkASSERT(obj);
+    if (fObjectNumbers.find(obj)) {
+        return false;
+    }
+    fObjectNumbers.set(obj, fObjectNumbers.count() + 1);
+    fObjects.emplace_back(sk_ref_sp(obj));
+    return true;
+}
+
 int32_t SkPDFObjNumMap::getObjectNumber(SkPDFObject* obj) const {
     int32_t* objectNumberFound = fObjectNumbers.find(obj);
     SkASSERT(objectNumberFound);
@@ -56,6 +56,21 @@ public:
      */
     virtual void addResources(SkPDFObjNumMap* catalog) const {}
 
+    /**
+     *  Subclasses that do expensive, self-contained work in emitObject()
+     *  (image encoding, compression) may do it here instead and keep the
+     *  result for emitObject().  This may be called on another thread, at
+     *  most once, after addResources() and before emitObject().  It must
+     *  not look at any other object or at the SkPDFObjNumMap.
+     */
+    virtual void prepare() {}
+
+    /**
+     *  Returns true if this object may be written inside a PDF 1.5 object
+     *  stream, which is true of anything that is not itself a stream.
+     */
+    virtual bool canBeInObjectStream() const { return false; }
+
     /**
      *  Release all resources associated with this SkPDFObject.  It is
      *  an error to call emitObject() or addResources() after calling
@@ -224,6 +239,7 @@ public:
     void emitObject(SkWStream* stream,
                     const SkPDFObjNumMap& objNumMap) const override;
     void addResources(SkPDFObjNumMap*) const override;
+    bool canBeInObjectStream() const override { return true; }
     void drop() override;
 
     /** The size of the array.
@@ -290,6 +306,7 @@ public:
     void emitObject(SkWStream* stream,
                     const SkPDFObjNumMap& objNumMap) const override;
     void addResources(SkPDFObjNumMap*) const override;
+    bool canBeInObjectStream() const override { return true; }
     void drop() override;
 
     /** The size of the dictionary.
@@ -348,13 +365,22 @@ public:
     SkPDFSharedStream(std::unique_ptr<SkStreamAsset> data);
     ~SkPDFSharedStream() override;
     SkPDFDict* dict() { return &fDict; }
+
+    /** Returns what prepare() compresses the asset to, compressing it now if
+     *  it has not been, so that other streams of the same asset may reuse it
+     *  through setCompressedData().  */
+    sk_sp<SkData> compressedData();
+    void setCompressedData(sk_sp<SkData> compressed) { fCompressedData = std::move(compressed); }
+
     void emitObject(SkWStream*,
                     const SkPDFObjNumMap&) const override;
     void addResources(SkPDFObjNumMap*) const override;
+    void prepare() override;
     void drop() override;
 
 private:
     std::unique_ptr<SkStreamAsset> fAsset;
+    sk_sp<SkData> fCompressedData;  // Set by prepare().
     SkPDFDict fDict;
     typedef SkPDFObject INHERITED;
 };
@@ -377,12 +403,28 @@ public:
     explicit SkPDFStream(std::unique_ptr<SkStreamAsset> stream);
     ~SkPDFStream() override;
 
+    /** Create a PDF stream that compresses its data in prepare() rather
+     *  than immediately.  It must be prepared before it is emitted.  */
+    static sk_sp<SkPDFStream> MakeDeferred(std::unique_ptr<SkStreamAsset> stream);
+
+    /** Create a PDF stream from data already compressed with FlateDecode. */
+    static sk_sp<SkPDFStream> MakeDeflated(std::unique_ptr<SkStreamAsset> deflated);
+
+    /** Create a PDF stream that is written exactly like the one whose
+     *  storedData() returned these. */
+    static sk_sp<SkPDFStream> MakeStored(sk_sp<SkData> stored, bool deflated);
+
+    /** Returns the data as it is written, and sets *deflated if that is
+     *  compressed with FlateDecode.  The stream must not be deferred. */
+    sk_sp<SkData> storedData(bool* deflated) const;
+
     SkPDFDict* dict() { return &fDict; }
 
     // The SkPDFObject interface.
     void emitObject(SkWStream* stream,
                     const SkPDFObjNumMap& objNumMap) const override;
     void addResources(SkPDFObjNumMap*) const final;
+    void prepare() override;
     void drop() override;
 
 protected:
@@ -395,7 +437,9 @@ protected:
 
 private:
     std::unique_ptr<SkStreamAsset> fCompressedData;
+    std::unique_ptr<SkStreamAsset> fDeferredData;  // Compressed by prepare().
     SkPDFDict fDict;
+    bool fDeflated = false;
 
     typedef SkPDFDict INHERITED;
 };
@@ -414,6 +458,12 @@ public:
      */
     void addObjectRecursively(SkPDFObject* obj);
 
+    /** Add the passed object to the catalog, but not its dependencies.
+     *  @param obj   The object to add.
+     *  @return      false if the object was already in the catalog.
+     */
+    bool addObject(SkPDFObject* obj);
+
     /** Get the object number for the passed object.
      *  @param obj         The object of interest.
      */
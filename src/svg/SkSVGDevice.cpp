@@ -113,6 +113,34 @@ static SkString svg_transform(const SkMatrix& t) {
     return tstr;
 }
 
+// Identifies the pixels of a drawn bitmap, so that drawing them again can refer to the
+// <image> already written.
+struct ImageKey {
+    uint32_t fGenerationID;
+    SkIRect  fSubset;
+
+    bool operator==(const ImageKey& that) const {
+        return fGenerationID == that.fGenerationID && fSubset == that.fSubset;
+    }
+};
+
+// Writes the bytes written to it into the value of the attribute an SkXMLWriter is writing.
+class AttributeWStream final : public SkWStream {
+public:
+    explicit AttributeWStream(SkXMLWriter* writer) : fWriter(writer) {}
+
+    bool write(const void* buffer, size_t size) override {
+        fWriter->appendAttributeValue(static_cast<const char*>(buffer), size);
+        fBytesWritten += size;
+        return true;
+    }
+    size_t bytesWritten() const override { return fBytesWritten; }
+
+private:
+    SkXMLWriter* fWriter;
+    size_t       fBytesWritten = 0;
+};
+
 struct Resources {
     Resources(const SkPaint& paint)
         : fPaintServer(svg_color(paint.getColor())) {}
@@ -145,8 +173,8 @@ bool RequiresViewportReset(const SkPaint& paint) {
 
 }  // namespace
 
-// For now all this does is serve unique serial IDs, but it will eventually evolve to track
-// and deduplicate resources.
+// Serves unique serial IDs, and remembers the images already written so they are only
+// written once.
 class SkSVGDevice::ResourceBucket : ::SkNoncopyable {
 public:
     ResourceBucket()
@@ -179,7 +207,15 @@ public:
       return SkStringPrintf("pattern_%d", fPatternCount++);
     }
 
+    const SkString* findImage(const ImageKey& key) const { return fImages.find(key); }
+
+    const SkString* setImage(const ImageKey& key, const SkString& id) {
+        return fImages.set(key, id);
+    }
+
 private:
+    SkTHashMap<ImageKey, SkString> fImages;
+
     uint32_t fGradientCount;
     uint32_t fClipCount;
     uint32_t fPathCount;
@@ -251,6 +287,8 @@ public:
         fWriter->addText(text.c_str(), text.size());
     }
 
+    void addDataUriAttribute(const char name[], const char mimeType[], const SkData& data);
+
     void addRectAttributes(const SkRect&);
     void addPathAttributes(const SkPath&);
     void addTextAttributes(const SkPaint&);
@@ -413,40 +451,41 @@ void SkSVGDevice::AutoElement::addColorFilterResources(const SkColorFilter& cf,
     resources->fColorFilter.printf("url(#%s)", colorfilterID.c_str());
 }
 
-// Returns data uri from bytes.
-// it will use any cached data if available, otherwise will
-// encode as png.
-sk_sp<SkData> AsDataUri(SkImage* image) {
+// Returns the JPEG or PNG data to put in the image's data uri, and sets mimeType to match.
+// It will use any cached data if available, otherwise will encode as png.
+static sk_sp<SkData> encode_for_data_uri(SkImage* image, const char** mimeType) {
     sk_sp<SkData> imageData = image->encodeToData();
     if (!imageData) {
         return nullptr;
     }
 
-    const char* src = (char*)imageData->data();
-    const char* selectedPrefix = nullptr;
-    size_t selectedPrefixLength = 0;
-
-    const static char pngDataPrefix[] = "data:image/png;base64,";
-    const static char jpgDataPrefix[] = "data:image/jpeg;base64,";
-
-    if (SkJpegCodec::IsJpeg(src, imageData->size())) {
-        selectedPrefix = jpgDataPrefix;
-        selectedPrefixLength = sizeof(jpgDataPrefix);
+    if (SkJpegCodec::IsJpeg(imageData->data(), imageData->size())) {
+        *mimeType = "image/jpeg";
     } else {
-      if (!SkPngCodec::IsPng(src, imageData->size())) {
-        imageData = image->encodeToData(SkEncodedImageFormat::kPNG, 100);
-      }
-      selectedPrefix = pngDataPrefix;
-      selectedPrefixLength = sizeof(pngDataPrefix);
+        if (!SkPngCodec::IsPng(static_cast<const char*>(imageData->data()), imageData->size())) {
+            imageData = image->encodeToData(SkEncodedImageFormat::kPNG, 100);
+        }
+        *mimeType = "image/png";
     }
+    return imageData;
+}
+
+// Writes the data uri straight into the attribute, base64-encoding a few kilobytes at a
+// time, rather than building the whole uri first.
+void SkSVGDevice::AutoElement::addDataUriAttribute(const char name[], const char mimeType[],
+                                                   const SkData& data) {
+    static constexpr size_t kChunkSize = 3 * 1024;  // A multiple of 3, so only the last pads.
+    char b64[kChunkSize / 3 * 4];
 
-    size_t b64Size = SkBase64::Encode(imageData->data(), imageData->size(), nullptr);
-    sk_sp<SkData> dataUri = SkData::MakeUninitialized(selectedPrefixLength + b64Size);
-    char* dest = (char*)dataUri->writable_data();
-    memcpy(dest, selectedPrefix, selectedPrefixLength);
-    SkBase64::Encode(imageData->data(), imageData->size(), dest + selectedPrefixLength - 1);
-    dest[dataUri->size() - 1] = 0;
-    return dataUri;
+    fWriter->startAttribute(name);
+    SkString prefix = SkStringPrintf("data:%s;base64,", mimeType);
+    fWriter->appendAttributeValue(prefix.c_str(), prefix.size());
+    for (size_t offset = 0; offset < data.size(); offset += kChunkSize) {
+        size_t length = SkTMin(kChunkSize, data.size() - offset);
+        size_t b64Size = SkBase64::Encode(data.bytes() + offset, length, b64);
+        fWriter->appendAttributeValue(b64, b64Size);
+    }
+    fWriter->endAttribute();
 }
 
 void SkSVGDevice::AutoElement::addImageShaderResources(const SkShader* shader, const SkPaint& paint,
@@ -459,8 +498,9 @@ void SkSVGDevice::AutoElement::addImageShaderResources(const SkShader* shader, c
 
     SkString patternDims[2];  // width, height
 
-    sk_sp<SkData> dataUri = AsDataUri(image);
-    if (!dataUri) {
+    const char* mimeType;
+    sk_sp<SkData> imageData = encode_for_data_uri(image, &mimeType);
+    if (!imageData) {
         return;
     }
     SkIRect imageSize = image->bounds();
@@ -495,7 +535,7 @@ void SkSVGDevice::AutoElement::addImageShaderResources(const SkShader* shader, c
             imageTag.addAttribute("y", 0);
             imageTag.addAttribute("width", image->width());
             imageTag.addAttribute("height", image->height());
-            imageTag.addAttribute("xlink:href", static_cast<const char*>(dataUri->data()));
+            imageTag.addDataUriAttribute("xlink:href", mimeType, *imageData);
         }
     }
     resources->fPaintServer.printf("url(#%s)", patternID.c_str());
@@ -596,9 +636,11 @@ void SkSVGDevice::AutoElement::addRectAttributes(const SkRect& rect) {
 }
 
 void SkSVGDevice::AutoElement::addPathAttributes(const SkPath& path) {
-    SkString pathData;
+    // Paths can be large, so their data is written as it is generated.
+    fWriter->startAttribute("d");
+    AttributeWStream pathData(fWriter);
     SkParsePath::ToSVGString(path, &pathData);
-    this->addAttribute("d", pathData);
+    fWriter->endAttribute();
 }
 
 void SkSVGDevice::AutoElement::addTextAttributes(const SkPaint& paint) {
@@ -795,33 +837,35 @@ static sk_sp<SkData> encode(const SkBitmap& src) {
 }
 
 void SkSVGDevice::drawBitmapCommon(const MxCp& mc, const SkBitmap& bm, const SkPaint& paint) {
-    sk_sp<SkData> pngData = encode(bm);
-    if (!pngData) {
-        return;
-    }
-
-    size_t b64Size = SkBase64::Encode(pngData->data(), pngData->size(), nullptr);
-    SkAutoTMalloc<char> b64Data(b64Size);
-    SkBase64::Encode(pngData->data(), pngData->size(), b64Data.get());
-
-    SkString svgImageData("data:image/png;base64,");
-    svgImageData.append(b64Data.get(), b64Size);
+    // The same pixels drawn again are another <use> of the <image> written the first time.
+    const SkIPoint origin = bm.pixelRefOrigin();
+    const ImageKey key = { bm.getGenerationID(),
+                           SkIRect::MakeXYWH(origin.x(), origin.y(), bm.width(), bm.height()) };
+    const SkString* imageID = bm.pixelRef() ? fResourceBucket->findImage(key) : nullptr;
+
+    if (!imageID) {
+        sk_sp<SkData> pngData = encode(bm);
+        if (!pngData) {
+            return;
+        }
 
-    SkString imageID = fResourceBucket->addImage();
-    {
-        AutoElement defs("defs", fWriter);
+        SkString newImageID = fResourceBucket->addImage();
         {
-            AutoElement image("image", fWriter);
-            image.addAttribute("id", imageID);
-            image.addAttribute("width", bm.width());
-            image.addAttribute("height", bm.height());
-            image.addAttribute("xlink:href", svgImageData);
+            AutoElement defs("defs", fWriter);
+            {
+                AutoElement image("image", fWriter);
+                image.addAttribute("id", newImageID);
+                image.addAttribute("width", bm.width());
+                image.addAttribute("height", bm.height());
+                image.addDataUriAttribute("xlink:href", "image/png", *pngData);
+            }
         }
+        imageID = fResourceBucket->setImage(key, newImageID);
     }
 
     {
         AutoElement imageUse("use", fWriter, fResourceBucket.get(), mc, paint);
-        imageUse.addAttribute("xlink:href", SkStringPrintf("#%s", imageID.c_str()));
+        imageUse.addAttribute("xlink:href", SkStringPrintf("#%s", imageID->c_str()));
     }
 }
 
@@ -9,11 +9,29 @@
 #include "SkCodec.h"
 #include "SkData.h"
 #include "SkImage.h"
+#include "SkMakeUnique.h"
+#include "SkTaskGroup.h"
 #include <algorithm>
 
-SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(std::move(codec)) {
+// The most frames decoded ahead of the current one after a seek.
+static constexpr int kMaxDecodeAhead = 3;
+
+SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec, size_t frameCacheBudget,
+                                     SkExecutor* executor)
+        : fCodec(std::move(codec))
+        , fFrameCacheBudget(frameCacheBudget) {
     fImageInfo = fCodec->getInfo();
     fFrameInfos = fCodec->getFrameInfo();
+    if (fFrameInfos.empty()) {
+        // A still image is a single frame that lasts forever.
+        SkCodec::FrameInfo info;
+        info.fRequiredFrame = SkCodec::kNoFrame;
+        info.fDuration = 0;
+        info.fFullyReceived = true;
+        info.fAlphaType = fImageInfo.alphaType();
+        info.fDisposalMethod = SkCodecAnimation::DisposalMethod::kKeep;
+        fFrameInfos.push_back(info);
+    }
     fImages.resize(fFrameInfos.size());
 
     // change the interpretation of fDuration to a end-time for that frame
@@ -23,19 +41,91 @@ SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(st
         f.fDuration = dur;
     }
     fTotalDuration = dur;
+
+    if (executor && fFrameInfos.size() > 1) {
+        fDecodeAhead = skstd::make_unique<SkTaskGroup>(*executor);
+    }
 }
 
-SkAnimCodecPlayer::~SkAnimCodecPlayer() {}
+SkAnimCodecPlayer::~SkAnimCodecPlayer() {
+    // Stop decoding ahead, and wait for the frame being decoded, if any.
+    fSeekID++;
+    fDecodeAhead.reset();
+}
 
 SkISize SkAnimCodecPlayer::dimensions() {
     return { fImageInfo.width(), fImageInfo.height() };
 }
 
+int SkAnimCodecPlayer::stepsUntil(int index) const {
+    const int count = (int)fFrameInfos.size();
+    int steps = (index - fCurrIndex.load()) * fDirection.load() % count;
+    return steps < 0 ? steps + count : steps;
+}
+
+void SkAnimCodecPlayer::cacheFrame(int index, sk_sp<SkImage> image) {
+    fImages[index] = std::move(image);
+    fCachedBytes += fImageInfo.computeMinByteSize();
+
+    // Playback is cyclic, so the frame reached last from the current one, going in the current
+    // direction, is the one needed again last. It is the best one to drop, unless an uncached
+    // frame reached before it uses it as its prior frame: dropping that one means decoding it
+    // again, and the frames it depends on, to decode the other. So such frames go last.
+    const int current = fCurrIndex;
+    const int count = (int)fImages.size();
+    std::vector<bool> isPrior(count);
+    while (fCachedBytes > fFrameCacheBudget) {
+        std::fill(isPrior.begin(), isPrior.end(), false);
+        for (int i = 0; i < count; ++i) {
+            const int prior = fFrameInfos[i].fRequiredFrame;
+            if (prior != SkCodec::kNoFrame && !fImages[i] &&
+                this->stepsUntil(i) < this->stepsUntil(prior)) {
+                isPrior[prior] = true;
+            }
+        }
+
+        int victim = -1;
+        for (int i = 0; i < count; ++i) {
+            if (!fImages[i] || i == current) {
+                continue;
+            }
+            if (victim < 0 || isPrior[victim] > isPrior[i] ||
+                (isPrior[victim] == isPrior[i] && this->stepsUntil(i) > this->stepsUntil(victim))) {
+                victim = i;
+            }
+        }
+        if (victim < 0) {
+            break;
+        }
+        fImages[victim] = nullptr;
+        fCachedBytes -= fImageInfo.computeMinByteSize();
+    }
+}
+
 sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
     SkASSERT((unsigned)index < fFrameInfos.size());
 
-    if (fImages[index]) {
-        return fImages[index];
+    const int requiredFrame = fFrameInfos[index].fRequiredFrame;
+    sk_sp<SkImage> requiredImage;
+    {
+        SkAutoMutexAcquire lock(fMutex);
+        if (fImages[index]) {
+            return fImages[index];
+        }
+        if (requiredFrame != SkCodec::kNoFrame) {
+            requiredImage = fImages[requiredFrame];
+        }
+    }
+
+    // Decode into our own buffer, holding only fCodecMutex, so that getFrame() can still
+    // return cached frames while this decodes.
+    SkAutoMutexAcquire codecLock(fCodecMutex);
+    {
+        // Someone else may have decoded it while we waited for the codec.
+        SkAutoMutexAcquire lock(fMutex);
+        if (fImages[index]) {
+            return fImages[index];
+        }
     }
 
     size_t rb = fImageInfo.minRowBytes();
@@ -45,19 +135,24 @@ sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
     SkCodec::Options opts;
     opts.fFrameIndex = index;
 
-    const int requiredFrame = fFrameInfos[index].fRequiredFrame;
-    if (requiredFrame != SkCodec::kNoFrame) {
-        auto requiredImage = fImages[requiredFrame];
-        SkPixmap requiredPM;
-        if (requiredImage && requiredImage->peekPixels(&requiredPM)) {
-            sk_careful_memcpy(data->writable_data(), requiredPM.addr(), size);
-            opts.fPriorFrame = requiredFrame;
-        }
+    SkPixmap requiredPM;
+    if (requiredImage && requiredImage->peekPixels(&requiredPM)) {
+        sk_careful_memcpy(data->writable_data(), requiredPM.addr(), size);
+        opts.fPriorFrame = requiredFrame;
     }
-    if (SkCodec::kSuccess == fCodec->getPixels(fImageInfo, data->writable_data(), rb, &opts)) {
-        return fImages[index] = SkImage::MakeRasterData(fImageInfo, std::move(data), rb);
+    if (SkCodec::kSuccess != fCodec->getPixels(fImageInfo, data->writable_data(), rb, &opts)) {
+        return nullptr;
     }
-    return nullptr;
+
+    auto image = SkImage::MakeRasterData(fImageInfo, std::move(data), rb);
+    SkAutoMutexAcquire lock(fMutex);
+    this->cacheFrame(index, image);
+    return image;
+}
+
+bool SkAnimCodecPlayer::isCached(int index) {
+    SkAutoMutexAcquire lock(fMutex);
+    return fImages[index] != nullptr;
 }
 
 sk_sp<SkImage> SkAnimCodecPlayer::getFrame() {
@@ -65,15 +160,55 @@ sk_sp<SkImage> SkAnimCodecPlayer::getFrame() {
 }
 
 bool SkAnimCodecPlayer::seek(uint32_t msec) {
-    msec %= fTotalDuration;
+    msec = fTotalDuration ? msec % fTotalDuration : 0;
 
     auto lower = std::lower_bound(fFrameInfos.begin(), fFrameInfos.end(), msec,
                                   [](const SkCodec::FrameInfo& info, uint32_t msec) {
                                       return (uint32_t)info.fDuration < msec;
                                   });
     int prevIndex = fCurrIndex;
-    fCurrIndex = lower - fFrameInfos.begin();
-    return fCurrIndex != prevIndex;
+    int index = lower - fFrameInfos.begin();
+    if (index == prevIndex) {
+        return false;
+    }
+
+    // Going a short way forward around the loop counts as playing forward; a short way back,
+    // as playing backward.
+    const int count = (int)fFrameInfos.size();
+    int steps = (index - prevIndex + count) % count;
+    fDirection = steps <= count / 2 ? 1 : -1;
+    fCurrIndex = index;
+    fSeekID++;
+
+    if (fDecodeAhead) {
+        this->decodeAhead();
+    }
+    return true;
 }
 
+void SkAnimCodecPlayer::decodeAhead() {
+    const int count = (int)fFrameInfos.size();
+    const size_t frameBytes = std::max<size_t>(fImageInfo.computeMinByteSize(), 1);
+    // Leave room in the budget for the current frame.
+    const size_t budgetFrames = fFrameCacheBudget / frameBytes;
+    const int ahead = (int)std::min<size_t>({ (size_t)kMaxDecodeAhead,
+                                              budgetFrames > 0 ? budgetFrames - 1 : 0,
+                                              (size_t)count - 1 });
+    if (ahead == 0) {
+        return;
+    }
 
+    const uint32_t seekID = fSeekID;
+    const int start = fCurrIndex, direction = fDirection;
+    fDecodeAhead->add([this, seekID, start, direction, ahead, count]() {
+        for (int i = 1; i <= ahead; ++i) {
+            if (fSeekID != seekID) {
+                return;  // A newer seek decides what to decode now.
+            }
+            int index = ((start + i * direction) % count + count) % count;
+            if (!this->getFrameAt(index) || !this->isCached(index)) {
+                return;  // Failed, or the cache has no room for it.
+            }
+        }
+    });
+}
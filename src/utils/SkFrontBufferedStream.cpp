@@ -26,12 +26,18 @@ public:
 
     size_t getLength() const override { return fLength; }
 
+    const void* getMemoryBase() override;
+
 private:
     SkStreamRewindable* onDuplicate() const override { return nullptr; }
 
     std::unique_ptr<SkStream> fStream;
     const bool                fHasLength;
     const size_t              fLength;
+    // If the wrapped stream is in memory, and has a length and position,
+    // reads go straight to it, and rewind() moves it back instead of
+    // replaying a copy of its first bytes. fBuffer is then never allocated.
+    const bool                fReadDirectly;
     // Current offset into the stream. Always >= 0.
     size_t                    fOffset;
     // Amount that has been buffered by calls to read. Will always be less than
@@ -74,12 +80,25 @@ FrontBufferedStream::FrontBufferedStream(std::unique_ptr<SkStream> stream, size_
     : fStream(std::move(stream))
     , fHasLength(fStream->hasPosition() && fStream->hasLength())
     , fLength(fStream->getLength() - fStream->getPosition())
+    , fReadDirectly(fHasLength && fStream->getMemoryBase())
     , fOffset(0)
     , fBufferedSoFar(0)
     , fBufferSize(bufferSize)
-    , fBuffer(bufferSize) {}
+    , fBuffer(fReadDirectly ? 0 : bufferSize) {}
+
+const void* FrontBufferedStream::getMemoryBase() {
+    if (!fReadDirectly) {
+        return nullptr;
+    }
+    // The wrapped stream's position when it was handed to us is our start.
+    return SkTAddOffset<const void>(fStream->getMemoryBase(), fStream->getLength() - fLength);
+}
 
 bool FrontBufferedStream::isAtEnd() const {
+    if (fReadDirectly) {
+        return fOffset >= fLength;
+    }
+
     if (fOffset < fBufferedSoFar) {
         // Even if the underlying stream is at the end, this stream has been
         // rewound after buffering, so it is not at the end.
@@ -92,6 +111,9 @@ bool FrontBufferedStream::isAtEnd() const {
 bool FrontBufferedStream::rewind() {
     // Only allow a rewind if we have not exceeded the buffer.
     if (fOffset <= fBufferSize) {
+        if (fReadDirectly && !fStream->seek(fStream->getLength() - fLength)) {
+            return false;
+        }
         fOffset = 0;
         return true;
     }
@@ -165,6 +187,9 @@ size_t FrontBufferedStream::peek(void* dst, size_t size) const {
     }
 
     size = SkTMin(size, fBufferSize - start);
+    if (fReadDirectly) {
+        return fStream->peek(dst, size);
+    }
     FrontBufferedStream* nonConstThis = const_cast<FrontBufferedStream*>(this);
     const size_t bytesRead = nonConstThis->read(dst, size);
     nonConstThis->fOffset = start;
@@ -177,6 +202,11 @@ size_t FrontBufferedStream::read(void* voidDst, size_t size) {
     SkDEBUGCODE(const size_t totalSize = size;)
     const size_t start = fOffset;
 
+    if (fReadDirectly) {
+        fOffset += fStream->read(dst, size);
+        return fOffset - start;
+    }
+
     // First, read any data that was previously buffered.
     if (fOffset < fBufferedSoFar) {
         const size_t bytesCopied = this->readFromBuffer(dst, size);
@@ -231,7 +231,12 @@ static void append_scalars(SkWStream* stream, char verb, const SkScalar data[],
 
 void SkParsePath::ToSVGString(const SkPath& path, SkString* str) {
     SkDynamicMemoryWStream  stream;
+    ToSVGString(path, &stream);
+    str->resize(stream.bytesWritten());
+    stream.copyTo(str->writable_str());
+}
 
+void SkParsePath::ToSVGString(const SkPath& path, SkWStream* stream) {
     SkPath::Iter    iter(path, false);
     SkPoint         pts[4];
 
@@ -242,28 +247,26 @@ void SkParsePath::ToSVGString(const SkPath& path, SkString* str) {
                 SkAutoConicToQuads quadder;
                 const SkPoint* quadPts = quadder.computeQuads(pts, iter.conicWeight(), tol);
                 for (int i = 0; i < quadder.countQuads(); ++i) {
-                    append_scalars(&stream, 'Q', &quadPts[i*2 + 1].fX, 4);
+                    append_scalars(stream, 'Q', &quadPts[i*2 + 1].fX, 4);
                 }
             } break;
            case SkPath::kMove_Verb:
-                append_scalars(&stream, 'M', &pts[0].fX, 2);
+                append_scalars(stream, 'M', &pts[0].fX, 2);
                 break;
             case SkPath::kLine_Verb:
-                append_scalars(&stream, 'L', &pts[1].fX, 2);
+                append_scalars(stream, 'L', &pts[1].fX, 2);
                 break;
             case SkPath::kQuad_Verb:
-                append_scalars(&stream, 'Q', &pts[1].fX, 4);
+                append_scalars(stream, 'Q', &pts[1].fX, 4);
                 break;
             case SkPath::kCubic_Verb:
-                append_scalars(&stream, 'C', &pts[1].fX, 6);
+                append_scalars(stream, 'C', &pts[1].fX, 6);
                 break;
             case SkPath::kClose_Verb:
-                stream.write("Z", 1);
+                stream->write("Z", 1);
                 break;
             case SkPath::kDone_Verb:
-                str->resize(stream.bytesWritten());
-                stream.copyTo(str->writable_str());
-            return;
+                return;
         }
     }
 }
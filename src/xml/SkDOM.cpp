@@ -175,16 +175,23 @@ const char* SkDOM::AttrIter::next(const char** value) {
 //////////////////////////////////////////////////////////////////////////////
 
 #include "SkXMLParser.h"
+#include "SkOpts.h"
 #include "SkTDArray.h"
+#include "SkTHash.h"
 
-static char* dupstr(SkArenaAlloc* chunk, const char src[]) {
+static char* dupstr(SkArenaAlloc* chunk, const char src[], size_t len) {
     SkASSERT(chunk && src);
-    size_t  len = strlen(src);
     char*   dst = chunk->makeArrayDefault<char>(len + 1);
-    memcpy(dst, src, len + 1);
+    memcpy(dst, src, len);
+    dst[len] = '\0';
     return dst;
 }
 
+static char* dupstr(SkArenaAlloc* chunk, const char src[]) {
+    SkASSERT(src);
+    return dupstr(chunk, src, strlen(src));
+}
+
 class SkDOMParser : public SkXMLParser {
 public:
     SkDOMParser(SkArenaAlloc* chunk) : SkXMLParser(&fParserError), fAlloc(chunk) {
@@ -228,13 +235,13 @@ protected:
     }
 
     bool onStartElement(const char elem[]) override {
-        this->startCommon(elem, SkDOM::kElement_Type);
+        this->startCommon(this->intern(elem), SkDOM::kElement_Type);
         return false;
     }
 
     bool onAddAttribute(const char name[], const char value[]) override {
         SkDOM::Attr* attr = fAttrs.append();
-        attr->fName = dupstr(fAlloc, name);
+        attr->fName = this->intern(name);
         attr->fValue = dupstr(fAlloc, value);
         return false;
     }
@@ -262,24 +269,51 @@ protected:
     }
 
     bool onText(const char text[], int len) override {
-        SkString str(text, len);
-        this->startCommon(str.c_str(), SkDOM::kText_Type);
-        this->SkDOMParser::onEndElement(str.c_str());
+        char* str = dupstr(fAlloc, text, SkToSizeT(len));
+        this->startCommon(str, SkDOM::kText_Type);
+        this->SkDOMParser::onEndElement(str);
 
         return false;
     }
 
 private:
-    void startCommon(const char elem[], SkDOM::Type type) {
+    // elem must already be in the arena.
+    void startCommon(char* elem, SkDOM::Type type) {
         if (fLevel > 0 && fNeedToFlush) {
             this->flushAttributes();
         }
         fNeedToFlush = true;
-        fElemName = dupstr(fAlloc, elem);
+        fElemName = elem;
         fElemType = type;
         ++fLevel;
     }
 
+    // Element and attribute names repeat throughout a document, so each is copied into the
+    // arena only once, and every node using it shares that copy.
+    struct Name {
+        const char* fStr;
+        size_t      fLen;
+
+        bool operator==(const Name& that) const {
+            return fLen == that.fLen && !memcmp(fStr, that.fStr, fLen);
+        }
+
+        static const Name& GetKey(const Name& name) { return name; }
+        static uint32_t Hash(const Name& name) { return SkOpts::hash(name.fStr, name.fLen); }
+    };
+
+    char* intern(const char name[]) {
+        Name key = { name, strlen(name) };
+        if (const Name* found = fNames.find(key)) {
+            return const_cast<char*>(found->fStr);
+        }
+        char* str = dupstr(fAlloc, name, key.fLen);
+        fNames.set({ str, key.fLen });
+        return str;
+    }
+
+    SkTHashTable<Name, Name, Name> fNames;
+
     SkTDArray<SkDOM::Node*> fParentStack;
     SkArenaAlloc*           fAlloc;
     SkDOM::Node*            fRoot;
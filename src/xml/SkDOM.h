@@ -29,7 +29,9 @@ public:
     typedef SkDOMNode Node;
     typedef SkDOMAttr Attr;
 
-    /** Returns null on failure
+    /** Returns null on failure. A stream with a memory base, such as the one
+        SkStream::MakeFromFile returns for a file it can map, is parsed in place
+        rather than copied in pieces.
     */
     const Node* build(SkStream&);
     const Node* copy(const SkDOM& dom, const Node* node);
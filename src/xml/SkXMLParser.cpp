@@ -127,6 +127,19 @@ void XMLCALL entity_decl_handler(void *data,
     XML_StopParser(ctx->fXMLParser, XML_FALSE);
 }
 
+// Returns false, after logging the error, if status is an error.
+bool report_status(XML_Parser parser, XML_Status status) {
+    if (XML_STATUS_ERROR == status) {
+        XML_Error error = XML_GetErrorCode(parser);
+        int line = XML_GetCurrentLineNumber(parser);
+        int column = XML_GetCurrentColumnNumber(parser);
+        const XML_LChar* errorString = XML_ErrorString(error);
+        SkDebugf("parse error @%d:%d: %d (%s).\n", line, column, error, errorString);
+        return false;
+    }
+    return true;
+}
+
 } // anonymous namespace
 
 SkXMLParser::SkXMLParser(SkXMLParserError* parserError) : fParser(nullptr), fError(parserError)
@@ -152,6 +165,21 @@ bool SkXMLParser::parse(SkStream& docStream)
     // Disable entity processing, to inhibit internal entity expansion. See expat CVE-2013-0340.
     XML_SetEntityDeclHandler(ctx.fXMLParser, entity_decl_handler);
 
+    // A stream already in memory (for example a mapped file) is parsed where it is, in one
+    // piece, rather than being copied into expat's buffer a little at a time.
+    if (const char* base = static_cast<const char*>(docStream.getMemoryBase())) {
+        if (docStream.hasPosition() && docStream.hasLength()) {
+            const size_t position = docStream.getPosition();
+            const size_t length = docStream.getLength();
+            if (position <= length && length - position <= SK_MaxS32) {
+                XML_Status status = XML_Parse(ctx.fXMLParser, base + position,
+                                              SkToS32(length - position), true);
+                docStream.seek(length);
+                return report_status(ctx.fXMLParser, status);
+            }
+        }
+    }
+
     static const int kBufferSize = 512 SkDEBUGCODE( - 507);
     bool done = false;
     do {
@@ -164,12 +192,7 @@ bool SkXMLParser::parse(SkStream& docStream)
         size_t len = docStream.read(buffer, kBufferSize);
         done = docStream.isAtEnd();
         XML_Status status = XML_ParseBuffer(ctx.fXMLParser, SkToS32(len), done);
-        if (XML_STATUS_ERROR == status) {
-            XML_Error error = XML_GetErrorCode(ctx.fXMLParser);
-            int line = XML_GetCurrentLineNumber(ctx.fXMLParser);
-            int column = XML_GetCurrentColumnNumber(ctx.fXMLParser);
-            const XML_LChar* errorString = XML_ErrorString(error);
-            SkDebugf("parse error @%d:%d: %d (%s).\n", line, column, error, errorString);
+        if (!report_status(ctx.fXMLParser, status)) {
             return false;
         }
     } while (!done);
@@ -128,21 +128,58 @@ static size_t escape_markup(char dst[], const char src[], size_t length) {
     return extra;
 }
 
+// Points *value at an escaped copy in storage if it needs escaping.
+static void escape_value(const char** value, size_t* length, SkString* storage) {
+    size_t extra = escape_markup(nullptr, *value, *length);
+    if (extra) {
+        storage->resize(*length + extra);
+        (void)escape_markup(storage->writable_str(), *value, *length);
+        *value = storage->c_str();
+        *length += extra;
+    }
+}
+
 void SkXMLWriter::addAttributeLen(const char name[], const char value[], size_t length) {
     SkString valueStr;
 
     if (fDoEscapeMarkup) {
-        size_t   extra = escape_markup(nullptr, value, length);
-        if (extra) {
-            valueStr.resize(length + extra);
-            (void)escape_markup(valueStr.writable_str(), value, length);
-            value = valueStr.c_str();
-            length += extra;
-        }
+        escape_value(&value, &length, &valueStr);
     }
     this->onAddAttributeLen(name, value, length);
 }
 
+void SkXMLWriter::startAttribute(const char name[]) {
+    this->onStartAttribute(name);
+}
+
+void SkXMLWriter::appendAttributeValue(const char value[], size_t length) {
+    SkString valueStr;
+
+    if (fDoEscapeMarkup) {
+        escape_value(&value, &length, &valueStr);
+    }
+    this->onAppendAttributeValue(value, length);
+}
+
+void SkXMLWriter::endAttribute() {
+    this->onEndAttribute();
+}
+
+void SkXMLWriter::onStartAttribute(const char name[]) {
+    fAttributeName.set(name);
+    fAttributeValue.reset();
+}
+
+void SkXMLWriter::onAppendAttributeValue(const char value[], size_t length) {
+    fAttributeValue.append(value, length);
+}
+
+void SkXMLWriter::onEndAttribute() {
+    this->onAddAttributeLen(fAttributeName.c_str(), fAttributeValue.c_str(),
+                            fAttributeValue.size());
+    fAttributeValue.reset();
+}
+
 void SkXMLWriter::startElementLen(const char elem[], size_t length) {
     this->onStartElementLen(elem, length);
 }
@@ -212,6 +249,21 @@ void SkXMLStreamWriter::onAddAttributeLen(const char name[], const char value[],
     fStream.writeText("\"");
 }
 
+void SkXMLStreamWriter::onStartAttribute(const char name[]) {
+    SkASSERT(!fElems.top()->fHasChildren && !fElems.top()->fHasText);
+    fStream.writeText(" ");
+    fStream.writeText(name);
+    fStream.writeText("=\"");
+}
+
+void SkXMLStreamWriter::onAppendAttributeValue(const char value[], size_t length) {
+    fStream.write(value, length);
+}
+
+void SkXMLStreamWriter::onEndAttribute() {
+    fStream.writeText("\"");
+}
+
 void SkXMLStreamWriter::onAddText(const char text[], size_t length) {
     Elem* elem = fElems.top();
 
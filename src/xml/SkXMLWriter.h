@@ -26,6 +26,12 @@ public:
     void    addHexAttribute(const char name[], uint32_t value, int minDigits = 0);
     void    addScalarAttribute(const char name[], SkScalar value);
     void    addText(const char text[], size_t length);
+    /** Adds an attribute whose value is written in pieces, for values too large
+        to build up front: call appendAttributeValue() any number of times, then
+        endAttribute().  No other call may come in between. */
+    void    startAttribute(const char name[]);
+    void    appendAttributeValue(const char value[], size_t length);
+    void    endAttribute();
     void    endElement() { this->onEndElement(); }
     void    startElement(const char elem[]);
     void    startElementLen(const char elem[], size_t length);
@@ -38,6 +44,11 @@ protected:
     virtual void onAddAttributeLen(const char name[], const char value[], size_t length) = 0;
     virtual void onAddText(const char text[], size_t length) = 0;
     virtual void onEndElement() = 0;
+    // By default the pieces of an attribute value are gathered and passed to
+    // onAddAttributeLen().
+    virtual void onStartAttribute(const char name[]);
+    virtual void onAppendAttributeValue(const char value[], size_t length);
+    virtual void onEndAttribute();
 
     struct Elem {
         Elem(const char name[], size_t len)
@@ -57,6 +68,8 @@ protected:
 
 private:
     bool fDoEscapeMarkup;
+    SkString fAttributeName;
+    SkString fAttributeValue;
     // illegal
     SkXMLWriter& operator=(const SkXMLWriter&);
 };
@@ -72,6 +85,9 @@ protected:
     void onEndElement() override;
     void onAddAttributeLen(const char name[], const char value[], size_t length) override;
     void onAddText(const char text[], size_t length) override;
+    void onStartAttribute(const char name[]) override;
+    void onAppendAttributeValue(const char value[], size_t length) override;
+    void onEndAttribute() override;
 
 private:
     SkWStream&      fStream;
@@ -268,3 +268,145 @@ DEF_TEST(AndroidCodec_orientation, r) {
         }
     }
 }
+
+static std::unique_ptr<SkAndroidCodec> make_android_codec(skiatest::Reporter* r,
+                                                          const char* path) {
+    auto codec = SkAndroidCodec::MakeFromCodec(SkCodec::MakeFromData(GetResourceAsData(path)));
+    if (!codec) {
+        ERRORF(r, "Failed to create codec from %s", path);
+    }
+    return codec;
+}
+
+// Decodes (the subset of) the image whole, at sampleSize, and averages blocks of factor
+// by factor pixels into a bitmap the size of dst, to compare with a box filtered decode.
+static void check_box_filtered(skiatest::Reporter* r, SkAndroidCodec* codec, const SkBitmap& dst,
+                               SkIRect* subset, int sampleSize, int factor) {
+    SkAndroidCodec::AndroidOptions options;
+    options.fSampleSize = sampleSize;
+    options.fSubset = subset;
+    const SkISize size = codec->getSampledSubsetDimensions(sampleSize,
+            subset ? *subset : SkIRect::MakeSize(codec->getInfo().dimensions()));
+    SkBitmap full;
+    full.allocPixels(dst.info().makeWH(size.width(), size.height()));
+    REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getAndroidPixels(full.info(),
+            full.getPixels(), full.rowBytes(), &options));
+
+    for (int y = 0; y < dst.height(); y++) {
+        for (int x = 0; x < dst.width(); x++) {
+            for (int c = 0; c < 4; c++) {
+                int sum = 0;
+                for (int j = 0; j < factor; j++) {
+                    for (int i = 0; i < factor; i++) {
+                        sum += ((const uint8_t*) full.getAddr(x * factor + i,
+                                                              y * factor + j))[c];
+                    }
+                }
+                const int expected = (sum + factor * factor / 2) / (factor * factor);
+                const int actual = ((const uint8_t*) dst.getAddr(x, y))[c];
+                // Rows are filtered horizontally, and rounded, before they are filtered
+                // vertically.
+                if (SkTAbs(expected - actual) > 1) {
+                    ERRORF(r, "Pixel (%d, %d) channel %d: expected %d, got %d",
+                           x, y, c, expected, actual);
+                    return;
+                }
+            }
+        }
+    }
+}
+
+DEF_TEST(AndroidCodec_filtered, r) {
+    if (GetResourcePath().isEmpty()) {
+        return;
+    }
+
+    auto filtered = [r](SkAndroidCodec* codec, int width, int height, SkFilterQuality quality,
+                        SkIRect* subset, SkBitmap* dst) {
+        dst->allocPixels(SkImageInfo::MakeN32Premul(width, height));
+        SkAndroidCodec::AndroidOptions options;
+        options.fFilterQuality = quality;
+        options.fSubset = subset;
+        return codec->getAndroidPixels(dst->info(), dst->getPixels(), dst->rowBytes(), &options);
+    };
+
+    // PNG has no scanline decoder, so the whole image is decoded, then filtered.
+    {
+        auto codec = make_android_codec(r, "images/mandrill_128.png");
+        if (!codec) {
+            return;
+        }
+        SkBitmap dst;
+        REPORTER_ASSERT(r, SkCodec::kSuccess == filtered(codec.get(), 32, 32,
+                                                         kMedium_SkFilterQuality, nullptr, &dst));
+        check_box_filtered(r, codec.get(), dst, nullptr, 1, 4);
+
+        SkIRect subset = SkIRect::MakeXYWH(16, 32, 64, 48);
+        REPORTER_ASSERT(r, SkCodec::kSuccess == filtered(codec.get(), 32, 24,
+                                                         kLow_SkFilterQuality, &subset, &dst));
+        check_box_filtered(r, codec.get(), dst, &subset, 1, 2);
+
+        // Only 8888 can be filtered.
+        SkBitmap bm;
+        bm.allocPixels(SkImageInfo::Make(32, 32, kRGB_565_SkColorType, kOpaque_SkAlphaType));
+        SkAndroidCodec::AndroidOptions options;
+        options.fFilterQuality = kMedium_SkFilterQuality;
+        REPORTER_ASSERT(r, SkCodec::kInvalidConversion == codec->getAndroidPixels(bm.info(),
+                bm.getPixels(), bm.rowBytes(), &options));
+    }
+
+    // JPEG rows are streamed out of a scanline decoder that scales down natively first.
+    {
+        auto codec = make_android_codec(r, "images/mandrill_512_q075.jpg");
+        if (!codec) {
+            return;
+        }
+        SkBitmap dst;
+        REPORTER_ASSERT(r, SkCodec::kSuccess == filtered(codec.get(), 64, 64,
+                                                         kMedium_SkFilterQuality, nullptr, &dst));
+        check_box_filtered(r, codec.get(), dst, nullptr, 8, 1);
+
+        SkIRect subset = SkIRect::MakeXYWH(128, 64, 256, 256);
+        REPORTER_ASSERT(r, SkCodec::kSuccess == filtered(codec.get(), 16, 16,
+                                                         kMedium_SkFilterQuality, &subset, &dst));
+        check_box_filtered(r, codec.get(), dst, &subset, 8, 2);
+
+        // A sharper filter, to a size that is not a whole fraction of the image, still comes
+        // out close to the box filter.
+        SkBitmap box;
+        REPORTER_ASSERT(r, SkCodec::kSuccess == filtered(codec.get(), 100, 77,
+                                                         kMedium_SkFilterQuality, nullptr, &box));
+        REPORTER_ASSERT(r, SkCodec::kSuccess == filtered(codec.get(), 100, 77,
+                                                         kHigh_SkFilterQuality, nullptr, &dst));
+        int64_t totalDiff = 0;
+        for (int y = 0; y < dst.height(); y++) {
+            for (int x = 0; x < dst.width(); x++) {
+                for (int c = 0; c < 4; c++) {
+                    totalDiff += SkTAbs(((const uint8_t*) dst.getAddr(x, y))[c] -
+                                        ((const uint8_t*) box.getAddr(x, y))[c]);
+                }
+                REPORTER_ASSERT(r, SkColorGetA(dst.getColor(x, y)) == 0xFF);
+            }
+        }
+        REPORTER_ASSERT(r, totalDiff < 100 * 77 * 3 * 16);
+    }
+
+    // Truncated input is reported, and the rows that are missing are filled.
+    {
+        sk_sp<SkData> data = GetResourceAsData("images/mandrill_512_q075.jpg");
+        if (!data) {
+            ERRORF(r, "Missing mandrill_512_q075.jpg");
+            return;
+        }
+        auto codec = SkAndroidCodec::MakeFromData(SkData::MakeSubset(data.get(), 0,
+                                                                     data->size() / 2));
+        if (!codec) {
+            ERRORF(r, "Failed to create codec from truncated mandrill_512_q075.jpg");
+            return;
+        }
+        SkBitmap dst;
+        REPORTER_ASSERT(r, SkCodec::kIncompleteInput == filtered(codec.get(), 100, 100,
+                                                                 kHigh_SkFilterQuality, nullptr,
+                                                                 &dst));
+    }
+}
@@ -16,11 +16,13 @@
 #include "SkColorPriv.h"
 #include "SkDrawLooper.h"
 #include "SkEmbossMaskFilter.h"
+#include "SkExecutor.h"
 #include "SkFloatBits.h"
 #include "SkImageInfo.h"
 #include "SkLayerDrawLooper.h"
 #include "SkMask.h"
 #include "SkMaskFilter.h"
+#include "SkMaskBlurFilter.h"
 #include "SkMaskFilterBase.h"
 #include "SkMath.h"
 #include "SkMathPriv.h"
@@ -30,6 +32,7 @@
 #include "SkPixmap.h"
 #include "SkPoint.h"
 #include "SkRRect.h"
+#include "SkRandom.h"
 #include "SkRectPriv.h"
 #include "SkRefCnt.h"
 #include "SkScalar.h"
@@ -45,6 +48,7 @@
 #include <math.h>
 #include <string.h>
 #include <utility>
+#include <vector>
 
 #define WRITE_CSV 0
 
@@ -742,3 +746,143 @@ DEF_TEST(zero_blur, reporter) {
     bitmap.extractAlpha(&alpha, &paint, nullptr, &offset);
 }
 
+namespace {
+// A plain scalar copy of the three pass box blur in SkMaskBlurFilter's PlanGauss::Scan, to check
+// the SIMD kernel against.
+class ReferenceGauss {
+public:
+    static constexpr double kPi = 3.14159265358979323846264338327950288;
+
+    explicit ReferenceGauss(double sigma) {
+        int window = std::max(1, (int)floor(sigma * 3 * sqrt(2 * kPi) / 4 + 0.5));
+        fPassSize[0] = window - 1;
+        fPassSize[1] = window - 1;
+        fPassSize[2] = (window & 1) == 1 ? window - 1 : window;
+        fBorder = (window & 1) == 1 ? 3 * ((window - 1) / 2) : 3 * (window / 2) - 1;
+        uint64_t divisor = (window & 1) == 1 ? (uint64_t)window * window * window
+                                             : (uint64_t)window * window * (window + 1);
+        fWeight = (uint64_t)round(1.0 / divisor * (1ull << 32));
+    }
+
+    int border() const { return fBorder; }
+
+    // Blurs n values read every srcStride bytes into n + 2 * border() values written every
+    // dstStride bytes: forwards until the window has passed the end of src, then backwards from
+    // the end of dst.
+    void blur(const uint8_t* src, int srcStride, int n, uint8_t* dst, int dstStride) const {
+        const int dstN = n + 2 * fBorder;
+        const int slidingWindow = 2 * fBorder + 1;
+        const int forward = std::min(dstN, n + std::max(0, slidingWindow - n));
+
+        this->reset();
+        for (int i = 0; i < forward; i++) {
+            dst[i * dstStride] = this->step(i < n ? src[i * srcStride] : 0);
+        }
+        this->reset();
+        for (int i = dstN - 1, j = n - 1; i >= forward; i--, j--) {
+            dst[i * dstStride] = this->step(src[j * srcStride]);
+        }
+    }
+
+private:
+    void reset() const {
+        for (int pass = 0; pass < 3; pass++) {
+            fSums[pass] = 0;
+            fRing[pass].assign(fPassSize[pass], 0);
+            fCursor[pass] = 0;
+        }
+    }
+
+    uint8_t step(uint32_t leadingEdge) const {
+        fSums[0] += leadingEdge;
+        fSums[1] += fSums[0];
+        fSums[2] += fSums[1];
+        uint8_t result = SkTo<uint8_t>((fWeight * fSums[2] + (1ull << 31)) >> 32);
+
+        uint32_t entering[3] = { leadingEdge, fSums[0], fSums[1] };
+        for (int pass = 2; pass >= 0; pass--) {
+            fSums[pass] -= fRing[pass][fCursor[pass]];
+            fRing[pass][fCursor[pass]] = entering[pass];
+            fCursor[pass] = (fCursor[pass] + 1) % fPassSize[pass];
+        }
+        return result;
+    }
+
+    int      fPassSize[3];
+    int      fBorder;
+    uint64_t fWeight;
+
+    mutable uint32_t              fSums[3];
+    mutable std::vector<uint32_t> fRing[3];
+    mutable int                   fCursor[3];
+};
+}
+
+DEF_TEST(BlurMaskBands, reporter) {
+    // Big enough to be split into bands, and not a multiple of 8 in either direction.
+    const int w = 301, h = 517;
+
+    SkMask a8;
+    a8.fBounds   = SkIRect::MakeWH(w, h);
+    a8.fFormat   = SkMask::kA8_Format;
+    a8.fRowBytes = w;
+    a8.fImage    = SkMask::AllocImage(a8.computeTotalImageSize());
+    SkAutoMaskFreeImage freeA8(a8.fImage);
+
+    SkMask argb = a8;
+    argb.fFormat   = SkMask::kARGB32_Format;
+    argb.fRowBytes = 4 * w;
+    argb.fImage    = SkMask::AllocImage(argb.computeTotalImageSize());
+    SkAutoMaskFreeImage freeARGB(argb.fImage);
+
+    SkRandom rand;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            uint8_t alpha = rand.nextBool() ? 0 : SkToU8(rand.nextU());
+            *a8.getAddr8(x, y)    = alpha;
+            *argb.getAddr32(x, y) = SkPackARGB32(alpha, 0, 0, 0);
+        }
+    }
+
+    std::unique_ptr<SkExecutor> pool = SkExecutor::MakeFIFOThreadPool(4);
+
+    for (double sigma : { 2.5, 17.0, 80.0 }) {
+        ReferenceGauss gauss(sigma);
+        const int border = gauss.border(),
+                  dstW   = w + 2 * border,
+                  dstH   = h + 2 * border;
+
+        // Blur horizontally into tmp, then vertically into expected.
+        std::vector<uint8_t> tmp(dstW * h), expected(dstW * dstH);
+        for (int y = 0; y < h; y++) {
+            gauss.blur(a8.getAddr8(0, y), 1, w, &tmp[y * dstW], 1);
+        }
+        for (int x = 0; x < dstW; x++) {
+            gauss.blur(&tmp[x], dstW, h, &expected[x], dstW);
+        }
+
+        // Without an executor the mask goes through the scalar scan instead of the bands.
+        SkMask actual, converted, serial;
+        SkMaskBlurFilter(sigma, sigma, pool.get()).blur(a8, &actual);
+        SkMaskBlurFilter(sigma, sigma, pool.get()).blur(argb, &converted);
+        SkMaskBlurFilter(sigma, sigma).blur(a8, &serial);
+        SkAutoMaskFreeImage freeActual(actual.fImage),
+                            freeConverted(converted.fImage),
+                            freeSerial(serial.fImage);
+
+        const SkIRect bounds = SkIRect::MakeLTRB(-border, -border, w + border, h + border);
+        REPORTER_ASSERT(reporter, actual.fBounds == bounds);
+        REPORTER_ASSERT(reporter, converted.fBounds == bounds);
+        REPORTER_ASSERT(reporter, serial.fBounds == bounds);
+        if (actual.fBounds != bounds || converted.fBounds != bounds || serial.fBounds != bounds) {
+            continue;
+        }
+
+        REPORTER_ASSERT(reporter, !memcmp(expected.data(), actual.fImage, expected.size()),
+                        "sigma %g: banded blur differs from the scalar blur", sigma);
+        REPORTER_ASSERT(reporter, !memcmp(expected.data(), converted.fImage, expected.size()),
+                        "sigma %g: ARGB32 mask blurs differently from A8", sigma);
+        REPORTER_ASSERT(reporter, !memcmp(expected.data(), serial.fImage, expected.size()),
+                        "sigma %g: scalar scan differs from the reference", sigma);
+    }
+}
@@ -8,10 +8,13 @@
 #include "CodecPriv.h"
 #include "Resources.h"
 #include "SkAndroidCodec.h"
+#include "SkAnimCodecPlayer.h"
 #include "SkBitmap.h"
 #include "SkCodec.h"
 #include "SkCodecAnimation.h"
 #include "SkData.h"
+#include "SkExecutor.h"
+#include "SkImage.h"
 #include "SkImageInfo.h"
 #include "SkRefCnt.h"
 #include "SkSize.h"
@@ -446,3 +449,139 @@ DEF_TEST(AndroidCodec_animated, r) {
         }
     }
 }
+
+static bool same_pixels(SkImage* a, SkImage* b) {
+    SkPixmap pa, pb;
+    if (!a || !b || !a->peekPixels(&pa) || !b->peekPixels(&pb) || pa.info() != pb.info()) {
+        return false;
+    }
+    for (int y = 0; y < pa.height(); ++y) {
+        if (memcmp(pa.addr(0, y), pb.addr(0, y), pa.info().minRowBytes())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// A player that may only keep a few frames, or that decodes ahead, shows the same frames as one
+// that keeps them all, whichever way and however far it seeks.
+DEF_TEST(AnimCodecPlayer_frameCache, r) {
+    const char* file = "images/alphabetAnim.gif";
+    sk_sp<SkData> data(GetResourceAsData(file));
+    if (!data) {
+        ERRORF(r, "Missing %s", file);
+        return;
+    }
+
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+    const size_t frameBytes = codec->getInfo().computeMinByteSize();
+    const uint32_t frameDuration = 100;
+    const uint32_t duration = 13 * frameDuration;
+
+    std::vector<uint32_t> times;
+    for (uint32_t t = 0; t < 2 * duration; t += frameDuration) {
+        times.push_back(t);                      // forward, around the loop twice
+    }
+    for (uint32_t t = 2 * duration; t > 0; t -= frameDuration) {
+        times.push_back(t - 1);                  // backward
+    }
+    for (uint32_t t = 0; t < 2 * duration; t += 5 * frameDuration) {
+        times.push_back(t);                      // skipping frames
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    const struct {
+        size_t      fBudget;
+        SkExecutor* fExecutor;
+    } gRecs[] = {
+        { 0,              nullptr },
+        { 2 * frameBytes, nullptr },
+        { 3 * frameBytes, nullptr },
+        { 0,              executor.get() },
+        { 3 * frameBytes, executor.get() },
+        { SIZE_MAX,       executor.get() },
+    };
+    for (const auto& rec : gRecs) {
+        SkAnimCodecPlayer reference(SkCodec::MakeFromData(data));
+        SkAnimCodecPlayer player(SkCodec::MakeFromData(data), rec.fBudget, rec.fExecutor);
+        REPORTER_ASSERT(r, player.duration() == duration);
+        for (uint32_t t : times) {
+            REPORTER_ASSERT(r, player.seek(t) == reference.seek(t));
+            sk_sp<SkImage> frame = player.getFrame();
+            REPORTER_ASSERT(r, frame == player.getFrame());
+            if (!same_pixels(frame.get(), reference.getFrame().get())) {
+                ERRORF(r, "Frame at %u differs with budget %zu", t, rec.fBudget);
+            }
+        }
+    }
+}
+
+// A still image plays as a single frame.
+DEF_TEST(AnimCodecPlayer_still, r) {
+    std::unique_ptr<SkCodec> codec =
+            SkCodec::MakeFromData(GetResourceAsData("images/mandrill_128.png"));
+    if (!codec) {
+        ERRORF(r, "Could not create codec");
+        return;
+    }
+    SkAnimCodecPlayer player(std::move(codec));
+    REPORTER_ASSERT(r, player.duration() == 0);
+    REPORTER_ASSERT(r, !player.seek(0));
+    REPORTER_ASSERT(r, !player.seek(1000));
+    sk_sp<SkImage> frame = player.getFrame();
+    REPORTER_ASSERT(r, frame && frame->width() == 128 && frame == player.getFrame());
+}
+
+// Decoding a range of frames at once, serially or on an executor, gives the same pixels as
+// decoding each frame on its own.
+DEF_TEST(Codec_DecodeFrames, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (const char* file : { "images/required.gif",
+                              "images/alphabetAnim.gif",
+                              "images/randPixelsAnim.gif",
+                              "images/required.webp",
+                              "images/webp-animated.webp",
+                              "images/mandrill_128.png" }) {
+        sk_sp<SkData> data(GetResourceAsData(file));
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+        if (!codec) {
+            continue;
+        }
+        const SkImageInfo info = codec->getInfo().makeColorType(kN32_SkColorType)
+                                                 .makeAlphaType(kPremul_SkAlphaType);
+        const int frameCount = codec->getFrameCount();
+
+        std::vector<SkBitmap> expected(frameCount);
+        for (int i = 0; i < frameCount; ++i) {
+            expected[i].allocPixels(info);
+            SkCodec::Options options;
+            options.fFrameIndex = i;
+            REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(expected[i].pixmap(),
+                                                                     &options));
+        }
+
+        for (SkExecutor* exec : { (SkExecutor*)nullptr, executor.get() }) {
+            for (int first : { 0, frameCount / 2 }) {
+                const int count = frameCount - first;
+                std::vector<SkBitmap> bitmaps(count);
+                std::vector<void*> pixels(count);
+                for (int i = 0; i < count; ++i) {
+                    bitmaps[i].allocPixels(info);
+                    pixels[i] = bitmaps[i].getPixels();
+                }
+                REPORTER_ASSERT(r, SkCodec::kSuccess ==
+                        SkCodec::DecodeFrames(data, info, pixels.data(), info.minRowBytes(),
+                                              first, count, exec));
+                for (int i = 0; i < count; ++i) {
+                    if (!sk_tool_utils::equal_pixels(bitmaps[i], expected[first + i])) {
+                        ERRORF(r, "%s: frame %i differs (first %i, executor %p)",
+                               file, first + i, first, exec);
+                    }
+                }
+            }
+        }
+
+        REPORTER_ASSERT(r, SkCodec::kInvalidParameters ==
+                SkCodec::DecodeFrames(data, info, nullptr, info.minRowBytes(), 0, frameCount + 1));
+    }
+}
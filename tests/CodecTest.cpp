@@ -18,6 +18,7 @@
 #include "SkColorSpacePriv.h"
 #include "SkData.h"
 #include "SkEncodedImageFormat.h"
+#include "SkExecutor.h"
 #include "SkFrontBufferedStream.h"
 #include "SkImage.h"
 #include "SkImageGenerator.h"
@@ -880,6 +881,101 @@ DEF_TEST(Codec_raw_notseekable, r) {
 }
 #endif
 
+// Decoding from memory reads the encoded bytes in place. Check that it produces the same
+// pixels as decoding from a stream that has to copy them, for complete and truncated data.
+DEF_TEST(Codec_readInPlace, r) {
+    const char* paths[] = {
+        "images/mandrill_128.png",
+        "images/color_wheel.gif",
+        "images/randPixels.bmp",
+        "images/rle.bmp",
+    };
+    for (const char* path : paths) {
+        sk_sp<SkData> data(GetResourceAsData(path));
+        if (!data) {
+            SkDebugf("Missing resource '%s'\n", path);
+            continue;
+        }
+
+        for (size_t length : { data->size(), data->size() * 2 / 3 }) {
+            sk_sp<SkData> subset = SkData::MakeSubset(data.get(), 0, length);
+
+            std::unique_ptr<SkStream> streams[] = {
+                skstd::make_unique<NotAssetMemStream>(subset),
+                skstd::make_unique<SkMemoryStream>(subset),
+                SkFrontBufferedStream::Make(skstd::make_unique<SkMemoryStream>(subset),
+                                            SkCodec::MinBufferedBytesNeeded()),
+            };
+            SkMD5::Digest digests[SK_ARRAY_COUNT(streams)];
+            SkCodec::Result results[SK_ARRAY_COUNT(streams)];
+            for (size_t i = 0; i < SK_ARRAY_COUNT(streams); i++) {
+                std::unique_ptr<SkCodec> codec(SkCodec::MakeFromStream(std::move(streams[i])));
+                if (!codec) {
+                    ERRORF(r, "Could not create codec for '%s' (%d)", path, (int) i);
+                    return;
+                }
+
+                SkBitmap bm;
+                bm.allocPixels(codec->getInfo().makeColorType(kN32_SkColorType)
+                                                .makeAlphaType(kPremul_SkAlphaType));
+                bm.eraseColor(SK_ColorTRANSPARENT);
+                results[i] = codec->getPixels(bm.pixmap());
+                md5(bm, &digests[i]);
+            }
+
+            for (size_t i = 1; i < SK_ARRAY_COUNT(streams); i++) {
+                REPORTER_ASSERT(r, results[i] == results[0]);
+                REPORTER_ASSERT(r, digests[i] == digests[0]);
+            }
+        }
+    }
+}
+
+// A 32 bit BMP's pixels start at offset 54, which is not 4 byte aligned. Rows read in place
+// would be swizzled as unaligned words, so they must be copied first.
+DEF_TEST(Codec_readInPlace_unalignedBmp, r) {
+    const int kWidth = 3, kHeight = 2;
+    const uint32_t kPixelsOffset = 54, kSize = kPixelsOffset + kWidth * kHeight * 4;
+    SkDynamicMemoryWStream stream;
+    auto write16 = [&stream](uint16_t v) { stream.write(&v, sizeof(v)); };
+    auto write32 = [&stream](uint32_t v) { stream.write(&v, sizeof(v)); };
+    stream.write("BM", 2);
+    write32(kSize);
+    write32(0);                 // reserved
+    write32(kPixelsOffset);
+    write32(40);                // BITMAPINFOHEADER
+    write32(kWidth);
+    write32(kHeight);
+    write16(1);                 // planes
+    write16(32);                // bits per pixel
+    write32(0);                 // BI_RGB
+    for (int i = 0; i < 5; i++) {
+        write32(0);
+    }
+    for (int i = 0; i < kWidth * kHeight; i++) {
+        write32(0xFF000000 | (i * 0x102030));
+    }
+    sk_sp<SkData> data = stream.detachAsData();
+    REPORTER_ASSERT(r, data->size() == kSize);
+
+    std::unique_ptr<SkCodec> copied(SkCodec::MakeFromStream(
+            skstd::make_unique<NotAssetMemStream>(data)));
+    std::unique_ptr<SkCodec> inPlace(SkCodec::MakeFromData(data));
+    if (!copied || !inPlace) {
+        ERRORF(r, "Could not create codec for generated BMP");
+        return;
+    }
+
+    SkImageInfo info = SkImageInfo::MakeN32Premul(kWidth, kHeight);
+    SkBitmap expected, actual;
+    expected.allocPixels(info);
+    actual.allocPixels(info);
+    REPORTER_ASSERT(r, SkCodec::kSuccess == copied->getPixels(expected.pixmap()));
+    REPORTER_ASSERT(r, SkCodec::kSuccess == inPlace->getPixels(actual.pixmap()));
+    REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                   expected.computeByteSize()));
+}
+
 // Test that even if webp_parse_header fails to peek enough, it will fall back to read()
 // + rewind() and succeed.
 DEF_TEST(Codec_webp_peek, r) {
@@ -1659,3 +1755,68 @@ DEF_TEST(Codec_crbug807324, r) {
         }
     }
 }
+
+// Both images divide their entropy-coded data into restart intervals, so given an executor,
+// SkJpegCodec decodes bands of intervals concurrently. That must match a serial decode exactly.
+DEF_TEST(Codec_jpegRestartIntervals, r) {
+    if (GetResourcePath().isEmpty()) {
+        return;
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkCodec::Options options;
+    options.fExecutor = executor.get();
+
+    for (const char* path : { "images/icc-v2-gbr.jpg", "images/mandrill_cmyk.jpg" }) {
+        sk_sp<SkData> data = GetResourceAsData(path);
+        if (!data) {
+            ERRORF(r, "missing %s", path);
+            continue;
+        }
+
+        // A truncated image has no EOI, and so must fall back to the serial decode.  Both images
+        // have large metadata segments, so only cut into the entropy-coded data.
+        sk_sp<SkData> truncated = SkData::MakeSubset(data.get(), 0, data->size() - 1024);
+
+        const SkImageInfo info = SkCodec::MakeFromData(data)->getInfo();
+        const SkISize scaled = SkCodec::MakeFromData(data)->getScaledDimensions(0.5f);
+        const SkImageInfo infos[] = {
+            info,
+            info.makeWH(scaled.width(), scaled.height()),
+            info.makeColorType(kRGB_565_SkColorType).makeColorSpace(nullptr),
+            // Color xform in place, and from a scratch row.
+            info.makeColorSpace(SkColorSpace::MakeSRGB()),
+            info.makeColorType(kRGBA_F16_SkColorType)
+                .makeColorSpace(SkColorSpace::MakeSRGBLinear()),
+        };
+
+        for (const sk_sp<SkData>& encoded : { data, truncated }) {
+            for (const SkImageInfo& dstInfo : infos) {
+                SkBitmap serial, parallel;
+                serial.allocPixels(dstInfo);
+                parallel.allocPixels(dstInfo);
+
+                std::unique_ptr<SkCodec> serialCodec = SkCodec::MakeFromData(encoded);
+                std::unique_ptr<SkCodec> parallelCodec = SkCodec::MakeFromData(encoded);
+                if (!serialCodec || !parallelCodec) {
+                    ERRORF(r, "%s: could not create codec", path);
+                    continue;
+                }
+                auto expected = serialCodec->getPixels(serial.pixmap());
+                auto result = parallelCodec->getPixels(parallel.pixmap(), &options);
+                if (result != expected) {
+                    ERRORF(r, "%s: parallel decode returned %s, serial decode returned %s", path,
+                           SkCodec::ResultToString(result), SkCodec::ResultToString(expected));
+                    continue;
+                }
+                if (SkCodec::kSuccess != expected && SkCodec::kIncompleteInput != expected) {
+                    continue;
+                }
+
+                SkMD5::Digest serialDigest;
+                md5(serial, &serialDigest);
+                compare_to_good_digest(r, serialDigest, parallel);
+            }
+        }
+    }
+}
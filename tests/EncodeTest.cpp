@@ -11,6 +11,7 @@
 #include "SkBitmap.h"
 #include "SkColorPriv.h"
 #include "SkEncodedImageFormat.h"
+#include "SkExecutor.h"
 #include "SkImage.h"
 #include "SkJpegEncoder.h"
 #include "SkPngEncoder.h"
@@ -286,6 +287,71 @@ DEF_TEST(Encode_PngOptions, r) {
     REPORTER_ASSERT(r, almost_equals(bm0, bm2, 0));
 }
 
+DEF_TEST(Encode_PngParallel, r) {
+    SkBitmap bitmap;
+    bool success = GetResourceAsBitmap("images/mandrill_512.png", &bitmap);
+    if (!success) {
+        return;
+    }
+
+    // Opaque F16 is written as 16-bit RGB, so it exercises dropping the filler channel.
+    SkBitmap f16;
+    f16.allocPixels(bitmap.info().makeColorType(kRGBA_F16_SkColorType)
+                                 .makeAlphaType(kOpaque_SkAlphaType));
+    REPORTER_ASSERT(r, bitmap.readPixels(f16.pixmap()));
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    const struct {
+        SkPngEncoder::FilterFlag fFilters;
+        int                      fZLibLevel;
+    } kOptions[] = {
+        { SkPngEncoder::FilterFlag::kAll,  6 },
+        { SkPngEncoder::FilterFlag::kAll,  9 },
+        { SkPngEncoder::FilterFlag::kZero, 6 },
+        { SkPngEncoder::FilterFlag::kNone, 0 },
+        { SkPngEncoder::FilterFlag::kSub | SkPngEncoder::FilterFlag::kPaeth, 1 },
+    };
+
+    for (const SkBitmap* bm : { &bitmap, &f16 }) {
+        for (const auto& opts : kOptions) {
+            // Encode all at once, and a few rows at a time, which splits bands across calls.
+            for (int rowsPerCall : { bm->height(), 37 }) {
+                SkPngEncoder::Options options;
+                options.fFilterFlags = opts.fFilters;
+                options.fZLibLevel = opts.fZLibLevel;
+
+                SkDynamicMemoryWStream serialStream, parallelStream;
+                REPORTER_ASSERT(r, SkPngEncoder::Encode(&serialStream, bm->pixmap(), options));
+
+                options.fExecutor = executor.get();
+                auto encoder = SkPngEncoder::Make(&parallelStream, bm->pixmap(), options);
+                REPORTER_ASSERT(r, encoder);
+                for (int y = 0; y < bm->height(); y += rowsPerCall) {
+                    REPORTER_ASSERT(r, encoder->encodeRows(rowsPerCall));
+                }
+                encoder.reset();
+
+                sk_sp<SkData> serial = serialStream.detachAsData();
+                sk_sp<SkData> parallel = parallelStream.detachAsData();
+
+                // Priming each band with the previous one keeps the cost of splitting small.
+                REPORTER_ASSERT(r, parallel->size() < serial->size() + serial->size() / 50);
+
+                SkBitmap serialBm, parallelBm;
+                auto serialImage = SkImage::MakeFromEncoded(serial);
+                auto parallelImage = SkImage::MakeFromEncoded(parallel);
+                REPORTER_ASSERT(r, serialImage && parallelImage);
+                if (!serialImage || !parallelImage) {
+                    continue;
+                }
+                serialImage->asLegacyBitmap(&serialBm);
+                parallelImage->asLegacyBitmap(&parallelBm);
+                REPORTER_ASSERT(r, almost_equals(serialBm, parallelBm, 0));
+            }
+        }
+    }
+}
+
 DEF_TEST(Encode_WebpOptions, r) {
     SkBitmap bitmap;
     bool success = GetResourceAsBitmap("images/google_chrome.ico", &bitmap);
@@ -48,13 +48,31 @@ static void test_hasLength(skiatest::Reporter* reporter,
 // smaller than the string length.
 const char gAbcs[] = "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwx";
 
+// A memory stream that does not report where its data is, so a FrontBufferedStream that wraps it
+// has to buffer copies of its first bytes instead of reading it directly.
+class HiddenMemoryStream : public SkMemoryStream {
+public:
+    HiddenMemoryStream(const void* data, size_t size) : INHERITED(data, size, false) {}
+
+    const void* getMemoryBase() override { return nullptr; }
+
+private:
+    typedef SkMemoryStream INHERITED;
+};
+
+static SkMemoryStream* make_mem_stream(const void* data, size_t size, bool hideMemoryBase) {
+    return hideMemoryBase ? new HiddenMemoryStream(data, size)
+                          : new SkMemoryStream(data, size, false);
+}
+
 // Tests reading the stream across boundaries of what has been buffered so far and what
 // the total buffer size is.
-static void test_incremental_buffering(skiatest::Reporter* reporter, size_t bufferSize) {
+static void test_incremental_buffering(skiatest::Reporter* reporter, size_t bufferSize,
+                                       bool hideMemoryBase) {
     // NOTE: For this and other tests in this file, we cheat and continue to refer to the
     // wrapped stream, but that's okay because we know the wrapping stream has not been
     // deleted yet (and we only call const methods in it).
-    SkMemoryStream* memStream = SkMemoryStream::MakeDirect(gAbcs, strlen(gAbcs)).release();
+    SkMemoryStream* memStream = make_mem_stream(gAbcs, strlen(gAbcs), hideMemoryBase);
 
     auto bufferedStream = SkFrontBufferedStream::Make(std::unique_ptr<SkStream>(memStream),
                                                       bufferSize);
@@ -82,8 +100,9 @@ static void test_incremental_buffering(skiatest::Reporter* reporter, size_t buff
     test_rewind(reporter, bufferedStream.get(), false);
 }
 
-static void test_perfectly_sized_buffer(skiatest::Reporter* reporter, size_t bufferSize) {
-    SkMemoryStream* memStream = SkMemoryStream::MakeDirect(gAbcs, strlen(gAbcs)).release();
+static void test_perfectly_sized_buffer(skiatest::Reporter* reporter, size_t bufferSize,
+                                        bool hideMemoryBase) {
+    SkMemoryStream* memStream = make_mem_stream(gAbcs, strlen(gAbcs), hideMemoryBase);
     auto bufferedStream = SkFrontBufferedStream::Make(std::unique_ptr<SkStream>(memStream),
                                                       bufferSize);
     test_hasLength(reporter, *bufferedStream, *memStream);
@@ -102,8 +121,9 @@ static void test_perfectly_sized_buffer(skiatest::Reporter* reporter, size_t buf
     test_rewind(reporter, bufferedStream.get(), false);
 }
 
-static void test_skipping(skiatest::Reporter* reporter, size_t bufferSize) {
-    SkMemoryStream* memStream = SkMemoryStream::MakeDirect(gAbcs, strlen(gAbcs)).release();
+static void test_skipping(skiatest::Reporter* reporter, size_t bufferSize,
+                          bool hideMemoryBase) {
+    SkMemoryStream* memStream = make_mem_stream(gAbcs, strlen(gAbcs), hideMemoryBase);
     auto bufferedStream = SkFrontBufferedStream::Make(std::unique_ptr<SkStream>(memStream),
                                                       bufferSize);
     test_hasLength(reporter, *bufferedStream, *memStream);
@@ -215,8 +235,9 @@ static void test_length_combos(skiatest::Reporter* reporter, size_t bufferSize)
 }
 
 // Test using a stream with an initial offset.
-static void test_initial_offset(skiatest::Reporter* reporter, size_t bufferSize) {
-    SkMemoryStream* memStream = new SkMemoryStream(gAbcs, strlen(gAbcs), false);
+static void test_initial_offset(skiatest::Reporter* reporter, size_t bufferSize,
+                                bool hideMemoryBase) {
+    SkMemoryStream* memStream = make_mem_stream(gAbcs, strlen(gAbcs), hideMemoryBase);
 
     // Skip a few characters into the memStream, so that bufferedStream represents an offset into
     // the stream it wraps.
@@ -228,6 +249,10 @@ static void test_initial_offset(skiatest::Reporter* reporter, size_t bufferSize)
     // Since SkMemoryStream has a length, bufferedStream must also.
     REPORTER_ASSERT(reporter, bufferedStream->hasLength());
 
+    // Unless it is hidden, the memory can be read in place, from the offset.
+    const void* expectedBase = hideMemoryBase ? nullptr : gAbcs + arbitraryOffset;
+    REPORTER_ASSERT(reporter, bufferedStream->getMemoryBase() == expectedBase);
+
     const size_t amountToRead = 10;
     const size_t bufferedLength = bufferedStream->getLength();
     size_t currentPosition = 0;
@@ -247,12 +272,14 @@ static void test_initial_offset(skiatest::Reporter* reporter, size_t bufferSize)
 }
 
 static void test_buffers(skiatest::Reporter* reporter, size_t bufferSize) {
-    test_incremental_buffering(reporter, bufferSize);
-    test_perfectly_sized_buffer(reporter, bufferSize);
-    test_skipping(reporter, bufferSize);
+    for (bool hideMemoryBase : { false, true }) {
+        test_incremental_buffering(reporter, bufferSize, hideMemoryBase);
+        test_perfectly_sized_buffer(reporter, bufferSize, hideMemoryBase);
+        test_skipping(reporter, bufferSize, hideMemoryBase);
+        test_initial_offset(reporter, bufferSize, hideMemoryBase);
+    }
     test_read_beyond_buffer(reporter, bufferSize);
     test_length_combos(reporter, bufferSize);
-    test_initial_offset(reporter, bufferSize);
 }
 
 DEF_TEST(FrontBufferedStream, reporter) {
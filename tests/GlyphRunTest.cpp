@@ -7,8 +7,11 @@
 
 #include "SkGlyphRun.h"
 
+#include "SkBitmap.h"
+#include "SkCanvas.h"
 #include "SkTextBlob.h"
 #include "Test.h"
+#include "sk_tool_utils.h"
 
 #include <algorithm>
 #include <memory>
@@ -105,3 +108,68 @@ DEF_TEST(GlyphRunBlob, reporter) {
         runIndex += 1;
     }
 }
+
+// Consecutive A8 glyphs are packed into one strip mask on raster devices. Drawing a run at once
+// must match drawing its glyphs one run each, including where glyphs overlap.
+DEF_TEST(GlyphRunRasterMaskStrips, reporter) {
+    SkPaint font;
+    font.setTypeface(sk_tool_utils::create_portable_typeface("serif", SkFontStyle()));
+    font.setTextEncoding(SkPaint::kGlyphID_TextEncoding);
+    font.setTextSize(14);
+    font.setAntiAlias(true);
+
+    const char text[] = "The quick brown fox jumps over the lazy dog. fifty-fifty, tt rr //";
+    SkPaint utf8{font};
+    utf8.setTextEncoding(SkPaint::kUTF8_TextEncoding);
+    const int count = utf8.textToGlyphs(text, strlen(text), nullptr);
+    std::vector<SkGlyphID> glyphs(count);
+    utf8.textToGlyphs(text, strlen(text), glyphs.data());
+
+    // Three lines: normal spacing, tight spacing so glyphs overlap, and a fractional baseline.
+    std::vector<SkPoint> positions;
+    for (int line = 0; line < 3; line++) {
+        SkScalar advance = line == 1 ? 4.5f : 7.25f;
+        for (int i = 0; i < count; i++) {
+            positions.push_back({5 + i * advance, 20 + line * 18.5f});
+        }
+    }
+
+    for (bool subpixel : { false, true }) {
+        font.setSubpixelText(subpixel);
+
+        SkTextBlobBuilder builder;
+        const auto& run = builder.allocRunPos(font, SkToInt(positions.size()));
+        for (size_t i = 0; i < positions.size(); i++) {
+            run.glyphs[i] = glyphs[i % count];
+            run.pos[2 * i + 0] = positions[i].fX;
+            run.pos[2 * i + 1] = positions[i].fY;
+        }
+        sk_sp<SkTextBlob> blob = builder.make();
+
+        SkPaint paint;
+        paint.setColor(0x80204080);
+
+        SkBitmap expected, actual;
+        expected.allocN32Pixels(500, 80);
+        actual.allocN32Pixels(500, 80);
+        expected.eraseColor(SK_ColorWHITE);
+        actual.eraseColor(SK_ColorWHITE);
+
+        SkCanvas(actual).drawTextBlob(blob, 0, 0, paint);
+
+        SkCanvas expectedCanvas(expected);
+        for (size_t i = 0; i < positions.size(); i++) {
+            SkTextBlobBuilder single;
+            const auto& glyph = single.allocRunPos(font, 1);
+            glyph.glyphs[0] = glyphs[i % count];
+            glyph.pos[0] = positions[i].fX;
+            glyph.pos[1] = positions[i].fY;
+            expectedCanvas.drawTextBlob(single.make(), 0, 0, paint);
+        }
+
+        REPORTER_ASSERT(reporter,
+                        !memcmp(expected.getPixels(), actual.getPixels(), expected.computeByteSize()),
+                        "subpixel %d: a whole run differs from its glyphs drawn one by one",
+                        subpixel);
+    }
+}
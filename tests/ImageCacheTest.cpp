@@ -6,7 +6,9 @@
  */
 
 #include "SkDiscardableMemory.h"
+#include "SkExecutor.h"
 #include "SkResourceCache.h"
+#include "SkTaskGroup.h"
 #include "Test.h"
 
 namespace {
@@ -150,3 +152,45 @@ DEF_TEST(ImageCache_doubleAdd, r) {
     REPORTER_ASSERT(r, cache.find(key, TestingRec::Visitor, &value));
     REPORTER_ASSERT(r, 2 == value || 3 == value);
 }
+
+DEF_TEST(ImageCache_globalThreaded, r) {
+    // The global cache is sharded; hammer it from several threads and make sure each thread sees
+    // its own recs, and that purging by sharedID still reaches every shard.
+    // Other tests share the global cache, so a rec may have been purged for budget reasons;
+    // we only insist that what we do find is right.
+    static const int kThreads = 8;
+    static const int kRecs    = 200;
+    static const uint64_t kSharedIDBase = 0x1234567800000000ull;
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(kThreads);
+    SkTaskGroup tg(*executor);
+    std::atomic<int> wrong{0};
+
+    tg.batch(kThreads, [&](int thread) {
+        auto key = [&](int i) {
+            return TestingKey(thread * kRecs + i, kSharedIDBase + thread * 2 + (i & 1));
+        };
+        for (int i = 0; i < kRecs; ++i) {
+            SkResourceCache::Add(new TestingRec(key(i), thread * kRecs + i));
+        }
+        for (int i = 0; i < kRecs; ++i) {
+            intptr_t value = -1;
+            if (SkResourceCache::Find(key(i), TestingRec::Visitor, &value) &&
+                value != thread * kRecs + i) {
+                wrong++;
+            }
+        }
+
+        // Purge the odd recs; they should never be found again.
+        SkResourceCache::PostPurgeSharedID(kSharedIDBase + thread * 2 + 1);
+        for (int i = 1; i < kRecs; i += 2) {
+            intptr_t value = -1;
+            if (SkResourceCache::Find(key(i), TestingRec::Visitor, &value)) {
+                wrong++;
+            }
+        }
+    });
+    tg.wait();
+
+    REPORTER_ASSERT(r, wrong == 0);
+}
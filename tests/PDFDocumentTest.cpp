@@ -7,14 +7,33 @@
 #include "Test.h"
 
 #include "Resources.h"
+#include "SkAnnotation.h"
+#include "SkAnnotationKeys.h"
+#include "SkBitmap.h"
 #include "SkCanvas.h"
+#include "SkColorPriv.h"
+#include "SkExecutor.h"
+#include "SkImage.h"
+#include "SkImageEncoder.h"
 #include "SkOSFile.h"
 #include "SkOSPath.h"
 #include "SkPDFDocument.h"
+#include "SkPDFFontCache.h"
+#include "SkRandom.h"
 #include "SkStream.h"
+#include "SkTaskGroup.h"
+#include "SkTo.h"
+#include "SkTypeface.h"
 
 #include "sk_tool_utils.h"
 
+#include "zlib.h"
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
 static void test_empty(skiatest::Reporter* reporter) {
     SkDynamicMemoryWStream stream;
 
@@ -239,3 +258,734 @@ DEF_TEST(SkPDF_multiple_pages, r) {
                 SkColorSetARGB(0xFF, 0x00, (uint8_t)(255.0f * i / (n - 1)), 0x00));
     }
 }
+
+static sk_sp<SkData> make_document_with_executor(SkExecutor* executor) {
+    SkPDF::Metadata metadata;
+    metadata.fExecutor = executor;
+    SkDynamicMemoryWStream stream;
+    auto doc = SkPDF::MakeDocument(&stream, metadata);
+    SkRandom random;
+    for (int page = 0; page < 4; ++page) {
+        SkCanvas* canvas = doc->beginPage(612, 792);
+        for (int i = 0; i < 3; ++i) {
+            SkBitmap bitmap;
+            bitmap.allocN32Pixels(64 + 16 * i, 48, i == 0);
+            for (int y = 0; y < bitmap.height(); ++y) {
+                for (int x = 0; x < bitmap.width(); ++x) {
+                    uint8_t a = i == 0 ? 0xFF : SkToU8(random.nextU());
+                    *bitmap.getAddr32(x, y) = SkPreMultiplyARGB(a, SkToU8(random.nextU()),
+                                                                SkToU8(x * 4), SkToU8(y * 5));
+                }
+            }
+            canvas->drawImage(SkImage::MakeFromBitmap(bitmap), 20.0f + 150 * i, 20.0f * page);
+        }
+        SkPaint paint;
+        paint.setTextSize(12);
+        paint.setColor(SK_ColorBLUE);
+        canvas->drawString("The quick brown fox jumps over the lazy dog.", 20, 400, paint);
+        canvas->drawCircle(300, 600, 40.0f + page, paint);
+    }
+    doc->close();
+    return stream.detachAsData();
+}
+
+// The executor only changes where work happens, never the bytes that come out.
+DEF_TEST(SkPDF_executor_is_deterministic, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_executor_is_deterministic, r);
+    sk_sp<SkData> expected = make_document_with_executor(nullptr);
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (int i = 0; i < 3; ++i) {
+        sk_sp<SkData> actual = make_document_with_executor(executor.get());
+        REPORTER_ASSERT(r, expected->equals(actual.get()));
+    }
+}
+
+// Checks that every entry of the xref section at xref points at the object it numbers.
+static bool xref_section_is_consistent(const std::string& text, size_t xref) {
+    int first = 0, count = 0;
+    if (xref >= text.size() || 2 != sscanf(text.c_str() + xref, "xref\n%d %d", &first, &count)) {
+        return false;
+    }
+    size_t entry = text.find('\n', xref + strlen("xref\n")) + 1;
+    for (int i = 0; i < count; ++i, entry += 20) {
+        if (first + i == 0) {
+            continue;  // The free list.
+        }
+        size_t offset = strtoul(text.c_str() + entry, nullptr, 10);
+        SkString expected = SkStringPrintf("%d 0 obj\n", first + i);
+        if (offset >= text.size() ||
+            text.compare(offset, expected.size(), expected.c_str()) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Checks that every entry of the xref table points at the object it numbers.
+static bool xref_is_consistent(const SkData* pdf) {
+    std::string text(static_cast<const char*>(pdf->data()), pdf->size());
+    size_t startxref = text.rfind("startxref\n");
+    if (startxref == std::string::npos) {
+        return false;
+    }
+    size_t xref = strtoul(text.c_str() + startxref + strlen("startxref\n"), nullptr, 10);
+    return xref < text.size() &&
+           text.compare(xref, strlen("xref\n0 "), "xref\n0 ") == 0 &&
+           xref_section_is_consistent(text, xref);
+}
+
+static int count_occurrences(const SkData* data, const char needle[]) {
+    std::string text(static_cast<const char*>(data->data()), data->size());
+    int count = 0;
+    for (size_t i = text.find(needle); i != std::string::npos; i = text.find(needle, i + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+DEF_TEST(SkPDF_stream_pages, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_stream_pages, r);
+    for (bool streamPages : {false, true}) {
+        SkPDF::Metadata metadata;
+        metadata.fStreamPages = streamPages;
+        SkDynamicMemoryWStream stream;
+        auto doc = SkPDF::MakeDocument(&stream, metadata);
+        SkPaint paint;
+        paint.setTextSize(12);
+        const int kPages = 20;
+        size_t written = 0, firstPageBytes = 0;
+        for (int i = 0; i < kPages; ++i) {
+            SkCanvas* canvas = doc->beginPage(612, 792);
+            canvas->drawString(SkStringPrintf("Page %d", i), 20, 20, paint);
+            paint.setAlpha(0x40 + i);
+            canvas->drawRect({100, 100, 200, 200}, paint);
+            doc->endPage();
+
+            // Streamed pages are in the stream as soon as they end, and each one adds about
+            // as much as the first did, so nothing builds up for close() to write.
+            sk_sp<SkData> sofar = SkData::MakeUninitialized(stream.bytesWritten());
+            stream.copyTo(sofar->writable_data());
+            const int pagesWritten = count_occurrences(sofar.get(), "/Type /Page\n");
+            REPORTER_ASSERT(r, pagesWritten == (streamPages ? i + 1 : 0));
+            const size_t pageBytes = sofar->size() - written;
+            written = sofar->size();
+            if (i == 0) {
+                firstPageBytes = pageBytes;
+            } else if (streamPages) {
+                REPORTER_ASSERT(r, pageBytes > 0 && pageBytes <= 2 * firstPageBytes,
+                                "page %d added %zu bytes, the first %zu", i, pageBytes,
+                                firstPageBytes);
+            }
+        }
+        doc->close();
+        sk_sp<SkData> data = stream.detachAsData();
+        REPORTER_ASSERT(r, xref_is_consistent(data.get()));
+        REPORTER_ASSERT(r, contains(data->bytes(), data->size(), "/Count 20"));
+    }
+}
+
+// Reads the stream object whose "N 0 obj" line starts at offset into its dictionary and its
+// data, which is inflated if the stream is compressed.
+static bool read_stream_object(const std::string& text, size_t offset,
+                               std::string* dict, std::string* data) {
+    size_t streamStart = text.find(" stream\n", offset);
+    if (offset >= text.size() || streamStart == std::string::npos) {
+        return false;
+    }
+    *dict = text.substr(offset, streamStart - offset);
+    size_t length = dict->find("/Length ");
+    if (length == std::string::npos) {
+        return false;
+    }
+    size_t srcLen = strtoul(dict->c_str() + length + strlen("/Length "), nullptr, 10);
+    size_t begin = streamStart + strlen(" stream\n");
+    if (begin + srcLen > text.size()) {
+        return false;
+    }
+    if (dict->find("/FlateDecode") == std::string::npos) {
+        *data = text.substr(begin, srcLen);
+        return true;
+    }
+    for (uLongf capacity = 16 * srcLen + 1024; capacity < (1u << 30); capacity *= 4) {
+        uLongf dstLen = capacity;
+        data->assign(dstLen, '\0');
+        int result = uncompress(reinterpret_cast<Bytef*>(&(*data)[0]), &dstLen,
+                                reinterpret_cast<const Bytef*>(text.data() + begin), srcLen);
+        if (result == Z_OK) {
+            data->resize(dstLen);
+            return true;
+        }
+        if (result != Z_BUF_ERROR) {
+            return false;
+        }
+    }
+    return false;
+}
+
+// Reads the object numbers listed at the start of the object stream whose "N 0 obj" line
+// starts at offset, checking that each of their offsets is inside the stream.
+static bool read_object_stream(const std::string& text, size_t offset,
+                               std::vector<int>* objectNumbers) {
+    std::string dict, data;
+    if (!read_stream_object(text, offset, &dict, &data) ||
+        dict.find("/Type /ObjStm") == std::string::npos) {
+        return false;
+    }
+    size_t n = dict.find("/N "), first = dict.find("/First ");
+    if (n == std::string::npos || first == std::string::npos) {
+        return false;
+    }
+    int count = atoi(dict.c_str() + n + strlen("/N "));
+    size_t firstOffset = strtoul(dict.c_str() + first + strlen("/First "), nullptr, 10);
+    const char* cursor = data.c_str();
+    for (int i = 0; i < count; ++i) {
+        char* end;
+        long objectNumber = strtol(cursor, &end, 10);
+        size_t objectOffset = strtoul(end, &end, 10);
+        if (end == cursor || firstOffset + objectOffset >= data.size()) {
+            return false;
+        }
+        objectNumbers->push_back(SkToInt(objectNumber));
+        cursor = end;
+    }
+    return true;
+}
+
+// Checks that every entry of the cross-reference stream finds the object it numbers: type 1
+// entries at their byte offset, and type 2 entries at their index in their object stream.
+// Counts the type 2 entries in inObjectStreams.
+static bool xref_stream_is_consistent(const SkData* pdf, int* inObjectStreams) {
+    std::string text(static_cast<const char*>(pdf->data()), pdf->size());
+    size_t startxref = text.rfind("startxref\n");
+    if (startxref == std::string::npos) {
+        return false;
+    }
+    size_t xref = strtoul(text.c_str() + startxref + strlen("startxref\n"), nullptr, 10);
+    std::string dict, entries;
+    if (!read_stream_object(text, xref, &dict, &entries) ||
+        dict.find("/Type /XRef") == std::string::npos ||
+        dict.find("/W [1 4 2]") == std::string::npos ||
+        dict.find("/Size ") == std::string::npos) {
+        return false;
+    }
+    int size = atoi(dict.c_str() + dict.find("/Size ") + strlen("/Size "));
+    if (entries.size() != 7u * size) {
+        return false;
+    }
+
+    auto entry = [&entries](int i, int* type, uint32_t* field2, uint32_t* field3) {
+        const uint8_t* e = reinterpret_cast<const uint8_t*>(entries.data()) + 7 * i;
+        *type   = e[0];
+        *field2 = (uint32_t)e[1] << 24 | e[2] << 16 | e[3] << 8 | e[4];
+        *field3 = e[5] << 8 | e[6];
+    };
+
+    std::map<uint32_t, std::vector<int>> objectStreams;
+    *inObjectStreams = 0;
+    for (int i = 0; i < size; ++i) {
+        int type;
+        uint32_t field2, field3;
+        entry(i, &type, &field2, &field3);
+        if (i == 0) {
+            if (type != 0) {
+                return false;
+            }
+        } else if (type == 1) {
+            SkString expected = SkStringPrintf("%d 0 obj\n", i);
+            if (field2 >= text.size() ||
+                text.compare(field2, expected.size(), expected.c_str()) != 0) {
+                return false;
+            }
+        } else if (type == 2) {
+            if (!objectStreams.count(field2)) {
+                int streamType;
+                uint32_t streamOffset, unused;
+                if (field2 == 0 || (int)field2 >= size) {
+                    return false;
+                }
+                entry(field2, &streamType, &streamOffset, &unused);
+                if (streamType != 1 ||
+                    !read_object_stream(text, streamOffset, &objectStreams[field2])) {
+                    return false;
+                }
+            }
+            const std::vector<int>& members = objectStreams[field2];
+            if (field3 >= members.size() || members[field3] != i) {
+                return false;
+            }
+            ++*inObjectStreams;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+DEF_TEST(SkPDF_object_streams, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_object_streams, r);
+    sk_sp<SkData> pdfs[2];
+    for (bool useObjectStreams : {false, true}) {
+        SkPDF::Metadata metadata;
+        metadata.fUseObjectStreams = useObjectStreams;
+        SkDynamicMemoryWStream stream;
+        auto doc = SkPDF::MakeDocument(&stream, metadata);
+        SkPaint paint;
+        paint.setTextSize(12);
+        for (int i = 0; i < 10; ++i) {
+            SkCanvas* canvas = doc->beginPage(612, 792);
+            for (int line = 0; line < 40; ++line) {
+                paint.setColor(SkColorSetARGB(0x80 + line, 0, 0, 0));
+                canvas->drawString(SkStringPrintf("Page %d, line %d", i, line),
+                                   20, 20.0f + 15 * line, paint);
+            }
+            canvas->drawAnnotation({10, 10, 50, 50}, SkAnnotationKeys::URL_Key(),
+                                   SkData::MakeWithCString("https://skia.org/").get());
+        }
+        doc->close();
+        pdfs[useObjectStreams] = stream.detachAsData();
+    }
+    const SkData* plain = pdfs[0].get();
+    const SkData* packed = pdfs[1].get();
+    REPORTER_ASSERT(r, contains(plain->bytes(), plain->size(), "%PDF-1.4"));
+    REPORTER_ASSERT(r, contains(plain->bytes(), plain->size(), "\ntrailer\n"));
+    REPORTER_ASSERT(r, contains(packed->bytes(), packed->size(), "%PDF-1.5"));
+    REPORTER_ASSERT(r, contains(packed->bytes(), packed->size(), "/Type /ObjStm"));
+    REPORTER_ASSERT(r, contains(packed->bytes(), packed->size(), "/Type /XRef"));
+    REPORTER_ASSERT(r, !contains(packed->bytes(), packed->size(), "\ntrailer\n"));
+    REPORTER_ASSERT(r, packed->size() < plain->size());
+
+    REPORTER_ASSERT(r, xref_is_consistent(plain));
+    int inObjectStreams = 0;
+    REPORTER_ASSERT(r, xref_stream_is_consistent(packed, &inObjectStreams));
+    REPORTER_ASSERT(r, inObjectStreams > 0);
+}
+
+DEF_TEST(SkPDF_deduplicate_images_by_content, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_deduplicate_images_by_content, r);
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(32, 32, true);
+    for (int y = 0; y < 32; ++y) {
+        for (int x = 0; x < 32; ++x) {
+            *bitmap.getAddr32(x, y) = SkPackARGB32(0xFF, x * 8, y * 8, 0x80);
+        }
+    }
+    SkPixmap pixmap;
+    SkAssertResult(bitmap.peekPixels(&pixmap));
+
+    for (bool dedup : {false, true}) {
+        SkPDF::Metadata metadata;
+        metadata.fDeduplicateImagesByContent = dedup;
+        SkDynamicMemoryWStream stream;
+        auto doc = SkPDF::MakeDocument(&stream, metadata);
+        for (int page = 0; page < 3; ++page) {
+            // A new SkImage, with a new unique ID, for the same pixels on every page.
+            sk_sp<SkImage> image = SkImage::MakeRasterCopy(pixmap);
+            doc->beginPage(100, 100)->drawImage(image, 10, 10);
+        }
+        // Different pixels are never merged.
+        SkBitmap red;
+        red.allocN32Pixels(32, 32, true);
+        red.eraseColor(SK_ColorRED);
+        doc->beginPage(100, 100)->drawImage(SkImage::MakeFromBitmap(red), 10, 10);
+        doc->close();
+        sk_sp<SkData> data = stream.detachAsData();
+        REPORTER_ASSERT(r, count_occurrences(data.get(), "/Subtype /Image") == (dedup ? 2 : 4));
+    }
+}
+
+// Lazy subsets of one encoded image share its encoded data, but not its pixels.
+DEF_TEST(SkPDF_deduplicate_image_subsets_by_content, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_deduplicate_image_subsets_by_content, r);
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(64, 32, true);
+    bitmap.eraseArea(SkIRect::MakeWH(32, 32), SK_ColorRED);
+    bitmap.eraseArea(SkIRect::MakeXYWH(32, 0, 32, 32), SK_ColorBLUE);
+    sk_sp<SkImage> sheet =
+            SkImage::MakeFromEncoded(SkEncodeBitmap(bitmap, SkEncodedImageFormat::kPNG, 100));
+    if (!sheet) {
+        INFOF(r, "Could not decode PNG; skipping test.");
+        return;
+    }
+
+    SkPDF::Metadata metadata;
+    metadata.fDeduplicateImagesByContent = true;
+    SkDynamicMemoryWStream stream;
+    auto doc = SkPDF::MakeDocument(&stream, metadata);
+    for (int x : { 0, 32, 0 }) {
+        sk_sp<SkImage> subset = sheet->makeSubset(SkIRect::MakeXYWH(x, 0, 32, 32));
+        REPORTER_ASSERT(r, subset);
+        doc->beginPage(100, 100)->drawImage(subset, 10, 10);
+    }
+    doc->close();
+    sk_sp<SkData> data = stream.detachAsData();
+    REPORTER_ASSERT(r, count_occurrences(data.get(), "/Subtype /Image") == 2);
+}
+
+// Reads the big-endian bit fields of a hint table.
+class HintTableReader {
+public:
+    HintTableReader(const uint8_t* data, size_t size) : fData(data), fSize(size) {}
+    uint32_t read(int bits) {
+        uint32_t value = 0;
+        for (int i = 0; i < bits; ++i, ++fBit) {
+            uint8_t byte = fBit / 8 < fSize ? fData[fBit / 8] : 0;
+            value = (value << 1) | ((byte >> (7 - fBit % 8)) & 1);
+        }
+        return value;
+    }
+    void align() { fBit = (fBit + 7) / 8 * 8; }
+    void seek(size_t byte) { fBit = byte * 8; }
+    bool overran() const { return fBit > fSize * 8; }
+
+private:
+    const uint8_t* fData;
+    size_t fSize;
+    size_t fBit = 0;
+};
+
+static std::vector<uint32_t> read_hint_item(HintTableReader* reader, size_t count, uint32_t least,
+                                            int bits) {
+    std::vector<uint32_t> values;
+    for (size_t i = 0; i < count; ++i) {
+        values.push_back(least + reader->read(bits));
+    }
+    reader->align();
+    return values;
+}
+
+static int find_int(const std::string& text, size_t from, const char key[]) {
+    size_t found = text.find(key, from);
+    return found == std::string::npos ? -1 : atoi(text.c_str() + found + strlen(key));
+}
+
+// Returns the number of the object starting at offset, or -1 if none does.
+static int object_at(const std::string& text, size_t offset) {
+    int number = -1;
+    if (offset >= text.size() || 1 != sscanf(text.c_str() + offset, "%d", &number)) {
+        return -1;
+    }
+    SkString expected = SkStringPrintf("%d 0 obj\n", number);
+    return text.compare(offset, expected.size(), expected.c_str()) == 0 ? number : -1;
+}
+
+static bool ends_object(const std::string& text, size_t offset) {
+    return offset >= strlen("endobj\n") && offset <= text.size() &&
+           text.compare(offset - strlen("endobj\n"), strlen("endobj\n"), "endobj\n") == 0;
+}
+
+DEF_TEST(SkPDF_linearized, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_linearized, r);
+    SkBitmap logo;
+    logo.allocN32Pixels(40, 40, true);
+    for (int y = 0; y < 40; ++y) {
+        for (int x = 0; x < 40; ++x) {
+            *logo.getAddr32(x, y) = SkPackARGB32(0xFF, x * 6, y * 6, 0x80);
+        }
+    }
+    sk_sp<SkImage> logoImage = SkImage::MakeFromBitmap(logo);
+
+    SkPDF::Metadata metadata;
+    metadata.fLinearize = true;
+    SkDynamicMemoryWStream stream;
+    auto doc = SkPDF::MakeDocument(&stream, metadata);
+    SkPaint paint;
+    paint.setTextSize(12);
+    const int kPages = 5;
+    for (int i = 0; i < kPages; ++i) {
+        SkCanvas* canvas = doc->beginPage(612, 792);
+        canvas->drawString(SkStringPrintf("Page %d", i), 20, 20, paint);
+        if (i > 0) {
+            // Shared by every page but the first.
+            canvas->drawImage(logoImage, 500, 20);
+        }
+        paint.setAlpha(0x40 + i);  // A graphic state of its own.
+        canvas->drawRect({100, 100, 200, 200.0f + 10 * i}, paint);
+        paint.setAlpha(0xFF);
+    }
+    doc->close();
+    sk_sp<SkData> data = stream.detachAsData();
+    std::string text(static_cast<const char*>(data->data()), data->size());
+
+    // The linearization dictionary is the first object.
+    size_t linearized = text.find("/Linearized 1");
+    REPORTER_ASSERT(r, linearized != std::string::npos && linearized < 64);
+    int fileLength = find_int(text, linearized, "/L ");
+    int hintOffset = -1, hintLength = -1;
+    sscanf(text.c_str() + text.find("/H [", linearized), "/H [%d %d]", &hintOffset, &hintLength);
+    int firstPageNumber = find_int(text, linearized, "/O ");
+    int firstPageEnd = find_int(text, linearized, "/E ");
+    int pageCount = find_int(text, linearized, "/N ");
+    int mainXRefEntry = find_int(text, linearized, "/T ");
+    REPORTER_ASSERT(r, fileLength == SkToInt(data->size()));
+    REPORTER_ASSERT(r, pageCount == kPages);
+
+    // Both xref sections point at their objects.
+    size_t firstPageXRef = text.find("xref\n", linearized);
+    REPORTER_ASSERT(r, xref_section_is_consistent(text, firstPageXRef));
+    int mainXRef = find_int(text, firstPageXRef, "/Prev ");
+    REPORTER_ASSERT(r, mainXRef > 0 && xref_section_is_consistent(text, mainXRef));
+    REPORTER_ASSERT(r, mainXRefEntry > mainXRef &&
+                       text.compare(mainXRefEntry, 21, "\n0000000000 65535 f \n") == 0);
+    REPORTER_ASSERT(r, SkToSizeT(find_int(text, text.rfind("startxref\n"), "startxref\n")) ==
+                       firstPageXRef);
+
+    // The hint stream, which hint tables pretend is not there.
+    REPORTER_ASSERT(r, object_at(text, hintOffset) == firstPageNumber - 1);
+    REPORTER_ASSERT(r, ends_object(text, hintOffset + hintLength));
+    size_t hintData = text.find(" stream\n", hintOffset) + strlen(" stream\n");
+    int sharedTable = find_int(text, hintOffset, "/S ");
+    auto actual = [&](uint32_t offset) {
+        return offset >= SkToU32(hintOffset) ? offset + hintLength : offset;
+    };
+    HintTableReader reader(data->bytes() + hintData,
+                           hintOffset + hintLength - hintData);
+
+    // The page offset hint table.
+    uint32_t leastObjects = reader.read(32);
+    uint32_t firstPageOffset = reader.read(32);
+    int objectBits = reader.read(16);
+    uint32_t leastLength = reader.read(32);
+    int lengthBits = reader.read(16);
+    uint32_t leastContentOffset = reader.read(32);
+    int contentOffsetBits = reader.read(16);
+    uint32_t leastContentLength = reader.read(32);
+    int contentLengthBits = reader.read(16);
+    int sharedCountBits = reader.read(16);
+    int sharedGroupBits = reader.read(16);
+    int numeratorBits = reader.read(16);
+    reader.read(16);
+    REPORTER_ASSERT(r, numeratorBits == 0);
+    auto objectCounts = read_hint_item(&reader, kPages, leastObjects, objectBits);
+    auto lengths = read_hint_item(&reader, kPages, leastLength, lengthBits);
+    auto sharedCounts = read_hint_item(&reader, kPages, 0, sharedCountBits);
+    // Shared object identifiers are packed across pages, and aligned only after the last one.
+    std::vector<std::vector<uint32_t>> sharedGroups(kPages);
+    for (int i = 0; i < kPages; ++i) {
+        for (uint32_t j = 0; j < sharedCounts[i]; ++j) {
+            sharedGroups[i].push_back(reader.read(sharedGroupBits));
+        }
+    }
+    reader.align();
+    auto contentOffsets = read_hint_item(&reader, kPages, leastContentOffset, contentOffsetBits);
+    auto contentLengths = read_hint_item(&reader, kPages, leastContentLength, contentLengthBits);
+    REPORTER_ASSERT(r, !reader.overran());
+
+    uint32_t pageOffset = firstPageOffset;
+    for (int i = 0; i < kPages; ++i) {
+        size_t start = actual(pageOffset);
+        int pageNumber = object_at(text, start);
+        REPORTER_ASSERT(r, pageNumber > 0);
+        REPORTER_ASSERT(r, i > 0 || pageNumber == firstPageNumber);
+        REPORTER_ASSERT(r, text.compare(start + SkStringPrintf("%d 0 obj\n", pageNumber).size(),
+                                        strlen("<</Type /Page\n"), "<</Type /Page\n") == 0);
+        size_t end = start + lengths[i];
+        REPORTER_ASSERT(r, ends_object(text, end));
+        REPORTER_ASSERT(r, i > 0 || end == SkToSizeT(firstPageEnd));
+        REPORTER_ASSERT(r, i == 0 || sharedCounts[i] > 0);
+        REPORTER_ASSERT(r, i > 0 || sharedCounts[i] == 0);
+        uint32_t objects = 0;
+        for (size_t obj = text.find(" 0 obj\n", start); obj < end;
+                    obj = text.find(" 0 obj\n", obj + 1)) {
+            ++objects;
+        }
+        REPORTER_ASSERT(r, objects == objectCounts[i]);
+        int contents = find_int(text, start, "/Contents ");
+        REPORTER_ASSERT(r, object_at(text, start + contentOffsets[i]) == contents);
+        REPORTER_ASSERT(r, ends_object(text, start + contentOffsets[i] + contentLengths[i]));
+        pageOffset += lengths[i];
+    }
+
+    // The shared object hint table.
+    reader.seek(sharedTable);
+    uint32_t firstSharedNumber = reader.read(32);
+    uint32_t firstSharedOffset = reader.read(32);
+    uint32_t firstPageGroups = reader.read(32);
+    uint32_t groupCount = reader.read(32);
+    int groupObjectBits = reader.read(16);
+    uint32_t leastGroupLength = reader.read(32);
+    int groupLengthBits = reader.read(16);
+    auto groupLengths = read_hint_item(&reader, groupCount, leastGroupLength, groupLengthBits);
+    REPORTER_ASSERT(r, !reader.overran());
+    REPORTER_ASSERT(r, groupObjectBits == 0);
+    REPORTER_ASSERT(r, firstPageGroups == objectCounts[0]);
+    REPORTER_ASSERT(r, groupCount > firstPageGroups);
+    REPORTER_ASSERT(r, object_at(text, actual(firstSharedOffset)) == SkToInt(firstSharedNumber));
+    uint32_t groupOffset = firstPageOffset;
+    for (uint32_t i = 0; i < groupCount; ++i) {
+        if (i == firstPageGroups) {
+            REPORTER_ASSERT(r, actual(groupOffset) == SkToU32(firstPageEnd));
+            groupOffset = firstSharedOffset;
+        }
+        REPORTER_ASSERT(r, object_at(text, actual(groupOffset)) > 0);
+        REPORTER_ASSERT(r, ends_object(text, actual(groupOffset) + groupLengths[i]));
+        groupOffset += groupLengths[i];
+    }
+    for (const std::vector<uint32_t>& groups : sharedGroups) {
+        for (uint32_t group : groups) {
+            REPORTER_ASSERT(r, group < groupCount);
+        }
+    }
+}
+
+static sk_sp<SkData> make_invoice(sk_sp<SkTypeface> typeface, const char* customer,
+                                  sk_sp<SkPDF::FontCache> fontCache) {
+    SkPDF::Metadata metadata;
+    metadata.fFontCache = std::move(fontCache);
+    SkDynamicMemoryWStream stream;
+    auto doc = SkPDF::MakeDocument(&stream, metadata);
+    SkCanvas* canvas = doc->beginPage(612, 792);
+    SkPaint paint;
+    paint.setTypeface(std::move(typeface));
+    paint.setTextSize(14);
+    canvas->drawString("INVOICE", 72, 72, paint);
+    canvas->drawString(customer, 72, 100, paint);
+    canvas->drawString("Total due: 1,234.56", 72, 128, paint);
+    doc->close();
+    return stream.detachAsData();
+}
+
+// A shared font cache only saves work; the documents must not change.
+DEF_TEST(SkPDF_font_cache, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_font_cache, r);
+    sk_sp<SkTypeface> typeface = MakeResourceAsTypeface("fonts/Roboto-Regular.ttf");
+    if (!typeface) {
+        INFOF(r, "Could not load fonts/Roboto-Regular.ttf; skipping test.");
+        return;
+    }
+    const char* customers[] = { "Jane Doe", "ACME Widgets", "Jane Doe" };
+    sk_sp<SkData> expected[SK_ARRAY_COUNT(customers)];
+    for (size_t i = 0; i < SK_ARRAY_COUNT(customers); ++i) {
+        expected[i] = make_invoice(typeface, customers[i], nullptr);
+    }
+    REPORTER_ASSERT(r, count_occurrences(expected[0].get(), "/ToUnicode") == 1);
+    REPORTER_ASSERT(r, count_occurrences(expected[0].get(), "/W [") == 1);
+
+    // The third invoice uses the same glyphs as the first, and so finds them in the cache.
+    sk_sp<SkPDF::FontCache> fontCache = SkPDF::FontCache::Make();
+    for (size_t i = 0; i < SK_ARRAY_COUNT(customers); ++i) {
+        sk_sp<SkData> actual = make_invoice(typeface, customers[i], fontCache);
+        REPORTER_ASSERT(r, expected[i]->equals(actual.get()));
+    }
+
+    // A cache with no room for typeface data keeps dropping it.
+    fontCache = SkPDF::FontCache::Make(256, 0);
+    for (size_t i = 0; i < SK_ARRAY_COUNT(customers); ++i) {
+        sk_sp<SkData> actual = make_invoice(typeface, customers[i], fontCache);
+        REPORTER_ASSERT(r, expected[i]->equals(actual.get()));
+    }
+
+    // Documents on several threads may share one cache.  A cache that only keeps
+    // one glyph set keeps evicting it.
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (int subsetCount : { 1, 256 }) {
+        fontCache = SkPDF::FontCache::Make(subsetCount);
+        const int kDocuments = 12;
+        sk_sp<SkData> actual[kDocuments];
+        SkTaskGroup(*executor).batch(kDocuments, [&](int i) {
+            actual[i] = make_invoice(typeface, customers[i % SK_ARRAY_COUNT(customers)], fontCache);
+        });
+        for (int i = 0; i < kDocuments; ++i) {
+            REPORTER_ASSERT(r, expected[i % SK_ARRAY_COUNT(customers)]->equals(actual[i].get()));
+        }
+    }
+}
+
+#ifdef SK_SUPPORT_PDF
+// Typefaces are never seen again once deleted, so their data must not pile up.
+DEF_TEST(SkPDF_font_cache_budget, r) {
+    const size_t kProgramSize = 1000;
+    SkPDFFontCache cache(1, 3 * kProgramSize);
+    for (SkFontID id = 1; id <= 10; ++id) {
+        cache.addFontProgram(id, SkData::MakeUninitialized(kProgramSize));
+    }
+    sk_sp<SkData> program;
+    int kept = 0;
+    for (SkFontID id = 1; id <= 10; ++id) {
+        kept += cache.findFontProgram(id, &program);
+    }
+    REPORTER_ASSERT(r, kept == 2);
+    REPORTER_ASSERT(r, cache.findFontProgram(10, &program) && program->size() == kProgramSize);
+    REPORTER_ASSERT(r, cache.findFontProgram(9, &program));
+
+    // Finding a typeface makes it the last one dropped.
+    cache.addFontProgram(11, SkData::MakeUninitialized(kProgramSize));
+    REPORTER_ASSERT(r, cache.findFontProgram(9, &program));
+    REPORTER_ASSERT(r, !cache.findFontProgram(10, &program));
+}
+#endif
+
+// Returns the decompressed data of the largest FlateDecode stream in the pdf.
+static std::string largest_inflated_stream(const SkData* pdf) {
+    std::string text(static_cast<const char*>(pdf->data()), pdf->size());
+    std::string largest;
+    for (size_t pos = text.find(" stream\n"); pos != std::string::npos;
+         pos = text.find(" stream\n", pos + 1)) {
+        size_t dictStart = text.rfind("<<", pos);
+        std::string dict = text.substr(dictStart, pos - dictStart);
+        size_t length = dict.find("/Length ");
+        if (dict.find("/FlateDecode") == std::string::npos || length == std::string::npos) {
+            continue;
+        }
+        uLong srcLen = std::stoul(dict.substr(length + strlen("/Length ")));
+        uLongf dstLen = 64 * srcLen + 1024;
+        std::string inflated(dstLen, '\0');
+        if (uncompress(reinterpret_cast<Bytef*>(&inflated[0]), &dstLen,
+                       reinterpret_cast<const Bytef*>(text.data() + pos + strlen(" stream\n")),
+                       srcLen) == Z_OK && dstLen > largest.size()) {
+            largest = inflated.substr(0, dstLen);
+        }
+    }
+    return largest;
+}
+
+DEF_TEST(SkPDF_page_content_chunks, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_page_content_chunks, r);
+    auto draw = [](SkCanvas* canvas) {
+        SkRandom random;
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        for (int i = 0; i < 500; ++i) {
+            SkPath path;
+            path.moveTo(random.nextRangeF(0, 612), random.nextRangeF(0, 792));
+            path.quadTo(random.nextRangeF(0, 612), random.nextRangeF(0, 792),
+                        random.nextRangeF(0, 612), random.nextRangeF(0, 792));
+            paint.setColor(random.nextU() | 0xFF000000);
+            paint.setStyle(i % 2 ? SkPaint::kStroke_Style : SkPaint::kFill_Style);
+            canvas->drawPath(path, paint);
+        }
+    };
+    auto make_pdf = [&](size_t chunkSize, bool dstOver) {
+        SkPDF::Metadata metadata;
+        metadata.fPageContentChunkSize = chunkSize;
+        SkDynamicMemoryWStream stream;
+        auto doc = SkPDF::MakeDocument(&stream, metadata);
+        SkCanvas* canvas = doc->beginPage(612, 792);
+        draw(canvas);
+        if (dstOver) {
+            SkPaint paint;
+            paint.setBlendMode(SkBlendMode::kDstOver);
+            canvas->drawRect({100, 100, 200, 200}, paint);
+        }
+        doc->close();
+        return stream.detachAsData();
+    };
+
+    // Deflating as the page is drawn only adds a save and restore around the content.
+    sk_sp<SkData> whole = make_pdf(0, false);
+    sk_sp<SkData> chunked = make_pdf(1024, false);
+    REPORTER_ASSERT(r, xref_is_consistent(chunked.get()));
+    std::string wholeContent = largest_inflated_stream(whole.get());
+    std::string chunkedContent = largest_inflated_stream(chunked.get());
+    const std::string transform = "1 0 0 -1 0 792 cm\n";
+    REPORTER_ASSERT(r, wholeContent.size() > 10000);
+    REPORTER_ASSERT(r, wholeContent.compare(0, transform.size(), transform) == 0);
+    REPORTER_ASSERT(r, chunkedContent ==
+                       transform + "q\n" + wholeContent.substr(transform.size()) + "Q\n");
+
+    // Drawing under deflated content turns that content into a form xobject.
+    sk_sp<SkData> dstOver = make_pdf(1024, true);
+    sk_sp<SkData> dstOverWhole = make_pdf(0, true);
+    REPORTER_ASSERT(r, xref_is_consistent(dstOver.get()));
+    REPORTER_ASSERT(r, contains(dstOver->bytes(), dstOver->size(), "/Subtype /Form"));
+    REPORTER_ASSERT(r, !contains(dstOverWhole->bytes(), dstOverWhole->size(), "/Subtype /Form"));
+}
@@ -14,6 +14,7 @@
 #include "SkClipOpPriv.h"
 #include "SkColor.h"
 #include "SkData.h"
+#include "SkExecutor.h"
 #include "SkFontStyle.h"
 #include "SkImageInfo.h"
 #include "SkMatrix.h"
@@ -873,3 +874,55 @@ DEF_TEST(Picture_empty_serial, reporter) {
     REPORTER_ASSERT(reporter, pic2);
 }
 
+
+DEF_TEST(Picture_tiledPlayback, r) {
+    // Rects on a grid of 4, scaled by 3/4 below, land on whole pixels both when drawn whole and
+    // in tiles, so without filters tiled playback must match exactly. Translucent colors check
+    // that overlapping draws still blend in order.
+    SkRTreeFactory factory;
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(200, 152), &factory);
+    SkRandom rand;
+    for (int i = 0; i < 200; i++) {
+        SkPaint paint;
+        paint.setColor(rand.nextU() | (i % 4 == 0 ? 0x80000000 : 0xFF000000));
+        paint.setAntiAlias(i % 2 == 0);
+        int x = 4 * (int)rand.nextRangeU(0, 52) - 8,
+            y = 4 * (int)rand.nextRangeU(0, 40) - 8,
+            w = 4 * (int)rand.nextRangeU(1, 10),
+            h = 4 * (int)rand.nextRangeU(1, 10);
+        canvas->drawRect(SkRect::Make(SkIRect::MakeXYWH(x, y, w, h)), paint);
+    }
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(150, 114);
+    const SkMatrix matrix = SkMatrix::MakeScale(0.75f, 0.75f);
+
+    SkBitmap expected;
+    expected.allocPixels(info);
+    expected.eraseColor(SK_ColorWHITE);
+    {
+        SkCanvas canvas(expected);
+        canvas.concat(matrix);
+        picture->playback(&canvas);
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (int tiles : { 1, 3, 7 }) {
+        SkBitmap actual;
+        actual.allocPixels(info);
+        actual.eraseColor(SK_ColorWHITE);
+        REPORTER_ASSERT(r, picture->playback(actual.pixmap(), &matrix, executor.get(),
+                                             tiles, tiles));
+
+        for (int y = 0; y < info.height(); y++) {
+            if (memcmp(expected.getAddr32(0, y), actual.getAddr32(0, y), info.minRowBytes())) {
+                ERRORF(r, "tiles = %d: row %d differs from untiled playback", tiles, y);
+                break;
+            }
+        }
+    }
+
+    // An empty destination can't be drawn into.
+    REPORTER_ASSERT(r, !picture->playback(SkPixmap(), nullptr, nullptr, 2, 2));
+}
@@ -13,13 +13,17 @@
         }                                                          \
     } while (0)
 
+#include "SkBase64.h"
 #include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkColorFilter.h"
 #include "SkData.h"
 #include "SkImage.h"
+#include "SkImageEncoder.h"
 #include "SkImageShader.h"
 #include "SkParse.h"
+#include "SkParsePath.h"
+#include "SkPath.h"
 #include "SkShader.h"
 #include "SkStream.h"
 #include "SkTo.h"
@@ -382,4 +386,71 @@ DEF_TEST(SVGDevice_ColorFilters, reporter) {
     REPORTER_ASSERT(reporter, strcmp(dom.findAttr(compositeElement, "operator"), "in") == 0);
 }
 
+
+DEF_TEST(SVGDevice_repeated_images, reporter) {
+    SkBitmap bm;
+    bm.allocN32Pixels(128, 128);  // Large enough for the data uri to be written in pieces.
+    for (int y = 0; y < bm.height(); ++y) {
+        for (int x = 0; x < bm.width(); ++x) {
+            *bm.getAddr32(x, y) = SkPreMultiplyColor(SkColorSetARGB(0xFF, x * y, x ^ y, x + y));
+        }
+    }
+    SkPath path;
+    path.moveTo(1, 2);
+    path.quadTo(30, 40, 50, 60);
+    path.close();
+
+    SkDynamicMemoryWStream stream;
+    {
+        SkXMLStreamWriter writer(&stream);
+        std::unique_ptr<SkCanvas> svgCanvas = SkSVGCanvas::Make(SkRect::MakeWH(300, 300), &writer);
+        svgCanvas->drawBitmap(bm, 0, 0);
+        svgCanvas->drawPath(path, SkPaint());
+        svgCanvas->drawBitmap(bm, 150, 150);
+    }
+    std::unique_ptr<SkStreamAsset> svg(stream.detachAsStream());
+
+    SkDOM dom;
+    const SkDOM::Node* root = dom.build(*svg);
+    ABORT_TEST(reporter, !root, "svg did not parse");
+
+    // The pixels are written once, and used by both draws.
+    int imageCount = 0, useCount = 0;
+    const SkDOM::Node* image = nullptr;
+    for (const SkDOM::Node* defs = dom.getFirstChild(root, "defs"); defs;
+         defs = dom.getNextSibling(defs, "defs")) {
+        for (const SkDOM::Node* node = dom.getFirstChild(defs, "image"); node;
+             node = dom.getNextSibling(node, "image")) {
+            image = node;
+            ++imageCount;
+        }
+    }
+    for (const SkDOM::Node* node = dom.getFirstChild(root, "use"); node;
+         node = dom.getNextSibling(node, "use")) {
+        REPORTER_ASSERT(reporter, image && !strcmp(dom.findAttr(node, "xlink:href"),
+                                   SkStringPrintf("#%s", dom.findAttr(image, "id")).c_str()));
+        ++useCount;
+    }
+    REPORTER_ASSERT(reporter, imageCount == 1);
+    REPORTER_ASSERT(reporter, useCount == 2);
+    ABORT_TEST(reporter, !image, "image element not found");
+
+    // The data uri written a piece at a time matches the one written whole.
+    SkDynamicMemoryWStream png;
+    REPORTER_ASSERT(reporter, SkEncodeImage(&png, bm, SkEncodedImageFormat::kPNG, 80));
+    sk_sp<SkData> pngData = png.detachAsData();
+    SkString dataUri("data:image/png;base64,");
+    size_t b64Size = SkBase64::Encode(pngData->data(), pngData->size(), nullptr);
+    SkAutoTMalloc<char> b64(b64Size);
+    SkBase64::Encode(pngData->data(), pngData->size(), b64.get());
+    dataUri.append(b64.get(), b64Size);
+    REPORTER_ASSERT(reporter, dataUri.equals(dom.findAttr(image, "xlink:href")));
+
+    const SkDOM::Node* pathElement = dom.getFirstChild(root, "path");
+    ABORT_TEST(reporter, !pathElement, "path element not found");
+    SkString pathData;
+    SkParsePath::ToSVGString(path, &pathData);
+    REPORTER_ASSERT(reporter, pathData.equals(dom.findAttr(pathElement, "d")));
+}
+
 #endif
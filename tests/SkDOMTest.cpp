@@ -83,4 +83,104 @@ DEF_TEST(SkDOM_test, r) {
     }
 }
 
+
+namespace {
+
+// Reads a few bytes at a time, with no memory base, so the parser has to copy it in pieces.
+class TrickleStream final : public SkStream {
+public:
+    TrickleStream(const char* data, size_t size) : fData(data), fSize(size) {}
+
+    size_t read(void* buffer, size_t size) override {
+        size = SkTMin(SkTMin(size, fSize - fOffset), (size_t)3);
+        if (buffer) {
+            memcpy(buffer, fData + fOffset, size);
+        }
+        fOffset += size;
+        return size;
+    }
+    bool isAtEnd() const override { return fOffset == fSize; }
+
+private:
+    const char* fData;
+    size_t      fSize;
+    size_t      fOffset = 0;
+};
+
+void check_same(skiatest::Reporter* r, const SkDOM& a, const SkDOM::Node* nodeA,
+                const SkDOM& b, const SkDOM::Node* nodeB) {
+    REPORTER_ASSERT(r, !strcmp(a.getName(nodeA), b.getName(nodeB)));
+    REPORTER_ASSERT(r, a.getType(nodeA) == b.getType(nodeB));
+
+    SkDOM::AttrIter iterA(a, nodeA), iterB(b, nodeB);
+    const char *nameA, *valueA, *nameB, *valueB;
+    do {
+        nameA = iterA.next(&valueA);
+        nameB = iterB.next(&valueB);
+        REPORTER_ASSERT(r, !nameA == !nameB);
+        if (nameA && nameB) {
+            REPORTER_ASSERT(r, !strcmp(nameA, nameB) && !strcmp(valueA, valueB));
+        }
+    } while (nameA && nameB);
+
+    const SkDOM::Node* childA = a.getFirstChild(nodeA);
+    const SkDOM::Node* childB = b.getFirstChild(nodeB);
+    for (; childA && childB; childA = a.getNextSibling(childA), childB = b.getNextSibling(childB)) {
+        check_same(r, a, childA, b, childB);
+    }
+    REPORTER_ASSERT(r, !childA && !childB);
+}
+
+}  // namespace
+
+DEF_TEST(SkDOM_memory_stream, r) {
+    static const char gDoc[] =
+        "<?xml version='1.0'?>"
+        "<svg width='10' height='20'>"
+            "<g fill='red'>"
+                "<rect x='1' y='2' fill='blue'/>"
+                "<rect x='3' y='4' title='a &amp; b'>text &lt;1&gt;</rect>"
+            "</g>"
+        "</svg>"
+        ;
+
+    SkDOM copied;
+    TrickleStream trickle(gDoc, sizeof(gDoc) - 1);
+    const SkDOM::Node* copiedRoot = copied.build(trickle);
+    REPORTER_ASSERT(r, copiedRoot);
+
+    // A memory stream is parsed in place, starting from its current position.
+    SkString padded("padding");
+    padded.append(gDoc);
+    SkMemoryStream inPlaceStream(padded.c_str(), padded.size());
+    REPORTER_ASSERT(r, inPlaceStream.skip(strlen("padding")) == strlen("padding"));
+    SkDOM inPlace;
+    const SkDOM::Node* inPlaceRoot = inPlace.build(inPlaceStream);
+    REPORTER_ASSERT(r, inPlaceRoot);
+    REPORTER_ASSERT(r, inPlaceStream.isAtEnd());
+    if (!copiedRoot || !inPlaceRoot) {
+        return;
+    }
+    check_same(r, copied, copiedRoot, inPlace, inPlaceRoot);
+
+    // Repeated element and attribute names share one copy.
+    const SkDOM::Node* g = inPlace.getFirstChild(inPlaceRoot, "g");
+    REPORTER_ASSERT(r, g);
+    if (g) {
+        const SkDOM::Node* rect1 = inPlace.getFirstChild(g, "rect");
+        const SkDOM::Node* rect2 = rect1 ? inPlace.getNextSibling(rect1, "rect") : nullptr;
+        REPORTER_ASSERT(r, rect1 && rect2);
+        if (rect1 && rect2) {
+            REPORTER_ASSERT(r, inPlace.getName(rect1) == inPlace.getName(rect2));
+            const SkDOM::Attr* x1 = inPlace.getFirstAttr(rect1);
+            const SkDOM::Attr* x2 = inPlace.getFirstAttr(rect2);
+            REPORTER_ASSERT(r, inPlace.getAttrName(rect1, x1) == inPlace.getAttrName(rect2, x2));
+            REPORTER_ASSERT(r, inPlace.getAttrName(g, inPlace.getFirstAttr(g)) ==
+                               inPlace.getAttrName(rect1, inPlace.getNextAttr(rect1,
+                                   inPlace.getNextAttr(rect1, x1))));
+            REPORTER_ASSERT(r, !strcmp(inPlace.findAttr(rect2, "title"), "a & b"));
+        }
+    }
+}
+
 #endif // SK_XML
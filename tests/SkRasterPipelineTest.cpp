@@ -186,6 +186,35 @@ DEF_TEST(SkRasterPipeline_lowp, r) {
     }
 }
 
+DEF_TEST(SkRasterPipeline_lowp_tail, r) {
+    // Every width up to 64 pixels, so that lowp runs every tail length of every stride.
+    for (int width = 1; width <= 64; width++) {
+        uint32_t rgba[64];
+        for (int i = 0; i < 64; i++) {
+            rgba[i] = 0x03020100 + 0x04040404 * (uint32_t)i;
+        }
+
+        SkRasterPipeline_MemoryCtx ptr = { rgba, 0 };
+
+        SkRasterPipeline_<256> p;
+        p.append(SkRasterPipeline::load_8888,  &ptr);
+        p.append(SkRasterPipeline::swap_rb);
+        p.append(SkRasterPipeline::store_8888, &ptr);
+        p.run(0,0,width,1);
+
+        for (int i = 0; i < 64; i++) {
+            uint32_t orig = 0x03020100 + 0x04040404 * (uint32_t)i,
+                     want = i < width ? (orig & 0xff00ff00)
+                                      | (orig & 0x00ff0000) >> 16
+                                      | (orig & 0x000000ff) << 16
+                                      : orig;
+            if (rgba[i] != want) {
+                ERRORF(r, "width %d: got %08x, want %08x at %d\n", width, rgba[i], want, i);
+            }
+        }
+    }
+}
+
 DEF_TEST(SkRasterPipeline_lowp_clamp01, r) {
     // This may seem like a funny pipeline to create,
     // but it certainly shouldn't crash when you run it.
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Test.h"
+
+#if defined(SK_XML)
+
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkSVGContainer.h"
+#include "SkSVGDOM.h"
+#include "SkSVGRect.h"
+#include "SkSVGSVG.h"
+
+static SkColor render_pixel(const SkSVGDOM& dom, SkScalar dx, int x, int y) {
+    SkBitmap bm;
+    bm.allocN32Pixels(40, 20);
+    bm.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(bm);
+    canvas.translate(dx, 0);
+    dom.render(&canvas);
+    return bm.getColor(x, y);
+}
+
+// A group that counts how many times the tree below it is walked.
+class CountingG final : public SkSVGContainer {
+public:
+    static sk_sp<CountingG> Make() { return sk_sp<CountingG>(new CountingG()); }
+
+    int renderCount() const { return fRenderCount; }
+
+protected:
+    void onRender(const SkSVGRenderContext& ctx) const override {
+        fRenderCount++;
+        INHERITED::onRender(ctx);
+    }
+
+private:
+    CountingG() : INHERITED(SkSVGTag::kG) {}
+
+    mutable int fRenderCount = 0;
+
+    typedef SkSVGContainer INHERITED;
+};
+
+// SkSVGDOM replays a recording of the tree until a node or the container size changes.
+DEF_TEST(SkSVGDOM_render_cache, r) {
+    auto root = SkSVGSVG::Make();
+    auto group = CountingG::Make();
+    auto rect = SkSVGRect::Make();
+    rect->setWidth(SkSVGLength(50, SkSVGLength::Unit::kPercentage));
+    rect->setHeight(SkSVGLength(10));
+    rect->setFill(SkSVGPaint(SkSVGColorType(SK_ColorRED)));
+    group->appendChild(rect);
+    root->appendChild(group);
+
+    auto dom = sk_make_sp<SkSVGDOM>();
+    dom->setRoot(root);
+    dom->setContainerSize(SkSize::Make(20, 20));
+
+    REPORTER_ASSERT(r, render_pixel(*dom, 0,  5, 5) == SK_ColorRED);
+    REPORTER_ASSERT(r, render_pixel(*dom, 0, 15, 5) == SK_ColorTRANSPARENT);
+
+    // Replaying under another matrix, without walking the tree again.
+    REPORTER_ASSERT(r, render_pixel(*dom, 10, 15, 5) == SK_ColorRED);
+    REPORTER_ASSERT(r, render_pixel(*dom, 10,  5, 5) == SK_ColorTRANSPARENT);
+    REPORTER_ASSERT(r, group->renderCount() == 1);
+
+    // Lengths are relative to the container.
+    dom->setContainerSize(SkSize::Make(40, 20));
+    REPORTER_ASSERT(r, render_pixel(*dom, 0, 15, 5) == SK_ColorRED);
+    REPORTER_ASSERT(r, group->renderCount() == 2);
+
+    // Setting an attribute of a node below the root.
+    rect->setFill(SkSVGPaint(SkSVGColorType(SK_ColorBLUE)));
+    REPORTER_ASSERT(r, render_pixel(*dom, 0, 15, 5) == SK_ColorBLUE);
+    REPORTER_ASSERT(r, render_pixel(*dom, 0, 15, 5) == SK_ColorBLUE);
+    REPORTER_ASSERT(r, group->renderCount() == 3);
+    rect->setHeight(SkSVGLength(5));
+    REPORTER_ASSERT(r, render_pixel(*dom, 0, 15, 7) == SK_ColorTRANSPARENT);
+
+    // Adding a node.
+    auto rect2 = SkSVGRect::Make();
+    rect2->setY(SkSVGLength(10));
+    rect2->setWidth(SkSVGLength(10));
+    rect2->setHeight(SkSVGLength(10));
+    group->appendChild(rect2);
+    REPORTER_ASSERT(r, render_pixel(*dom, 0, 5, 15) == SK_ColorBLACK);
+
+    // Replacing the root.
+    dom->setRoot(SkSVGSVG::Make());
+    REPORTER_ASSERT(r, render_pixel(*dom, 0, 5, 15) == SK_ColorTRANSPARENT);
+}
+
+#endif  // SK_XML
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkDescriptor.h"
+#include "SkGlyphCache.h"
+#include "SkPaint.h"
+#include "SkSemaphore.h"
+#include "SkStrikeCache.h"
+#include "SkTaskGroup.h"
+#include "Test.h"
+#include "sk_tool_utils.h"
+
+#include <thread>
+
+static SkPaint make_paint(SkScalar textSize) {
+    SkPaint paint;
+    paint.setTypeface(sk_tool_utils::create_portable_typeface("serif", SkFontStyle()));
+    paint.setTextSize(textSize);
+    return paint;
+}
+
+DEF_TEST(SkStrikeCache_ThreadCache, r) {
+    // An odd size, so no other test is likely to share this strike.
+    SkPaint paint = make_paint(37.25f);
+
+    std::unique_ptr<SkDescriptor> desc;
+    {
+        auto strike = SkStrikeCache::FindOrCreateStrikeExclusive(paint);
+        REPORTER_ASSERT(r, strike);
+        desc = strike->getDescriptor().copy();
+    }
+
+    // A strike we just released should be found again, from this thread's front cache.
+    {
+        auto strike = SkStrikeCache::FindStrikeExclusive(*desc);
+        REPORTER_ASSERT(r, strike);
+    }
+
+    // PurgeAll() must reach strikes held in front caches too.
+    SkStrikeCache::PurgeAll();
+    REPORTER_ASSERT(r, !SkStrikeCache::FindStrikeExclusive(*desc));
+}
+
+DEF_TEST(SkStrikeCache_OtherThreadCache, r) {
+    SkPaint paint = make_paint(41.75f);
+    std::unique_ptr<SkDescriptor> desc;
+    SkSemaphore released, purged, checked;
+    bool purgedOnWorker = false;
+
+    // The worker leaves a strike in its front cache and stays alive while we look for it.
+    std::thread worker([&] {
+        {
+            auto strike = SkStrikeCache::FindOrCreateStrikeExclusive(paint);
+            desc = strike->getDescriptor().copy();
+        }
+        released.signal();
+        purged.wait();
+
+        // PurgeAll() on another thread must already have dropped it.
+        purgedOnWorker = !SkStrikeCache::FindStrikeExclusive(*desc);
+
+        SkStrikeCache::FindOrCreateStrikeExclusive(paint);
+        checked.signal();
+    });
+
+    released.wait();
+    SkStrikeCache::PurgeAll();
+    purged.signal();
+
+    // A strike in another thread's front cache is found rather than built again.
+    checked.wait();
+    REPORTER_ASSERT(r, purgedOnWorker);
+    REPORTER_ASSERT(r, SkStrikeCache::FindStrikeExclusive(*desc));
+    worker.join();
+}
+
+DEF_TEST(SkStrikeCache_ThreadCacheThreaded, r) {
+    // Many threads sharing a handful of strikes; each must always get a strike that matches.
+    static const int kThreads = 8;
+    std::atomic<int> wrong{0};
+
+    SkTaskGroup().batch(kThreads, [&](int thread) {
+        for (int i = 0; i < 200; i++) {
+            SkPaint paint = make_paint(10.5f + (thread + i) % 6);
+            auto strike = SkStrikeCache::FindOrCreateStrikeExclusive(paint);
+            if (!strike ||
+                strike->getScalerContext()->getRec().fTextSize != paint.getTextSize()) {
+                wrong++;
+            }
+        }
+    });
+
+    REPORTER_ASSERT(r, wrong == 0);
+    SkStrikeCache::ValidateGlyphCacheDataSize();
+}
@@ -148,3 +148,25 @@ DEF_TEST(StreamBuffer, r) {
     // Now go back to the data we skipped.
     test_get_data_at_position(r, &buffer, 14, 13);
 }
+
+// A stream in memory is read in place, rather than copied.
+DEF_TEST(StreamBuffer_memory, r) {
+    const size_t size = strlen(gText);
+    SkStreamBuffer buffer(skstd::make_unique<SkMemoryStream>(gText, size, false));
+
+    REPORTER_ASSERT(r, buffer.buffer(5));
+    REPORTER_ASSERT(r, buffer.get() == gText);
+    const size_t position = buffer.markPosition();
+    buffer.flush();
+
+    REPORTER_ASSERT(r, buffer.buffer(7));
+    REPORTER_ASSERT(r, buffer.get() == gText + 5);
+    buffer.flush();
+
+    // Reading to the end only buffers what is there.
+    REPORTER_ASSERT(r, !buffer.buffer(size));
+    REPORTER_ASSERT(r, buffer.get() == gText + 12);
+
+    sk_sp<SkData> data = buffer.getDataAtPosition(position, 5);
+    REPORTER_ASSERT(r, data && data->data() == gText);
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkExecutor.h"
+#include "SkPath.h"
+#include "SkRandom.h"
+#include "SkThreadedBMPDevice.h"
+#include "Test.h"
+
+static void draw_scene(SkCanvas* canvas, bool antiAlias) {
+    SkRandom rand;
+    SkPaint paint;
+    paint.setAntiAlias(antiAlias);
+
+    canvas->clear(SK_ColorWHITE);
+    for (int i = 0; i < 40; ++i) {
+        paint.setColor(rand.nextU() | 0xFF000000);
+        SkPath path;
+        path.moveTo(rand.nextRangeF(0, 256), rand.nextRangeF(0, 256));
+        for (int j = 0; j < 6; ++j) {
+            path.quadTo(rand.nextRangeF(0, 256), rand.nextRangeF(0, 256),
+                        rand.nextRangeF(0, 256), rand.nextRangeF(0, 256));
+        }
+        path.setFillType(i % 5 == 0 ? SkPath::kInverseEvenOdd_FillType
+                                    : SkPath::kWinding_FillType);
+        canvas->save();
+        if (i % 3 == 0) {
+            canvas->clipRect(SkRect::MakeXYWH(20, 30, 180, 150), true);
+        }
+        canvas->drawPath(path, paint);
+        canvas->restore();
+
+        paint.setColor(rand.nextU());
+        canvas->drawRect(SkRect::MakeXYWH(rand.nextRangeF(0, 256), rand.nextRangeF(0, 256),
+                                          rand.nextRangeF(2, 40), rand.nextRangeF(2, 40)), paint);
+        canvas->drawRRect(SkRRect::MakeRectXY(SkRect::MakeXYWH(rand.nextRangeF(0, 256),
+                                                                rand.nextRangeF(0, 256), 30, 20),
+                                              5, 5), paint);
+    }
+}
+
+// Anti-aliased rects are scan converted per tile, and their partial rows may round differently
+// when split by a clip edge, so allow each channel to be off by one.
+static bool rows_match(const uint32_t* expected, const uint32_t* actual, int width) {
+    for (int x = 0; x < width; ++x) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            int e = (expected[x] >> shift) & 0xFF,
+                a = (actual[x]   >> shift) & 0xFF;
+            if (SkTAbs(e - a) > 1) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void check_tiles(skiatest::Reporter* reporter, const SkBitmap& expected, bool antiAlias,
+                        const char* reference) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (int tiles : { 1, 2, 3, 8 }) {
+        SkBitmap actual;
+        actual.allocPixels(expected.info());
+        {
+            SkCanvas canvas(sk_make_sp<SkThreadedBMPDevice>(actual, tiles, 0, executor.get()));
+            draw_scene(&canvas, antiAlias);
+        }
+
+        for (int y = 0; y < expected.height(); ++y) {
+            if (!rows_match(expected.getAddr32(0, y), actual.getAddr32(0, y), expected.width())) {
+                ERRORF(reporter, "tiles = %d, antiAlias = %d: row %d differs from %s",
+                       tiles, antiAlias, y, reference);
+                break;
+            }
+        }
+    }
+}
+
+DEF_TEST(ThreadedBMPDevice, reporter) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(256, 256);
+
+    // Without anti-aliasing, the threaded device draws everything just as SkBitmapDevice does.
+    SkBitmap expected;
+    expected.allocPixels(info);
+    {
+        SkCanvas canvas(expected);
+        draw_scene(&canvas, false);
+    }
+    check_tiles(reporter, expected, false, "SkBitmapDevice");
+
+    // With it, the threaded device always uses DAA for the paths it precomputes coverage for,
+    // where SkBitmapDevice may choose another AA algorithm, so compare against one tile drawn
+    // on one thread instead.  (Forcing DAA with gSkForceDeltaAA would change the output of
+    // every other test running at the same time.)
+    {
+        SkCanvas canvas(sk_make_sp<SkThreadedBMPDevice>(expected, 1, 1));
+        draw_scene(&canvas, true);
+    }
+    check_tiles(reporter, expected, true, "one tile on one thread");
+}
@@ -8,6 +8,7 @@
 #include "Resources.h"
 #include "SkAutoMalloc.h"
 #include "SkCodec.h"
+#include "SkRect.h"
 #include "SkStream.h"
 #include "SkTemplates.h"
 #include "SkYUVSizeInfo.h"
@@ -124,3 +125,127 @@ DEF_TEST(Jpeg_YUV_Codec, r) {
     // A PNG should fail.
     codec_yuv(r, "images/arrow.png", nullptr);
 }
+
+struct YUVPlanes {
+    SkYUVSizeInfo fInfo;
+    SkAutoMalloc  fStorage;
+    void*         fPlanes[SkYUVSizeInfo::kMaxCount];
+
+    const uint8_t* row(int plane, int y) const {
+        return SkTAddOffset<const uint8_t>(fPlanes[plane], y * fInfo.fWidthBytes[plane]);
+    }
+};
+
+static bool decode_yuv(SkCodec* codec, const SkYUVDecodeOptions& options, YUVPlanes* planes) {
+    if (!codec->queryYUV8(&planes->fInfo, nullptr, &options)) {
+        return false;
+    }
+    planes->fStorage.reset(planes->fInfo.computeTotalBytes());
+    planes->fInfo.computePlanes(planes->fStorage.get(), planes->fPlanes);
+    return SkCodec::kSuccess == codec->getYUV8Planes(planes->fInfo, planes->fPlanes, &options);
+}
+
+// Scaled planes are close to a box filtered full size decode, and subsets of the planes are the
+// same as the matching parts of the whole planes.
+static void codec_yuv_scaled_subset(skiatest::Reporter* r, const char path[]) {
+    std::unique_ptr<SkCodec> codec(SkCodec::MakeFromData(GetResourceAsData(path)));
+    if (!codec) {
+        ERRORF(r, "Could not create codec for %s", path);
+        return;
+    }
+
+    YUVPlanes full;
+    REPORTER_ASSERT(r, decode_yuv(codec.get(), SkYUVDecodeOptions(), &full));
+    REPORTER_ASSERT(r, full.fInfo.fSizes[0] == codec->dimensions());
+
+    for (int scale : { 8, 4, 2, 1 }) {
+        SkYUVDecodeOptions options;
+        options.fScaledDimensions = codec->getScaledDimensions(scale / 8.0f);
+        YUVPlanes scaled;
+        if (!decode_yuv(codec.get(), options, &scaled)) {
+            ERRORF(r, "%s: no YUV planes at %d/8", path, scale);
+            continue;
+        }
+        REPORTER_ASSERT(r, scaled.fInfo.fSizes[0] == options.fScaledDimensions);
+
+        // Compare Y to an average of the full size Y, away from the edges.
+        const int step = 8 / scale;
+        const SkISize& size = scaled.fInfo.fSizes[0];
+        int64_t totalDiff = 0, count = 0;
+        for (int y = 0; y < size.height() - 1; ++y) {
+            for (int x = 0; x < size.width() - 1; ++x) {
+                int sum = 0;
+                for (int dy = 0; dy < step; ++dy) {
+                    for (int dx = 0; dx < step; ++dx) {
+                        sum += full.row(0, y * step + dy)[x * step + dx];
+                    }
+                }
+                totalDiff += SkTAbs(sum / (step * step) - scaled.row(0, y)[x]);
+                count++;
+            }
+        }
+        if (count && totalDiff > 6 * count) {
+            ERRORF(r, "%s: Y at %d/8 is off by %g on average", path, scale,
+                   (double)totalDiff / count);
+        }
+
+        const SkIRect desired[] = {
+            SkIRect::MakeWH(size.width() / 2, size.height() / 2),
+            SkIRect::MakeLTRB(size.width() / 3, size.height() / 3, size.width(), size.height()),
+            SkIRect::MakeXYWH(size.width() / 4 + 1, size.height() / 5 + 1,
+                              size.width() / 3, size.height() / 2),
+        };
+        for (SkIRect subset : desired) {
+            if (subset.isEmpty()) {
+                continue;
+            }
+            REPORTER_ASSERT(r, codec->getValidYUV8Subset(options.fScaledDimensions, &subset));
+            options.fSubset = subset;
+            YUVPlanes part;
+            if (!decode_yuv(codec.get(), options, &part)) {
+                ERRORF(r, "%s: could not decode subset at %d/8", path, scale);
+                continue;
+            }
+            REPORTER_ASSERT(r, part.fInfo.fSizes[0] == subset.size());
+            for (int i = 0; i < 3; ++i) {
+                // The subset starts on a sample of every plane.
+                const int hRatio = SkScalarRoundToInt((float)size.width() /
+                                                      scaled.fInfo.fSizes[i].width());
+                const int vRatio = SkScalarRoundToInt((float)size.height() /
+                                                      scaled.fInfo.fSizes[i].height());
+                REPORTER_ASSERT(r, subset.left() % hRatio == 0 && subset.top() % vRatio == 0);
+                const int left = subset.left() / hRatio, top = subset.top() / vRatio;
+                const SkISize& partSize = part.fInfo.fSizes[i];
+                REPORTER_ASSERT(r, left + partSize.width() <= scaled.fInfo.fSizes[i].width() &&
+                                   top + partSize.height() <= scaled.fInfo.fSizes[i].height());
+                for (int y = 0; y < partSize.height(); ++y) {
+                    if (memcmp(part.row(i, y), scaled.row(i, top + y) + left, partSize.width())) {
+                        ERRORF(r, "%s: plane %d of subset differs at %d/8, row %d",
+                               path, i, scale, y);
+                        break;
+                    }
+                }
+            }
+            options.fSubset.setEmpty();
+        }
+    }
+
+    // A subset that does not start on a chroma sample can not be decoded.
+    if (full.fInfo.fSizes[1].width() < full.fInfo.fSizes[0].width()) {
+        SkYUVDecodeOptions options;
+        options.fSubset = SkIRect::MakeLTRB(1, 0, 8, 8);
+        SkYUVSizeInfo info;
+        REPORTER_ASSERT(r, !codec->queryYUV8(&info, nullptr, &options));
+    }
+}
+
+DEF_TEST(Jpeg_YUV_Codec_scaled_subset, r) {
+    for (const char* path : { "images/color_wheel.jpg",
+                              "images/mandrill_512_q075.jpg",   // H2V2
+                              "images/mandrill_h1v1.jpg",
+                              "images/mandrill_h2v1.jpg",
+                              "images/cropped_mandrill.jpg",    // Non-power of two dimensions
+                              "images/brickwork-texture.jpg" }) {  // Progressive
+        codec_yuv_scaled_subset(r, path);
+    }
+}